@@ -0,0 +1,170 @@
+/*
+ * ccol/bench_concurrent_hash_table.c
+ *
+ * concurrent hash table benchmark
+ *
+ * Thread scaling from 1 to 64 threads on a read-mostly mix (90% get,
+ * 5% insert, 5% remove over a shared key pool). One shard is the
+ * single-lock baseline; more shards show what striping buys. A 99% get
+ * mix then compares locked readers against lock-free READ_MOSTLY readers.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "ccol/ccol_concurrent_hash_table.h"
+#include "ccol/ccol_hash.h"
+#include "ccol/ccol_hash_table.h"
+#include "ccol/ccol_comparator.h"
+#include "ccol/ccol_status.h"
+
+#include "timer.h"
+#include "bench_utils.h"
+
+#define KEY_COUNT 1000000  // 1M
+#define TOTAL_OPS 4000000  // split across the threads of each run
+#define MAX_THREADS 64
+
+static const size_t thread_counts[] = { 1, 2, 4, 8, 16, 32, 64 };
+static const size_t shard_counts[] = { 1, 64 };
+
+typedef struct bench_worker {
+    ccol_concurrent_hash_table_t *table;
+    uint64_t *keys;
+    size_t ops;
+    unsigned get_permille;  // the rest splits evenly between insert and remove
+    uint64_t seed;
+    size_t hits;
+} bench_worker_t;
+
+static inline uint64_t bench_next(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *state = x;
+}
+
+static void *bench_worker_run(void *arg) {
+    bench_worker_t *worker = (bench_worker_t *)arg;
+    uint64_t state = worker->seed;
+
+    for (size_t i = 0; i < worker->ops; i++) {
+        uint64_t r = bench_next(&state);
+        uint64_t *key = &worker->keys[(r >> 8) % KEY_COUNT];
+        unsigned op = (unsigned)(r % 1000);
+
+        if (op < worker->get_permille) {
+            void *value = NULL;
+            worker->hits += ccol_concurrent_hash_table_get(worker->table, key, &value) == CCOL_STATUS_OK;
+        } else if (op < worker->get_permille + (1000 - worker->get_permille) / 2) {
+            ccol_concurrent_hash_table_insert(worker->table, key, key);
+        } else {
+            ccol_concurrent_hash_table_remove(worker->table, key);
+        }
+    }
+
+    return NULL;
+}
+
+static ccol_status_t bench_scaling(
+    ccol_hash_table_engine_t engine,
+    ccol_concurrent_hash_table_mode_t mode,
+    size_t num_shards,
+    unsigned get_permille,
+    uint64_t *keys
+) {
+    ccol_hash_t hasher;
+    ccol_status_t status = ccol_hash_create_from_policy(sizeof(uint64_t), CCOL_HASH_ROBUST, NULL, &hasher);
+    if (status != CCOL_STATUS_OK) return status;
+
+    ccol_comparator_t key_cmp = ccol_comparator_create(ccol_cmp_uint64, NULL);
+
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++) {
+        size_t num_threads = thread_counts[t];
+
+        ccol_concurrent_hash_table_t *table = NULL;
+        status = ccol_concurrent_hash_table_create(
+            &table,
+            num_shards,
+            16,
+            sizeof(uint64_t),
+            engine,
+            mode,
+            CCOL_HASH_ROBUST,
+            hasher,
+            (ccol_copy_t){0},
+            (ccol_free_t){0},
+            (ccol_print_t){0},
+            ccol_comparator_create(ccol_cmp_hash_entry_key, &key_cmp)
+        );
+        if (status != CCOL_STATUS_OK) {
+            fprintf(stderr, "ccol_concurrent_hash_table_create failed: %s\n", ccol_strstatus(status));
+            return status;
+        }
+
+        // Half the pool is present, so gets hit about half the time
+        for (size_t i = 0; i < KEY_COUNT; i += 2) ccol_concurrent_hash_table_insert(table, &keys[i], &keys[i]);
+
+        pthread_t threads[MAX_THREADS];
+        bench_worker_t workers[MAX_THREADS];
+        for (size_t i = 0; i < num_threads; i++) {
+            workers[i] = (bench_worker_t){
+                .table = table,
+                .keys = keys,
+                .ops = TOTAL_OPS / num_threads,
+                .get_permille = get_permille,
+                .seed = 0x9E3779B97F4A7C15ULL * (i + 1),
+                .hits = 0,
+            };
+        }
+
+        bench_timer_t timer;
+        start_timer(&timer);
+
+        size_t started = 0;
+        for (; started < num_threads; started++) {
+            if (pthread_create(&threads[started], NULL, bench_worker_run, &workers[started]) != 0) break;
+        }
+        for (size_t i = 0; i < started; i++) pthread_join(threads[i], NULL);
+
+        double elapsed = stop_timer(&timer, TIME_SCALE_MILLISECONDS);
+
+        char label[128];
+        snprintf(label, sizeof(label), "get %u%% %s %s shards=%zu threads=%zu",
+            get_permille / 10, ccol_hash_table_engine_to_string(engine),
+            mode == CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY ? "read-mostly" : "locked", num_shards, started);
+        PRINT_BENCH(label, (TOTAL_OPS / num_threads) * started, elapsed, TIME_SCALE_MILLISECONDS);
+
+        ccol_concurrent_hash_table_free(&table);
+    }
+
+    return CCOL_STATUS_OK;
+}
+
+int main(void) {
+    uint64_t *keys = malloc(KEY_COUNT * sizeof(uint64_t));
+    if (!keys) {
+        fprintf(stderr, "benchmark allocation failed\n");
+        return 1;
+    }
+
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    for (size_t i = 0; i < KEY_COUNT; i++) keys[i] = bench_next(&state);
+
+    for (size_t s = 0; s < sizeof(shard_counts) / sizeof(shard_counts[0]); s++) {
+        bench_scaling(CCOL_HASH_TABLE_CHAINED, CCOL_CONCURRENT_HASH_TABLE_LOCKED, shard_counts[s], 900, keys);
+        bench_scaling(CCOL_HASH_TABLE_SWISS, CCOL_CONCURRENT_HASH_TABLE_LOCKED, shard_counts[s], 900, keys);
+    }
+
+    bench_scaling(CCOL_HASH_TABLE_CHAINED, CCOL_CONCURRENT_HASH_TABLE_LOCKED, 64, 990, keys);
+    bench_scaling(CCOL_HASH_TABLE_CHAINED, CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY, 64, 990, keys);
+
+    free(keys);
+    return 0;
+}
@@ -34,7 +34,7 @@ static ccol_status_t bench_ccol_dll_push_back(size_t n) {
     }
 
     int data = rand();
-    timer_t timer;
+    bench_timer_t timer;
 
     start_timer(&timer);
     for (size_t i = 0; i < n; i++) ccol_dll_push_back(&list, &data);
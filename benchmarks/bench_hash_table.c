@@ -3,6 +3,417 @@
  *
  * hash table benchmark
  *
+ * Compares the SIMPLE, ROBUST and SECURE hash policies: raw hashing
+ * throughput for integer and string keys, then insert + lookup through a
+ * hash table using each policy. Ends with startup cost: rebuilding a table
+ * versus opening a frozen copy of it, and minimal perfect hash lookups.
+ *
  * Created by Jack Einbinder
  * Copyright (C) 2025 Jack Einbinder
  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "ccol/ccol_hash.h"
+#include "ccol/ccol_hash_table.h"
+#include "ccol/ccol_frozen_table.h"
+#include "ccol/ccol_mph.h"
+#include "ccol/ccol_intern.h"
+#include "ccol/ccol_comparator.h"
+#include "ccol/ccol_constants.h"
+#include "ccol/ccol_status.h"
+
+#include "timer.h"
+#include "bench_utils.h"
+
+#define ELEMENT_COUNT 1000000 // 1M
+#define STR_KEY_LEN 32
+#define FROZEN_PATH "bench_hash_table.frozen"
+
+static const ccol_hash_policy_t policies[] = { CCOL_HASH_SIMPLE, CCOL_HASH_ROBUST, CCOL_HASH_SECURE };
+
+static volatile uint32_t hash_sink;
+
+static ccol_status_t bench_hash_uint64(ccol_hash_policy_t policy, const uint64_t *keys, size_t n) {
+    ccol_hash_key_t key;
+    ccol_status_t status = ccol_hash_key_random(&key);
+    if (status != CCOL_STATUS_OK) return status;
+
+    ccol_hash_t hasher;
+    status = ccol_hash_create_from_policy(sizeof(uint64_t), policy, &key, &hasher);
+    if (status != CCOL_STATUS_OK) return status;
+
+    uint32_t acc = 0;
+    bench_timer_t timer;
+
+    start_timer(&timer);
+    for (size_t i = 0; i < n; i++) acc ^= hasher.func(&keys[i], hasher.ctx);
+
+    double elapsed = stop_timer(&timer, TIME_SCALE_MILLISECONDS);
+    hash_sink = acc;
+
+    char label[64];
+    snprintf(label, sizeof(label), "hash uint64 %s", ccol_hash_policy_to_string(policy));
+    PRINT_BENCH(label, n, elapsed, TIME_SCALE_MILLISECONDS);
+
+    return CCOL_STATUS_OK;
+}
+
+static ccol_status_t bench_hash_str(ccol_hash_policy_t policy, char **keys, size_t n) {
+    ccol_hash_key_t key;
+    ccol_status_t status = ccol_hash_key_random(&key);
+    if (status != CCOL_STATUS_OK) return status;
+
+    ccol_hash_t hasher;
+    status = ccol_hash_create_from_policy(CCOL_HASH_KEY_STRING, policy, &key, &hasher);
+    if (status != CCOL_STATUS_OK) return status;
+
+    uint32_t acc = 0;
+    bench_timer_t timer;
+
+    start_timer(&timer);
+    for (size_t i = 0; i < n; i++) acc ^= hasher.func(keys[i], hasher.ctx);
+
+    double elapsed = stop_timer(&timer, TIME_SCALE_MILLISECONDS);
+    hash_sink = acc;
+
+    char label[64];
+    snprintf(label, sizeof(label), "hash str[%d] %s", STR_KEY_LEN, ccol_hash_policy_to_string(policy));
+    PRINT_BENCH(label, n, elapsed, TIME_SCALE_MILLISECONDS);
+
+    return CCOL_STATUS_OK;
+}
+
+static ccol_status_t bench_hash_table_insert_get(
+    ccol_hash_table_engine_t engine,
+    ccol_hash_policy_t policy,
+    uint64_t *keys,
+    size_t n
+) {
+    ccol_hash_t hasher;
+    ccol_status_t status = ccol_hash_create_from_policy(sizeof(uint64_t), policy, NULL, &hasher);
+    if (status != CCOL_STATUS_OK) return status;
+
+    ccol_comparator_t key_cmp = ccol_comparator_create(ccol_cmp_uint64, NULL);
+    ccol_hash_table_t *hash_table = NULL;
+    status = ccol_hash_table_create_with_engine(
+        &hash_table,
+        16,
+        sizeof(uint64_t),
+        engine,
+        policy,
+        hasher,
+        (ccol_copy_t){0},
+        (ccol_free_t){0},
+        (ccol_print_t){0},
+        ccol_comparator_create(ccol_cmp_hash_entry_key, &key_cmp)
+    );
+    if (status != CCOL_STATUS_OK) {
+        fprintf(stderr, "ccol_hash_table_create_with_engine failed: %s\n", ccol_strstatus(status));
+        return status;
+    }
+
+    char label[96];
+    bench_timer_t timer;
+
+    start_timer(&timer);
+    for (size_t i = 0; i < n; i++) ccol_hash_table_insert(hash_table, &keys[i], &keys[i]);
+
+    double elapsed = stop_timer(&timer, TIME_SCALE_MILLISECONDS);
+    snprintf(label, sizeof(label), "insert %s %s",
+        ccol_hash_table_engine_to_string(engine), ccol_hash_policy_to_string(policy));
+    PRINT_BENCH(label, n, elapsed, TIME_SCALE_MILLISECONDS);
+
+    size_t found = 0;
+    start_timer(&timer);
+    for (size_t i = 0; i < n; i++) found += ccol_hash_table_contains_key(hash_table, &keys[i]);
+
+    elapsed = stop_timer(&timer, TIME_SCALE_MILLISECONDS);
+    snprintf(label, sizeof(label), "contains_key %s %s",
+        ccol_hash_table_engine_to_string(engine), ccol_hash_policy_to_string(policy));
+    PRINT_BENCH(label, n, elapsed, TIME_SCALE_MILLISECONDS);
+    if (found != n) fprintf(stderr, "contains_key found %zu of %zu keys\n", found, n);
+
+    void **lookup = malloc(n * sizeof(void *));
+    void **values = malloc(n * sizeof(void *));
+    if (lookup && values) {
+        for (size_t i = 0; i < n; i++) lookup[i] = &keys[i];
+
+        start_timer(&timer);
+        ccol_hash_table_get_many(hash_table, lookup, n, values, NULL);
+
+        elapsed = stop_timer(&timer, TIME_SCALE_MILLISECONDS);
+        snprintf(label, sizeof(label), "get_many %s %s",
+            ccol_hash_table_engine_to_string(engine), ccol_hash_policy_to_string(policy));
+        PRINT_BENCH(label, n, elapsed, TIME_SCALE_MILLISECONDS);
+    }
+    free(values);
+    free(lookup);
+
+    ccol_hash_table_free(&hash_table);
+
+    return CCOL_STATUS_OK;
+}
+
+static ccol_status_t bench_hash_table_build(ccol_hash_table_engine_t engine, uint64_t *keys, size_t n) {
+    ccol_hash_t hasher;
+    ccol_status_t status = ccol_hash_create_from_policy(sizeof(uint64_t), CCOL_HASH_ROBUST, NULL, &hasher);
+    if (status != CCOL_STATUS_OK) return status;
+
+    void **key_ptrs = malloc(n * sizeof(void *));
+    if (!key_ptrs) return CCOL_STATUS_ALLOC;
+    for (size_t i = 0; i < n; i++) key_ptrs[i] = &keys[i];
+
+    ccol_comparator_t key_cmp = ccol_comparator_create(ccol_cmp_uint64, NULL);
+    ccol_hash_table_t *hash_table = NULL;
+    bench_timer_t timer;
+
+    start_timer(&timer);
+    status = ccol_hash_table_build(
+        &hash_table,
+        sizeof(uint64_t),
+        engine,
+        CCOL_HASH_ROBUST,
+        hasher,
+        (ccol_copy_t){0},
+        (ccol_free_t){0},
+        (ccol_print_t){0},
+        ccol_comparator_create(ccol_cmp_hash_entry_key, &key_cmp),
+        key_ptrs,
+        key_ptrs,
+        n,
+        true
+    );
+
+    double elapsed = stop_timer(&timer, TIME_SCALE_MILLISECONDS);
+    if (status == CCOL_STATUS_OK) {
+        char label[96];
+        snprintf(label, sizeof(label), "build (unique) %s CCOL_HASH_ROBUST", ccol_hash_table_engine_to_string(engine));
+        PRINT_BENCH(label, n, elapsed, TIME_SCALE_MILLISECONDS);
+        ccol_hash_table_free(&hash_table);
+    }
+
+    free(key_ptrs);
+    return status;
+}
+
+// Chained resize and shallow clone, serial against several threads
+static ccol_status_t bench_hash_table_parallel(size_t num_threads, uint64_t *keys, size_t n) {
+    ccol_hash_t hasher;
+    ccol_status_t status = ccol_hash_create_from_policy(sizeof(uint64_t), CCOL_HASH_ROBUST, NULL, &hasher);
+    if (status != CCOL_STATUS_OK) return status;
+
+    void **key_ptrs = malloc(n * sizeof(void *));
+    if (!key_ptrs) return CCOL_STATUS_ALLOC;
+    for (size_t i = 0; i < n; i++) key_ptrs[i] = &keys[i];
+
+    ccol_comparator_t key_cmp = ccol_comparator_create(ccol_cmp_uint64, NULL);
+    ccol_hash_table_t *hash_table = NULL;
+    status = ccol_hash_table_build(
+        &hash_table,
+        sizeof(uint64_t),
+        CCOL_HASH_TABLE_CHAINED,
+        CCOL_HASH_ROBUST,
+        hasher,
+        (ccol_copy_t){0},
+        (ccol_free_t){0},
+        (ccol_print_t){0},
+        ccol_comparator_create(ccol_cmp_hash_entry_key, &key_cmp),
+        key_ptrs,
+        key_ptrs,
+        n,
+        true
+    );
+    free(key_ptrs);
+    if (status != CCOL_STATUS_OK) return status;
+
+    ccol_hash_table_set_threads(hash_table, num_threads);
+
+    char label[96];
+    bench_timer_t timer;
+
+    start_timer(&timer);
+    status = ccol_hash_table_resize(hash_table, (int)(ccol_hash_table_num_buckets(hash_table) * 2));
+    double elapsed = stop_timer(&timer, TIME_SCALE_MILLISECONDS);
+    snprintf(label, sizeof(label), "resize CCOL_HASH_TABLE_CHAINED (%zu threads)", num_threads);
+    if (status == CCOL_STATUS_OK) PRINT_BENCH(label, n, elapsed, TIME_SCALE_MILLISECONDS);
+
+    ccol_hash_table_t *clone = NULL;
+    start_timer(&timer);
+    status = ccol_hash_table_shallow_clone(hash_table, &clone);
+    elapsed = stop_timer(&timer, TIME_SCALE_MILLISECONDS);
+    snprintf(label, sizeof(label), "shallow clone CCOL_HASH_TABLE_CHAINED (%zu threads)", num_threads);
+    if (status == CCOL_STATUS_OK) {
+        PRINT_BENCH(label, n, elapsed, TIME_SCALE_MILLISECONDS);
+        ccol_hash_table_free(&clone);
+    }
+
+    ccol_hash_table_free(&hash_table);
+    return status;
+}
+
+static ccol_status_t bench_frozen_table(uint64_t *keys, size_t n) {
+    ccol_hash_t hasher;
+    ccol_status_t status = ccol_hash_create_from_policy(sizeof(uint64_t), CCOL_HASH_ROBUST, NULL, &hasher);
+    if (status != CCOL_STATUS_OK) return status;
+
+    ccol_comparator_t key_cmp = ccol_comparator_create(ccol_cmp_uint64, NULL);
+    ccol_hash_table_t *hash_table = NULL;
+    status = ccol_hash_table_create_with_engine(
+        &hash_table,
+        n,
+        sizeof(uint64_t),
+        CCOL_HASH_TABLE_ROBIN_HOOD,
+        CCOL_HASH_ROBUST,
+        hasher,
+        (ccol_copy_t){0},
+        (ccol_free_t){0},
+        (ccol_print_t){0},
+        ccol_comparator_create(ccol_cmp_hash_entry_key, &key_cmp)
+    );
+    if (status != CCOL_STATUS_OK) return status;
+
+    for (size_t i = 0; i < n; i++) ccol_hash_table_insert(hash_table, &keys[i], &keys[i]);
+
+    bench_timer_t timer;
+    start_timer(&timer);
+    status = ccol_hash_table_freeze(hash_table, sizeof(uint64_t), FROZEN_PATH);
+    double elapsed = stop_timer(&timer, TIME_SCALE_MILLISECONDS);
+    ccol_hash_table_free(&hash_table);
+    if (status != CCOL_STATUS_OK) return status;
+    PRINT_BENCH("freeze CCOL_HASH_TABLE_ROBIN_HOOD", n, elapsed, TIME_SCALE_MILLISECONDS);
+
+    ccol_frozen_table_t frozen;
+    start_timer(&timer);
+    status = ccol_frozen_table_open(&frozen, FROZEN_PATH);
+    elapsed = stop_timer(&timer, TIME_SCALE_MILLISECONDS);
+    if (status != CCOL_STATUS_OK) {
+        remove(FROZEN_PATH);
+        return status;
+    }
+    PRINT_BENCH("frozen open", n, elapsed, TIME_SCALE_MILLISECONDS);
+
+    uint64_t sum = 0;
+    start_timer(&timer);
+    for (size_t i = 0; i < n; i++) {
+        const void *value = NULL;
+        if (ccol_frozen_table_get(&frozen, &keys[i], &value) == CCOL_STATUS_OK) sum += *(const uint64_t *)value;
+    }
+    elapsed = stop_timer(&timer, TIME_SCALE_MILLISECONDS);
+    hash_sink = (uint32_t)sum;
+    PRINT_BENCH("frozen get", n, elapsed, TIME_SCALE_MILLISECONDS);
+
+    ccol_frozen_table_close(&frozen);
+    remove(FROZEN_PATH);
+    return CCOL_STATUS_OK;
+}
+
+static ccol_status_t bench_mph(uint64_t *keys, size_t n) {
+    void **key_ptrs = malloc(n * sizeof(void *));
+    if (!key_ptrs) return CCOL_STATUS_ALLOC;
+    for (size_t i = 0; i < n; i++) key_ptrs[i] = &keys[i];
+
+    ccol_mph_t *mph = NULL;
+    bench_timer_t timer;
+
+    start_timer(&timer);
+    ccol_status_t status = ccol_mph_create(
+        &mph,
+        sizeof(uint64_t),
+        CCOL_HASH_ROBUST,
+        ccol_comparator_create(ccol_cmp_uint64, NULL),
+        key_ptrs,
+        n
+    );
+    double elapsed = stop_timer(&timer, TIME_SCALE_MILLISECONDS);
+    free(key_ptrs);
+    if (status != CCOL_STATUS_OK) return status;
+
+    PRINT_BENCH("mph build CCOL_HASH_ROBUST", n, elapsed, TIME_SCALE_MILLISECONDS);
+    printf("    Bits per key:        %.2f\n", ccol_mph_bits_per_key(mph));
+
+    size_t sum = 0;
+    start_timer(&timer);
+    for (size_t i = 0; i < n; i++) {
+        size_t index = 0;
+        if (ccol_mph_index(mph, &keys[i], &index) == CCOL_STATUS_OK) sum += index;
+    }
+    elapsed = stop_timer(&timer, TIME_SCALE_MILLISECONDS);
+    hash_sink = (uint32_t)sum;
+    PRINT_BENCH("mph index", n, elapsed, TIME_SCALE_MILLISECONDS);
+
+    ccol_mph_free(&mph);
+    return CCOL_STATUS_OK;
+}
+
+static ccol_status_t bench_intern(char **keys, size_t n) {
+    ccol_intern_t *intern = NULL;
+    ccol_status_t status = ccol_intern_create(&intern, CCOL_HASH_ROBUST);
+    if (status != CCOL_STATUS_OK) return status;
+
+    bench_timer_t timer;
+    ccol_intern_id_t id;
+
+    start_timer(&timer);
+    for (size_t i = 0; i < n; i++) ccol_intern(intern, keys[i], &id);
+    double elapsed = stop_timer(&timer, TIME_SCALE_MILLISECONDS);
+    PRINT_BENCH("intern str (new)", n, elapsed, TIME_SCALE_MILLISECONDS);
+
+    uint32_t acc = 0;
+    start_timer(&timer);
+    for (size_t i = 0; i < n; i++) {
+        if (ccol_intern(intern, keys[i], &id) == CCOL_STATUS_OK) acc ^= id;
+    }
+    elapsed = stop_timer(&timer, TIME_SCALE_MILLISECONDS);
+    hash_sink = acc;
+    PRINT_BENCH("intern str (existing)", n, elapsed, TIME_SCALE_MILLISECONDS);
+
+    ccol_intern_free(&intern);
+    return CCOL_STATUS_OK;
+}
+
+int main(void) {
+    srand((unsigned int)time(NULL));
+
+    uint64_t *int_keys = malloc(ELEMENT_COUNT * sizeof(uint64_t));
+    char **str_keys = malloc(ELEMENT_COUNT * sizeof(char *));
+    char *str_data = malloc((size_t)ELEMENT_COUNT * (STR_KEY_LEN + 1));
+    if (!int_keys || !str_keys || !str_data) {
+        fprintf(stderr, "benchmark allocation failed\n");
+        return 1;
+    }
+
+    for (size_t i = 0; i < ELEMENT_COUNT; i++) {
+        int_keys[i] = ((uint64_t)rand() << 32) ^ (uint64_t)rand() ^ i;
+
+        str_keys[i] = str_data + i * (STR_KEY_LEN + 1);
+        for (size_t j = 0; j < STR_KEY_LEN; j++) str_keys[i][j] = (char)('a' + rand() % 26);
+        str_keys[i][STR_KEY_LEN] = '\0';
+    }
+
+    size_t num_policies = sizeof(policies) / sizeof(policies[0]);
+    for (size_t i = 0; i < num_policies; i++) bench_hash_uint64(policies[i], int_keys, ELEMENT_COUNT);
+    for (size_t i = 0; i < num_policies; i++) bench_hash_str(policies[i], str_keys, ELEMENT_COUNT);
+    for (size_t i = 0; i < num_policies; i++) {
+        bench_hash_table_insert_get(CCOL_HASH_TABLE_CHAINED, policies[i], int_keys, ELEMENT_COUNT);
+        bench_hash_table_insert_get(CCOL_HASH_TABLE_SWISS, policies[i], int_keys, ELEMENT_COUNT);
+        bench_hash_table_insert_get(CCOL_HASH_TABLE_ROBIN_HOOD, policies[i], int_keys, ELEMENT_COUNT);
+    }
+    bench_hash_table_build(CCOL_HASH_TABLE_CHAINED, int_keys, ELEMENT_COUNT);
+    bench_hash_table_build(CCOL_HASH_TABLE_SWISS, int_keys, ELEMENT_COUNT);
+    bench_hash_table_build(CCOL_HASH_TABLE_ROBIN_HOOD, int_keys, ELEMENT_COUNT);
+    bench_hash_table_parallel(1, int_keys, ELEMENT_COUNT);
+    bench_hash_table_parallel(4, int_keys, ELEMENT_COUNT);
+    bench_frozen_table(int_keys, ELEMENT_COUNT);
+    bench_mph(int_keys, ELEMENT_COUNT);
+    bench_intern(str_keys, ELEMENT_COUNT);
+
+    free(str_data);
+    free(str_keys);
+    free(int_keys);
+    return 0;
+}
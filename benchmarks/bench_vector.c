@@ -3,6 +3,178 @@
  *
  * vector benchmark
  *
+ * Sorting: ccol_vector_sort and ccol_vector_stable_sort with an integer
+ * comparator (radix path) and an opaque one (comparison path), against
+ * qsort. Searching: branchless ccol_vector_lower_bound versus the same
+ * probes through an Eytzinger index.
+ *
  * Created by Jack Einbinder
  * Copyright (C) 2025 Jack Einbinder
  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "ccol/ccol_vector.h"
+#include "ccol/ccol_comparator.h"
+#include "ccol/ccol_status.h"
+
+#include "timer.h"
+#include "bench_utils.h"
+
+#define ELEMENT_COUNT 1000000 // 1M
+#define SEARCH_ELEMENT_COUNT 10000000 // 10M: well past the last-level cache, where the layouts differ
+#define PROBE_COUNT 5000000 // 5M
+
+typedef ccol_status_t (*bench_sort_func_t)(ccol_vector_t *vec);
+
+static volatile size_t index_sink;
+
+// Same order as ccol_cmp_uint64, but not recognised as an integer comparator
+static int cmp_uint64_opaque(const void *a, const void *b, void *ctx) {
+    (void)ctx;
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static int cmp_uint64_qsort(const void *a, const void *b) {
+    return cmp_uint64_opaque(a, b, NULL);
+}
+
+static ccol_status_t create_filled(ccol_vector_t **vec_out, ccol_comparator_func_t cmp, const uint64_t *keys, size_t n) {
+    ccol_status_t status = ccol_vector_create(
+        vec_out,
+        n,
+        sizeof(uint64_t),
+        (ccol_copy_t){0},
+        (ccol_free_t){0},
+        (ccol_print_t){0},
+        ccol_comparator_create(cmp, NULL)
+    );
+    if (status != CCOL_STATUS_OK) {
+        fprintf(stderr, "ccol_vector_create failed: %s\n", ccol_strstatus(status));
+        return status;
+    }
+
+    for (size_t i = 0; i < n && status == CCOL_STATUS_OK; i++) status = ccol_vector_append(*vec_out, (void *)&keys[i]);
+    if (status != CCOL_STATUS_OK) ccol_vector_free(vec_out);
+    return status;
+}
+
+static ccol_status_t bench_vector_sort(
+    const char *label,
+    bench_sort_func_t sort,
+    ccol_comparator_func_t cmp,
+    const uint64_t *keys,
+    size_t n
+) {
+    ccol_vector_t *vec = NULL;
+    ccol_status_t status = create_filled(&vec, cmp, keys, n);
+    if (status != CCOL_STATUS_OK) return status;
+
+    bench_timer_t timer;
+
+    start_timer(&timer);
+    status = sort(vec);
+
+    double elapsed = stop_timer(&timer, TIME_SCALE_MILLISECONDS);
+    if (status == CCOL_STATUS_OK) PRINT_BENCH(label, n, elapsed, TIME_SCALE_MILLISECONDS);
+    else fprintf(stderr, "%s failed: %s\n", label, ccol_strstatus(status));
+
+    ccol_vector_free(&vec);
+    return status;
+}
+
+static ccol_status_t bench_qsort(const uint64_t *keys, size_t n) {
+    uint64_t *copy = malloc(n * sizeof(uint64_t));
+    if (!copy) return CCOL_STATUS_ALLOC;
+    memcpy(copy, keys, n * sizeof(uint64_t));
+
+    bench_timer_t timer;
+
+    start_timer(&timer);
+    qsort(copy, n, sizeof(uint64_t), cmp_uint64_qsort);
+
+    double elapsed = stop_timer(&timer, TIME_SCALE_MILLISECONDS);
+    PRINT_BENCH("qsort (baseline)", n, elapsed, TIME_SCALE_MILLISECONDS);
+
+    free(copy);
+    return CCOL_STATUS_OK;
+}
+
+static ccol_status_t bench_vector_search(const uint64_t *keys, size_t n, const uint64_t *probes, size_t num_probes) {
+    ccol_vector_t *vec = NULL;
+    ccol_status_t status = create_filled(&vec, ccol_cmp_uint64, keys, n);
+    if (status == CCOL_STATUS_OK) status = ccol_vector_sort(vec);
+    if (status != CCOL_STATUS_OK) {
+        if (vec) ccol_vector_free(&vec);
+        return status;
+    }
+
+    size_t acc = 0;
+    size_t index = 0;
+    bench_timer_t timer;
+
+    start_timer(&timer);
+    for (size_t i = 0; i < num_probes; i++) {
+        ccol_vector_lower_bound(vec, &probes[i], &index);
+        acc += index;
+    }
+
+    double elapsed = stop_timer(&timer, TIME_SCALE_MILLISECONDS);
+    PRINT_BENCH("ccol_vector_lower_bound", num_probes, elapsed, TIME_SCALE_MILLISECONDS);
+
+    ccol_vector_eytzinger_t eytzinger;
+    status = ccol_vector_eytzinger_init(&eytzinger, vec);
+    if (status != CCOL_STATUS_OK) {
+        fprintf(stderr, "ccol_vector_eytzinger_init failed: %s\n", ccol_strstatus(status));
+        ccol_vector_free(&vec);
+        return status;
+    }
+
+    start_timer(&timer);
+    for (size_t i = 0; i < num_probes; i++) {
+        ccol_vector_eytzinger_lower_bound(&eytzinger, &probes[i], &index);
+        acc -= index;
+    }
+
+    elapsed = stop_timer(&timer, TIME_SCALE_MILLISECONDS);
+    PRINT_BENCH("ccol_vector_eytzinger_lower_bound", num_probes, elapsed, TIME_SCALE_MILLISECONDS);
+
+    // Both searches give the same ranks, so acc is back to 0
+    index_sink = acc;
+    if (acc != 0) fprintf(stderr, "lower_bound and eytzinger_lower_bound disagree\n");
+
+    ccol_vector_eytzinger_destroy(&eytzinger);
+    ccol_vector_free(&vec);
+    return CCOL_STATUS_OK;
+}
+
+int main(void) {
+    srand((unsigned int)time(NULL));
+
+    uint64_t *keys = malloc(SEARCH_ELEMENT_COUNT * sizeof(uint64_t));
+    uint64_t *probes = malloc(PROBE_COUNT * sizeof(uint64_t));
+    if (!keys || !probes) {
+        fprintf(stderr, "benchmark allocation failed\n");
+        return 1;
+    }
+
+    for (size_t i = 0; i < SEARCH_ELEMENT_COUNT; i++) keys[i] = ((uint64_t)rand() << 32) ^ (uint64_t)rand() ^ i;
+    for (size_t i = 0; i < PROBE_COUNT; i++) probes[i] = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+
+    bench_qsort(keys, ELEMENT_COUNT);
+    bench_vector_sort("ccol_vector_sort (uint64)", ccol_vector_sort, ccol_cmp_uint64, keys, ELEMENT_COUNT);
+    bench_vector_sort("ccol_vector_sort (opaque)", ccol_vector_sort, cmp_uint64_opaque, keys, ELEMENT_COUNT);
+    bench_vector_sort("ccol_vector_stable_sort (uint64)", ccol_vector_stable_sort, ccol_cmp_uint64, keys, ELEMENT_COUNT);
+    bench_vector_sort("ccol_vector_stable_sort (opaque)", ccol_vector_stable_sort, cmp_uint64_opaque, keys, ELEMENT_COUNT);
+    bench_vector_search(keys, SEARCH_ELEMENT_COUNT, probes, PROBE_COUNT);
+
+    free(probes);
+    free(keys);
+    return 0;
+}
@@ -23,7 +23,7 @@ typedef enum time_scale {
 
 typedef struct timer {
     struct timespec start;
-} timer_t;
+} bench_timer_t;
 
 static inline const char *time_scale_unit_to_string(time_scale_t time_scale) {
     switch(time_scale) {
@@ -56,11 +56,11 @@ static inline double time_scale_convert(double value, time_scale_t from, time_sc
     return value * (from_multiplier / to_multiplier);
 }
 
-static inline void start_timer(timer_t *timer) {
+static inline void start_timer(bench_timer_t *timer) {
     clock_gettime(CLOCK_MONOTONIC, &timer->start);
 }
 
-static inline double stop_timer(const timer_t *timer, time_scale_t time_scale) {
+static inline double stop_timer(const bench_timer_t *timer, time_scale_t time_scale) {
     struct timespec timer_end_time;
     clock_gettime(CLOCK_MONOTONIC, &timer_end_time);
 
@@ -28,6 +28,9 @@
 /* Hash */
 #include <ccol/ccol_hash.h>
 
+/* Concurrency */
+#include <ccol/ccol_epoch.h>
+
 /* Containers */
 #include <ccol/ccol_cdll.h>
 #include <ccol/ccol_cdll_iterator.h>
@@ -50,4 +53,10 @@
 #include <ccol/ccol_hash_table.h>
 #include <ccol/ccol_hash_table_iterator.h>
 
+#include <ccol/ccol_concurrent_hash_table.h>
+#include <ccol/ccol_frozen_table.h>
+#include <ccol/ccol_mph.h>
+#include <ccol/ccol_intern.h>
+#include <ccol/ccol_lru.h>
+
 #endif  // CCOL_H
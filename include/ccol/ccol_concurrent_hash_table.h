@@ -0,0 +1,122 @@
+/*
+ * ccol/ccol_concurrent_hash_table.h
+ *
+ * Thread-safe hash table API.
+ *
+ * The key space is split into independently locked shards. In the default
+ * LOCKED mode each shard is an ordinary ccol_hash_table_t guarded by a
+ * reader/writer lock: lookups on different shards never contend, lookups on
+ * the same shard share its lock, and every shard resizes on its own under
+ * its write lock. READ_MOSTLY mode drops the lock from the read path
+ * entirely; see ccol_concurrent_hash_table_mode_t.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#ifndef CCOL_CONCURRENT_HASH_TABLE_H
+#define CCOL_CONCURRENT_HASH_TABLE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "ccol_hash.h"
+#include "ccol_hash_table.h"
+#include "ccol_copy.h"
+#include "ccol_free.h"
+#include "ccol_print.h"
+#include "ccol_comparator.h"
+#include "ccol_epoch.h"
+#include "ccol_status.h"
+
+#define CCOL_CONCURRENT_HASH_TABLE_MAX_SHARDS 4096
+
+typedef enum ccol_concurrent_hash_table_mode {
+    // Readers share a per-shard reader/writer lock; any engine
+    CCOL_CONCURRENT_HASH_TABLE_LOCKED = 0,
+    // get/contains_key take no lock: shards are chained tables whose links writers
+    // publish with atomic stores, and unlinked nodes are freed through an epoch
+    // domain once no reader can hold them. Writers still serialize per shard.
+    // Requires CCOL_HASH_TABLE_CHAINED.
+    CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY = 1,
+} ccol_concurrent_hash_table_mode_t;
+
+typedef struct ccol_concurrent_hash_table {
+    struct ccol__concurrent_shard *shards;
+    size_t num_shards;     // power of two
+    unsigned shard_shift;  // 32 - log2(num_shards); picks the shard from the high bits
+
+    size_t key_size;
+    ccol_hash_table_engine_t engine;
+    ccol_concurrent_hash_table_mode_t mode;
+
+    // CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY state; LOCKED shards keep their own copies
+    ccol_epoch_t *epoch;
+    size_t min_buckets;  // per shard, power of two
+    ccol_free_t freer;
+    ccol_comparator_t comparator;
+
+    ccol_hash_t hasher;        // shared by every shard
+    ccol_hash_key_t hash_key;  // random key for CCOL_HASH_SECURE when the hasher has no ctx
+
+    bool is_initialized;
+} ccol_concurrent_hash_table_t;
+
+// Create / Initialize
+// num_shards is rounded up to a power of two; buckets_per_shard is each shard's initial size
+ccol_status_t ccol_concurrent_hash_table_init(
+    ccol_concurrent_hash_table_t *table,
+    size_t num_shards,
+    size_t buckets_per_shard,
+    size_t key_size,
+    ccol_hash_table_engine_t engine,
+    ccol_concurrent_hash_table_mode_t mode,
+    ccol_hash_policy_t policy,
+    ccol_hash_t hasher,
+    ccol_copy_t copier,
+    ccol_free_t freer,
+    ccol_print_t printer,
+    ccol_comparator_t comparator
+);
+
+ccol_status_t ccol_concurrent_hash_table_create(
+    ccol_concurrent_hash_table_t **table_out,
+    size_t num_shards,
+    size_t buckets_per_shard,
+    size_t key_size,
+    ccol_hash_table_engine_t engine,
+    ccol_concurrent_hash_table_mode_t mode,
+    ccol_hash_policy_t policy,
+    ccol_hash_t hasher,
+    ccol_copy_t copier,
+    ccol_free_t freer,
+    ccol_print_t printer,
+    ccol_comparator_t comparator
+);
+
+// Insertion / Removal
+ccol_status_t ccol_concurrent_hash_table_insert(ccol_concurrent_hash_table_t *table, void *key, void *data);
+ccol_status_t ccol_concurrent_hash_table_remove(ccol_concurrent_hash_table_t *table, const void *key);
+
+// Access
+// The value pointer is read under the shard's lock (LOCKED) or inside an epoch section
+// (READ_MOSTLY); keeping it valid afterwards is up to the caller. In READ_MOSTLY mode,
+// entering ccol_concurrent_hash_table_epoch around the get and the use does exactly that.
+ccol_status_t ccol_concurrent_hash_table_get(ccol_concurrent_hash_table_t *table, const void *key, void **data_out);
+bool ccol_concurrent_hash_table_contains_key(ccol_concurrent_hash_table_t *table, const void *key);
+
+// Attributes
+// Sums the shards one at a time, so the result is a snapshot under concurrent writes
+size_t ccol_concurrent_hash_table_size(ccol_concurrent_hash_table_t *table);
+bool ccol_concurrent_hash_table_is_empty(ccol_concurrent_hash_table_t *table);
+size_t ccol_concurrent_hash_table_num_shards(const ccol_concurrent_hash_table_t *table);
+
+// The table's reclamation domain in READ_MOSTLY mode, NULL otherwise
+ccol_epoch_t *ccol_concurrent_hash_table_epoch(const ccol_concurrent_hash_table_t *table);
+
+// Cleanup
+ccol_status_t ccol_concurrent_hash_table_clear(ccol_concurrent_hash_table_t *table);
+ccol_status_t ccol_concurrent_hash_table_destroy(ccol_concurrent_hash_table_t *table);
+ccol_status_t ccol_concurrent_hash_table_free(ccol_concurrent_hash_table_t **table_ptr);
+
+#endif  // CCOL_CONCURRENT_HASH_TABLE_H
@@ -0,0 +1,59 @@
+/*
+ * ccol/ccol_epoch.h
+ *
+ * Epoch-based memory reclamation.
+ *
+ * Readers bracket their accesses with ccol_epoch_enter/exit; writers unlink
+ * an object and hand it to ccol_epoch_retire instead of freeing it. Retired
+ * objects are released once every reader that could still see them has
+ * left its critical section. Entering and leaving only touch the calling
+ * thread's own record, so readers never write shared cache lines.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#ifndef CCOL_EPOCH_H
+#define CCOL_EPOCH_H
+
+#include <stddef.h>
+
+#include "ccol_status.h"
+
+// Retired objects are collected automatically once this many are pending
+#define CCOL_EPOCH_RECLAIM_THRESHOLD 64
+
+typedef struct ccol_epoch ccol_epoch_t;
+typedef struct ccol_epoch_record ccol_epoch_record_t;
+
+typedef void (*ccol_epoch_free_func_t)(void *ptr, void *ctx);
+
+// Create / Free
+ccol_status_t ccol_epoch_create(ccol_epoch_t **epoch_out);
+
+// Runs every pending free function; no thread may be inside a critical section
+ccol_status_t ccol_epoch_free(ccol_epoch_t **epoch_ptr);
+
+// The calling thread's record for this domain, claimed on first use. A thread's records are
+// handed back when it exits, or when it falls out of the thread's small record cache outside a
+// section, and reused later; an idle record never blocks reclamation.
+ccol_epoch_record_t *ccol_epoch_thread_record(ccol_epoch_t *epoch);
+
+// Critical sections; nesting is allowed and only the outermost pair publishes anything
+void ccol_epoch_enter(ccol_epoch_record_t *record);
+void ccol_epoch_exit(ccol_epoch_record_t *record);
+
+// Defers free_func(ptr, ctx) until no reader can still hold ptr. Call after unlinking ptr.
+ccol_status_t ccol_epoch_retire(ccol_epoch_t *epoch, void *ptr, ccol_epoch_free_func_t free_func, void *ctx);
+
+// Blocks until every critical section open at the time of the call has exited.
+// Must not be called from inside a critical section of the same domain.
+void ccol_epoch_synchronize(ccol_epoch_t *epoch);
+
+// Tries to advance the epoch and runs the free functions that have become safe;
+// returns how many ran
+size_t ccol_epoch_reclaim(ccol_epoch_t *epoch);
+
+size_t ccol_epoch_pending(ccol_epoch_t *epoch);
+
+#endif  // CCOL_EPOCH_H
@@ -0,0 +1,67 @@
+/*
+ * ccol/ccol_frozen_table.h
+ *
+ * Frozen (read-only, memory-mapped) hash table API.
+ *
+ * ccol_hash_table_freeze writes a table's keys and values into a flat,
+ * position-independent file: fixed-size key and value records addressed
+ * by offset, laid out as a Robin Hood probe table. ccol_frozen_table_open
+ * maps that file read-only and serves lookups straight from the mapping,
+ * with no parsing beyond a header check and no allocation, so processes
+ * opening the same file share its pages.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#ifndef CCOL_FROZEN_TABLE_H
+#define CCOL_FROZEN_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ccol_hash_table.h"
+#include "ccol_status.h"
+
+typedef struct ccol_frozen_table {
+    const unsigned char *base;  // start of the mapping
+    size_t mapped_size;
+    void *mapping;              // file-mapping handle on Windows, unused elsewhere
+
+    const uint8_t *ctrl;           // per slot: 0 empty, otherwise probe distance + 1
+    const uint32_t *hashes;        // per slot
+    const unsigned char *records;  // per slot: key, then value at value_offset
+
+    size_t num_slots;  // power of two
+    size_t size;
+    size_t key_size;
+    size_t value_size;
+    size_t value_offset;
+    size_t record_size;
+    uint64_t seed;
+
+    bool is_initialized;
+} ccol_frozen_table_t;
+
+// Freeze
+// Keys are stored as key_size raw bytes and compared bytewise, so they must be plain data
+// whose equality is byte equality. Each value is stored as value_size bytes copied from the
+// entry's value pointer (zeros for NULL); value_size 0 stores a key set.
+ccol_status_t ccol_hash_table_freeze(const ccol_hash_table_t *hash_table, size_t value_size, const char *path);
+
+// Open / Close
+ccol_status_t ccol_frozen_table_open(ccol_frozen_table_t *table, const char *path);
+ccol_status_t ccol_frozen_table_close(ccol_frozen_table_t *table);
+
+// Access
+// value_out points into the read-only mapping (8-byte aligned) and stays valid until close
+ccol_status_t ccol_frozen_table_get(const ccol_frozen_table_t *table, const void *key, const void **value_out);
+bool ccol_frozen_table_contains_key(const ccol_frozen_table_t *table, const void *key);
+
+// Attributes
+size_t ccol_frozen_table_size(const ccol_frozen_table_t *table);
+size_t ccol_frozen_table_key_size(const ccol_frozen_table_t *table);
+size_t ccol_frozen_table_value_size(const ccol_frozen_table_t *table);
+
+#endif  // CCOL_FROZEN_TABLE_H
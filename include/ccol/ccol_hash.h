@@ -18,6 +18,7 @@
 typedef struct ccol_hash_entry {
     void *key;
     void *value;
+    uint32_t hash;  // cached hasher output; set by the table on insert
 } ccol_hash_entry_t;
 
 typedef enum ccol_hash_policy {
@@ -37,6 +38,12 @@ static inline const char * ccol_hash_policy_to_string(ccol_hash_policy_t policy)
     }
 }
 
+// Key for seeded policies: SECURE uses k0/k1 as its SipHash key, ROBUST uses k0 as its seed
+typedef struct ccol_hash_key {
+    uint64_t k0;
+    uint64_t k1;
+} ccol_hash_key_t;
+
 typedef uint32_t (*ccol_hash_func_t)(const void *key, void *ctx);
 
 typedef struct {
@@ -57,6 +64,8 @@ ccol_status_t ccol_hash_create_from_policy(
     ccol_hash_t *hasher_out
 );
 
+ccol_status_t ccol_hash_key_random(ccol_hash_key_t *key_out);
+
 const char *ccol_hash_policy_to_str(ccol_hash_policy_t policy);
 
 #endif  // CCOL_HASH_H
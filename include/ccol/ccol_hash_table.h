@@ -11,20 +11,115 @@
 #define CCOL_HASH_TABLE_H
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
 
 #include "ccol_dll.h"
 #include "ccol_hash.h"
-#include "ccol_hash_table_iterator.h"
 #include "ccol_comparator.h"
 
+#define CCOL_HASH_TABLE_DEFAULT_MAX_LOAD_FACTOR 0.75
+#define CCOL_HASH_TABLE_DEFAULT_MIN_LOAD_FACTOR 0.10
+#define CCOL_HASH_TABLE_GROWTH_FACTOR 2
+
+// Tables with at least this many entries run resize, clear, clone and copy across the
+// threads set with ccol_hash_table_set_threads; smaller tables stay serial
+#define CCOL_HASH_TABLE_PARALLEL_MIN_SIZE 65536
+
+// Default max_load_factor for CCOL_HASH_TABLE_ROBIN_HOOD, whose runs stay short when nearly full
+#define CCOL_HASH_TABLE_ROBIN_HOOD_MAX_LOAD_FACTOR 0.90
+
+// Chain/probe lengths counted individually by ccol_hash_table_stats; the last entry collects the rest
+#define CCOL_HASH_TABLE_STATS_HISTOGRAM_SIZE 16
+
+typedef enum ccol_hash_table_engine {
+    CCOL_HASH_TABLE_CHAINED = 0,  // array of ccol_dll_t buckets
+    CCOL_HASH_TABLE_SWISS = 1,    // open addressing, control-byte groups, inline slots
+    CCOL_HASH_TABLE_ROBIN_HOOD = 2,  // linear probing, distance-ordered runs, inline slots
+} ccol_hash_table_engine_t;
+
+static inline const char *ccol_hash_table_engine_to_string(ccol_hash_table_engine_t engine) {
+    switch (engine) {
+        case CCOL_HASH_TABLE_CHAINED:   return "CCOL_HASH_TABLE_CHAINED";
+        case CCOL_HASH_TABLE_SWISS:     return "CCOL_HASH_TABLE_SWISS";
+        case CCOL_HASH_TABLE_ROBIN_HOOD: return "CCOL_HASH_TABLE_ROBIN_HOOD";
+        default:                        return "INVALID";
+    }
+}
+
+// Operation counters; only incremented when the library is built with -DCCOL_HASH_TABLE_STATS
+typedef struct ccol_hash_table_counters {
+    uint64_t lookups;      // get, get_many, contains and hashed finds
+    uint64_t comparisons;  // key comparator calls
+    uint64_t resizes;      // bucket/slot array reallocations
+} ccol_hash_table_counters_t;
+
+// Snapshot of how keys sit in the table. For CCOL_HASH_TABLE_CHAINED a chain is a bucket's
+// list; for open-addressing engines it is each entry's probe: groups visited for SWISS,
+// slots for ROBIN_HOOD (1 = found at home).
+typedef struct ccol_hash_table_stats {
+    size_t size;
+    size_t num_buckets;    // old and new buckets together during an incremental rehash
+    size_t empty_buckets;
+    double empty_ratio;
+
+    size_t max_chain;
+    double mean_chain;     // over non-empty buckets, or over entries for open addressing
+    size_t p99_chain;
+    size_t chain_histogram[CCOL_HASH_TABLE_STATS_HISTOGRAM_SIZE];  // [0] counts empty buckets
+
+    // Chi-square of entries per home bucket against a uniform spread, divided by its degrees
+    // of freedom: about 1 for a good hasher, far above it when keys pile into few buckets
+    double chi_square;
+
+    size_t memory_bytes;   // table, bucket/slot arrays and slabs; keys and values excluded
+
+    ccol_hash_table_counters_t counters;
+} ccol_hash_table_stats_t;
+
 typedef struct ccol_hash_table {
     ccol_dll_t **buckets;
-    size_t num_buckets;
+    size_t num_buckets;  // slot count for open-addressing engines
     size_t size;
     size_t key_size;
 
+    ccol_hash_table_engine_t engine;
+
+    // CCOL_HASH_TABLE_CHAINED storage: entries, chain nodes and bucket headers come from
+    // table-owned slabs; the freer only releases key/value
+    struct ccol__slab *entry_slab;
+    struct ccol__slab *node_slab;
+    struct ccol__slab *bucket_slab;
+
+    // Open-addressing storage (CCOL_HASH_TABLE_SWISS, CCOL_HASH_TABLE_ROBIN_HOOD); ctrl holds
+    // one byte per slot: a control word for SWISS, the probe distance for ROBIN_HOOD
+    uint8_t *ctrl;
+    ccol_hash_entry_t *slots;
+    size_t growth_left;
+
+    // CCOL_HASH_TABLE_SWISS with 4- or 8-byte keys and an integer key comparator: a copy of
+    // each slot's key, matched a whole group at a time instead of through the comparator
+    void *inline_keys;
+    size_t inline_key_size;  // 0 when keys go through the comparator
+
+    // Automatic resizing; a threshold of 0 disables that direction
+    double max_load_factor;
+    double min_load_factor;
+    size_t min_buckets;  // shrinking never goes below the size requested at create
+
+    // Incremental rehash (chained engine): while old_buckets is set, buckets below
+    // rehash_index have been migrated and every operation migrates rehash_step more
+    ccol_dll_t **old_buckets;
+    size_t old_num_buckets;
+    size_t rehash_index;
+    size_t rehash_step;  // 0 = rehash the whole table in one call
+
+    size_t num_threads;  // bulk operations on large tables; 0 or 1 = serial
+
+    ccol_hash_table_counters_t counters;
+
 	ccol_hash_t hasher;
+    ccol_hash_key_t hash_key;  // random per-table key for CCOL_HASH_SECURE when the hasher has no ctx
 
     ccol_copy_t copier;
     ccol_free_t freer;
@@ -44,6 +139,21 @@ ccol_status_t ccol_hash_table_init(
     ccol_comparator_t comparator
 );
 
+// Fully initializes a caller-owned table; release it with ccol_hash_table_destroy
+ccol_status_t ccol_hash_table_init_with_engine(
+    ccol_hash_table_t *hash_table,
+    size_t num_buckets,
+    size_t key_size,
+    ccol_hash_table_engine_t engine,
+    ccol_hash_policy_t policy,
+    ccol_hash_t hasher,
+    ccol_copy_t copier,
+    ccol_free_t freer,
+    ccol_print_t printer,
+    ccol_comparator_t comparator
+);
+
+// CCOL_HASH_TABLE_CHAINED; see ccol_hash_table_create_with_engine for the others
 ccol_status_t ccol_hash_table_create(
     ccol_hash_table_t **hash_table_out,
     size_t num_buckets,
@@ -56,9 +166,49 @@ ccol_status_t ccol_hash_table_create(
     ccol_comparator_t comparator
 );
 
+ccol_status_t ccol_hash_table_create_with_engine(
+    ccol_hash_table_t **hash_table_out,
+    size_t num_buckets,
+    size_t key_size,
+    ccol_hash_table_engine_t engine,
+    ccol_hash_policy_t policy,
+    ccol_hash_t hasher,
+    ccol_copy_t copier,
+    ccol_free_t freer,
+    ccol_print_t printer,
+    ccol_comparator_t comparator
+);
+
+// Builds a table sized for n keys in one pass; see ccol_hash_table_insert_bulk
+ccol_status_t ccol_hash_table_build(
+    ccol_hash_table_t **hash_table_out,
+    size_t key_size,
+    ccol_hash_table_engine_t engine,
+    ccol_hash_policy_t policy,
+    ccol_hash_t hasher,
+    ccol_copy_t copier,
+    ccol_free_t freer,
+    ccol_print_t printer,
+    ccol_comparator_t comparator,
+    void *const *keys,
+    void *const *values,
+    size_t n,
+    bool keys_unique
+);
+
 // Insertion
 ccol_status_t ccol_hash_table_insert(ccol_hash_table_t *hash_table, void *key, void *data);
 
+// values may be NULL; keys_unique skips duplicate checks (caller guarantees no repeats).
+// Duplicates are skipped and reported as CCOL_STATUS_ALREADY_EXISTS once all others are in.
+ccol_status_t ccol_hash_table_insert_bulk(
+    ccol_hash_table_t *hash_table,
+    void *const *keys,
+    void *const *values,
+    size_t n,
+    bool keys_unique
+);
+
 // Removal
 ccol_status_t ccol_hash_table_remove(ccol_hash_table_t *hash_table, void *key);
 
@@ -67,6 +217,16 @@ ccol_status_t ccol_hash_table_get_node(const ccol_hash_table_t *hash_table, cons
 ccol_status_t ccol_hash_table_get(const ccol_hash_table_t *hash_table, const void *key, void **data_out);
 ccol_status_t ccol_hash_table_get_all_keys(const ccol_hash_table_t *hash_table, void ***keys_out, size_t *key_count);
 
+// Batched get: values_out[i] is NULL for misses; found_mask (optional) gets bit i % 64 of
+// word i / 64 set per hit. Returns CCOL_STATUS_NOT_FOUND if any key was missing.
+ccol_status_t ccol_hash_table_get_many(
+    const ccol_hash_table_t *hash_table,
+    void *const *keys,
+    size_t n,
+    void **values_out,
+    uint64_t *found_mask
+);
+
 // Attributes
 bool ccol_hash_table_is_empty(const ccol_hash_table_t *hash_table);
 size_t ccol_hash_table_size(const ccol_hash_table_t *hash_table);
@@ -76,10 +236,21 @@ bool ccol_hash_table_contains_key(const ccol_hash_table_t *hash_table, const voi
 bool ccol_hash_table_contains(const ccol_hash_table_t *hash_table, const void *key); // default wrapper over contains key
 bool ccol_hash_table_contains_value(const ccol_hash_table_t *hash_table, void *value, void *ctx);
 double ccol_hash_table_load_factor(const ccol_hash_table_t *hash_table);
+ccol_status_t ccol_hash_table_set_load_factors(ccol_hash_table_t *hash_table, double min_load_factor, double max_load_factor);
 
 // Utilities
 ccol_status_t ccol_hash_table_swap(ccol_hash_table_t *hash_table, void *key1, void *key2);
 ccol_status_t ccol_hash_table_resize(ccol_hash_table_t *hash_table, int new_num_buckets);
+ccol_status_t ccol_hash_table_set_incremental_rehash(ccol_hash_table_t *hash_table, size_t buckets_per_step);
+bool ccol_hash_table_is_rehashing(const ccol_hash_table_t *hash_table);
+
+// Walks every bucket; meant for diagnostics, not hot paths
+ccol_status_t ccol_hash_table_stats(const ccol_hash_table_t *hash_table, ccol_hash_table_stats_t *stats_out);
+ccol_status_t ccol_hash_table_reset_counters(ccol_hash_table_t *hash_table);
+
+// Threads for bulk operations (0 or 1 = serial, the default). With more, the copier and freer
+// must be safe to call from several threads at once.
+ccol_status_t ccol_hash_table_set_threads(ccol_hash_table_t *hash_table, size_t num_threads);
 
 // Copy / Clone
 ccol_status_t ccol_hash_table_clone(const ccol_hash_table_t *src, ccol_hash_table_t **hash_table_out);
@@ -98,5 +269,6 @@ ccol_status_t ccol_hash_table_free(ccol_hash_table_t **hash_table_ptr);
 
 // Print / Debug
 ccol_status_t ccol_hash_table_print(ccol_hash_table_t *hash_table);
+ccol_status_t ccol_hash_table_print_stats(const ccol_hash_table_t *hash_table);
 
 #endif  // CCOL_HASH_TABLE_H
@@ -10,44 +10,76 @@
 #ifndef CCOL_HASH_TABLE_ITERATOR_H
 #define CCOL_HASH_TABLE_ITERATOR_H
 
+#include <stddef.h>
+
+#include "ccol_dll.h"
 #include "ccol_hash_table.h"
 #include "ccol_iterator.h"
+#include "ccol_status.h"
 
 typedef struct ccol_kv_pair {
     void *key;
     void *value;
 } ccol_kv_pair_t;
 
+// Caller-owned cursor; iterating with it never allocates. position is a flat bucket (slot)
+// index, so a scan can stop after any bucket and resume later from the saved position.
+typedef struct ccol_hash_table_cursor {
+    const ccol_hash_table_t *hash_table;
+    size_t position;        // next bucket to visit
+    ccol_dll_node_t *node;  // next node of the chain being read (chained engine)
+    ccol_kv_pair_t item;    // entry last returned by ccol_hash_table_cursor_next
+} ccol_hash_table_cursor_t;
+
+// Cursor
+ccol_status_t ccol_hash_table_cursor_init(ccol_hash_table_cursor_t *cursor, const ccol_hash_table_t *hash_table);
+ccol_hash_table_cursor_t ccol_hash_table_cursor_begin(const ccol_hash_table_t *hash_table);
+ccol_status_t ccol_hash_table_cursor_seek(ccol_hash_table_cursor_t *cursor, size_t position);
+
+// Next entry, or NULL once every bucket has been read; the pair is cursor->item
+ccol_kv_pair_t *ccol_hash_table_cursor_next(ccol_hash_table_cursor_t *cursor);
+
+// Resumable scan over whole buckets: copies entries from *position on into items_out until the
+// next bucket would not fit, then advances *position past the buckets copied. *position wraps
+// to 0 when the scan is complete. Entries present for the whole scan are returned exactly once
+// as long as the table is not resized in between; CCOL_STATUS_FULL if a single bucket holds
+// more than capacity entries.
+ccol_status_t ccol_hash_table_scan(
+    const ccol_hash_table_t *hash_table,
+    size_t *position,
+    ccol_kv_pair_t *items_out,
+    size_t capacity,
+    size_t *count_out
+);
+
 // Iterator
 ccol_iterator_t *ccol_hash_table_iterator_create(const ccol_hash_table_t *hash_table);
 ccol_iterator_t *ccol_hash_table_keys(const ccol_hash_table_t *hash_table);
 ccol_iterator_t *ccol_hash_table_values(const ccol_hash_table_t *hash_table);
 ccol_iterator_t *ccol_hash_table_items(const ccol_hash_table_t *hash_table);
 
+// Loops run on a stack cursor; break is safe and nothing needs freeing
 #define CCOL_HASH_TABLE_VALUES_FOR(type, var, hash_table_ptr)                                        \
-    for (ccol_iterator_t *_it = ccol_hash_table_iterator_create(hash_table_ptr); _it; _it = NULL)    \
+    for (ccol_hash_table_cursor_t _cursor = ccol_hash_table_cursor_begin(hash_table_ptr);            \
+        _cursor.hash_table; _cursor.hash_table = NULL)                                               \
         for (type *var = NULL;                                                                       \
-            _it->has_next(_it) &&                                                                    \
-            ((var = (type *)_it->next(_it)) || 1);)                                                  \
-            for (int _done = (_it->destroy(_it), 0); !_done; _done = 1)
+            ccol_hash_table_cursor_next(&_cursor) &&                                                 \
+            ((var = (type *)_cursor.item.value) || 1);)
 
 #define CCOL_HASH_TABLE_KEYS_FOR(type, var, hash_table_ptr)                                          \
-    for (ccol_iterator_t *_it = ccol_hash_table_keys(hash_table_ptr); _it; _it = NULL)               \
+    for (ccol_hash_table_cursor_t _cursor = ccol_hash_table_cursor_begin(hash_table_ptr);            \
+        _cursor.hash_table; _cursor.hash_table = NULL)                                               \
         for (type *var = NULL;                                                                       \
-            _it->has_next(_it) &&                                                                    \
-            ((var = (type *)_it->next(_it)) || 1);)                                                  \
-            for (int _done = (_it->destroy(_it), 0); !_done; _done = 1)
+            ccol_hash_table_cursor_next(&_cursor) &&                                                 \
+            ((var = (type *)_cursor.item.key) || 1);)
 
 #define CCOL_HASH_TABLE_FOR(type, var, hash_table_ptr)                                               \
     CCOL_HASH_TABLE_VALUES_FOR(type, var, hash_table_ptr)
 
 #define CCOL_HASH_TABLE_ITEMS_FOR(kv_pair_var, hash_table_ptr)                                       \
-    for (ccol_iterator_t *_it = ccol_hash_table_items(hash_table_ptr); _it; _it = NULL)              \
+    for (ccol_hash_table_cursor_t _cursor = ccol_hash_table_cursor_begin(hash_table_ptr);            \
+        _cursor.hash_table; _cursor.hash_table = NULL)                                               \
         for (ccol_kv_pair_t *kv_pair_var = NULL;                                                     \
-            _it->has_next(_it) &&                                                                    \
-            ((kv_pair_var = (ccol_kv_pair_t *)_it->next(_it)) || 1);)                                \
-            for (int _done = (_it->destroy(_it), 0); !_done; _done = 1)
-
-
+            (kv_pair_var = ccol_hash_table_cursor_next(&_cursor)) != NULL;)
 
 #endif  // CCOL_HASH_TABLE_ITERATOR_H
@@ -0,0 +1,97 @@
+/*
+ * ccol/ccol_intern.h
+ *
+ * String interning API.
+ *
+ * Each distinct string is copied once into an append-only arena and gets a
+ * dense, stable id; interning the same bytes again returns the same id, so
+ * interned strings compare by id. Lookups check a slot's cached hash, then
+ * the entry's length and inline prefix, and only touch the arena when all
+ * of those match.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#ifndef CCOL_INTERN_H
+#define CCOL_INTERN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ccol_hash.h"
+#include "ccol_status.h"
+
+#define CCOL_INTERN_PREFIX_SIZE 8
+#define CCOL_INTERN_CHUNK_SIZE 65536  // arena chunk; longer strings get a chunk of their own
+#define CCOL_INTERN_MAX_LOAD_FACTOR 0.75
+
+typedef uint32_t ccol_intern_id_t;  // 0, 1, 2, ... in first-intern order
+
+typedef struct ccol_intern_entry {
+    uint32_t hash;
+    uint32_t length;
+    uint32_t chunk;   // arena chunk and byte offset of the NUL-terminated copy
+    uint32_t offset;
+    char prefix[CCOL_INTERN_PREFIX_SIZE];  // leading bytes, zero-padded
+} ccol_intern_entry_t;
+
+typedef struct ccol_intern_slot {
+    uint32_t id_plus_one;  // 0 is empty
+    uint32_t hash;
+} ccol_intern_slot_t;
+
+typedef struct ccol_intern {
+    ccol_intern_entry_t *entries;  // by id
+    size_t size;
+    size_t entries_capacity;
+
+    ccol_intern_slot_t *slots;  // linear probing over ids
+    size_t num_slots;           // power of two
+
+    char **chunks;  // append-only arena; strings never move
+    size_t num_chunks;
+    size_t chunks_capacity;
+    size_t chunk_used;  // bytes used in the newest chunk
+    size_t chunk_size;  // capacity of the newest chunk
+    size_t arena_bytes; // string bytes stored, NULs included
+
+    ccol_hash_policy_t policy;
+    ccol_hash_key_t hash_key;
+
+    bool is_initialized;
+} ccol_intern_t;
+
+// Create / Initialize
+// policy is CCOL_HASH_ROBUST (seed 0, so hashes equal the ROBUST string hasher's) or
+// CCOL_HASH_SECURE (random per-table key)
+ccol_status_t ccol_intern_init(ccol_intern_t *intern, ccol_hash_policy_t policy);
+ccol_status_t ccol_intern_create(ccol_intern_t **intern_out, ccol_hash_policy_t policy);
+
+// Insertion
+ccol_status_t ccol_intern(ccol_intern_t *intern, const char *str, ccol_intern_id_t *id_out);
+// length bytes of data, which may contain NULs; the stored copy is NUL-terminated
+ccol_status_t ccol_intern_n(ccol_intern_t *intern, const char *data, size_t length, ccol_intern_id_t *id_out);
+
+// Access
+ccol_status_t ccol_intern_find(const ccol_intern_t *intern, const char *str, ccol_intern_id_t *id_out);
+ccol_status_t ccol_intern_find_n(
+    const ccol_intern_t *intern,
+    const char *data,
+    size_t length,
+    ccol_intern_id_t *id_out
+);
+// Valid until the table is destroyed; NULL for unknown ids
+const char *ccol_intern_str(const ccol_intern_t *intern, ccol_intern_id_t id);
+size_t ccol_intern_length(const ccol_intern_t *intern, ccol_intern_id_t id);
+
+// Attributes
+size_t ccol_intern_size(const ccol_intern_t *intern);
+size_t ccol_intern_arena_bytes(const ccol_intern_t *intern);
+
+// Cleanup
+ccol_status_t ccol_intern_destroy(ccol_intern_t *intern);
+ccol_status_t ccol_intern_free(ccol_intern_t **intern_ptr);
+
+#endif  // CCOL_INTERN_H
@@ -0,0 +1,108 @@
+/*
+ * ccol/ccol_lru.h
+ *
+ * Bounded least-recently-used cache API.
+ *
+ * A hash table maps each key to a node that carries the entry's recency
+ * links, so a hit is one lookup plus a constant-time relink, and evicting
+ * the oldest entry needs no search. Nodes come from a slab and are recycled
+ * on eviction, so a full cache inserts without allocating.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#ifndef CCOL_LRU_H
+#define CCOL_LRU_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ccol_comparator.h"
+#include "ccol_free.h"
+#include "ccol_hash.h"
+#include "ccol_hash_table.h"
+#include "ccol_status.h"
+
+typedef struct ccol_lru_node {
+    struct ccol_lru_node *newer;
+    struct ccol_lru_node *older;
+    void *key;
+    void *value;
+    size_t cost;
+    uint32_t hash;
+} ccol_lru_node_t;
+
+typedef struct ccol_lru {
+    ccol_hash_table_t *index;  // key -> ccol_lru_node_t
+    struct ccol__slab *node_slab;
+
+    ccol_lru_node_t *newest;
+    ccol_lru_node_t *oldest;
+
+    size_t size;
+    size_t cost;
+    size_t max_size;  // 0 = no count limit
+    size_t max_cost;  // 0 = no cost limit
+
+    ccol_comparator_t key_cmp;
+    ccol_free_t evictor;  // gets a ccol_hash_entry_t with the key/value leaving the cache
+
+    bool is_initialized;
+} ccol_lru_t;
+
+// Create / Initialize
+// The index refers to lru->key_cmp, so an initialized cache must not be moved or copied
+ccol_status_t ccol_lru_init(
+    ccol_lru_t *lru,
+    size_t max_size,
+    size_t max_cost,
+    size_t key_size,
+    ccol_hash_table_engine_t engine,
+    ccol_hash_policy_t policy,
+    ccol_hash_t hasher,
+    ccol_comparator_t key_cmp,
+    ccol_free_t evictor
+);
+
+ccol_status_t ccol_lru_create(
+    ccol_lru_t **lru_out,
+    size_t max_size,
+    size_t max_cost,
+    size_t key_size,
+    ccol_hash_table_engine_t engine,
+    ccol_hash_policy_t policy,
+    ccol_hash_t hasher,
+    ccol_comparator_t key_cmp,
+    ccol_free_t evictor
+);
+
+// Insertion
+// Takes ownership of key and value. An existing key is refreshed: its old key/value go to the
+// evictor. Evicts the oldest entries until both limits hold; CCOL_STATUS_FULL if cost alone
+// exceeds max_cost (nothing is stored or evicted).
+ccol_status_t ccol_lru_put(ccol_lru_t *lru, void *key, void *value, size_t cost);
+
+// Removal
+ccol_status_t ccol_lru_remove(ccol_lru_t *lru, const void *key);
+ccol_status_t ccol_lru_evict_oldest(ccol_lru_t *lru);
+
+// Access
+// A hit makes the entry the most recently used
+ccol_status_t ccol_lru_get(ccol_lru_t *lru, const void *key, void **value_out);
+// Looks without touching recency
+ccol_status_t ccol_lru_peek(const ccol_lru_t *lru, const void *key, void **value_out);
+bool ccol_lru_contains(const ccol_lru_t *lru, const void *key);
+
+// Attributes
+size_t ccol_lru_size(const ccol_lru_t *lru);
+size_t ccol_lru_cost(const ccol_lru_t *lru);
+ccol_status_t ccol_lru_set_capacity(ccol_lru_t *lru, size_t max_size, size_t max_cost);
+
+// Cleanup
+ccol_status_t ccol_lru_clear(ccol_lru_t *lru);
+ccol_status_t ccol_lru_destroy(ccol_lru_t *lru);
+ccol_status_t ccol_lru_free(ccol_lru_t **lru_ptr);
+
+#endif  // CCOL_LRU_H
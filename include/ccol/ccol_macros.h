@@ -30,6 +30,13 @@
         if (!(ptr->is_initialized)) return CCOL_STATUS_UNINITIALIZED;   \
     } while (0)
 
+// Read prefetch hint; a no-op where the compiler has no builtin
+#if defined(__GNUC__) || defined(__clang__)
+#define CCOL_PREFETCH(addr) __builtin_prefetch((addr), 0, 3)
+#else
+#define CCOL_PREFETCH(addr) ((void)(addr))
+#endif
+
 #define CCOL_COPY_DEFAULT ccol_copy_identity
 
 #define CCOL_SWAP_PTR(x, y) ccol_swap((void *)&(x), (void *)&(y), sizeof(x));
@@ -0,0 +1,97 @@
+/*
+ * ccol/ccol_mph.h
+ *
+ * Minimal perfect hash API.
+ *
+ * Maps a static set of n keys one-to-one onto [0, n), PTHash/CHD style:
+ * keys are split into small buckets and each bucket stores a 16-bit pilot
+ * that moves all of its keys to free slots. Bucket sizes are skewed so
+ * the buckets placed last, into an almost full table, are small. A lookup is one key hash, one
+ * pilot read, one slot computation and one key compare; there are no
+ * chains. Metadata is about 3 bits per key.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#ifndef CCOL_MPH_H
+#define CCOL_MPH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ccol_hash.h"
+#include "ccol_hash_table.h"
+#include "ccol_comparator.h"
+#include "ccol_status.h"
+
+#define CCOL_MPH_KEYS_PER_BUCKET 6  // average bucket size; 16-bit pilots cost 16 / 6 bits per key
+#define CCOL_MPH_LOAD_FACTOR 0.99   // slots are n / 0.99; the spare 1% are remapped into [0, n)
+
+typedef struct ccol_mph {
+    size_t size;         // indices are [0, size)
+    size_t num_slots;
+    size_t num_buckets;
+    size_t num_dense_buckets;  // the first 30% of buckets take 60% of the keys
+
+    uint16_t *pilots;    // per bucket
+    uint32_t *remap;     // slot - size -> index, for slots at or past size
+    const void **keys;   // keys[index]; caller owned, only used to reject non-members
+
+    size_t key_size;
+    ccol_hash_policy_t policy;
+    ccol_hash_func_t hash_func;
+    ccol_hash_key_t hash_keys[2];  // ctx of the two seeded calls forming a key's 64-bit hash
+
+    ccol_comparator_t comparator;
+
+    bool is_initialized;
+} ccol_mph_t;
+
+// Create / Initialize
+// policy must be seeded (CCOL_HASH_ROBUST or CCOL_HASH_SECURE) so a failed build can retry
+// with fresh seeds. Duplicate keys fail with CCOL_STATUS_ALREADY_EXISTS.
+ccol_status_t ccol_mph_init(
+    ccol_mph_t *mph,
+    size_t key_size,
+    ccol_hash_policy_t policy,
+    ccol_comparator_t comparator,
+    void *const *keys,
+    size_t n
+);
+
+ccol_status_t ccol_mph_create(
+    ccol_mph_t **mph_out,
+    size_t key_size,
+    ccol_hash_policy_t policy,
+    ccol_comparator_t comparator,
+    void *const *keys,
+    size_t n
+);
+
+// Builds over ccol_hash_table_get_all_keys; comparator compares raw keys, not entries
+ccol_status_t ccol_mph_create_from_hash_table(
+    ccol_mph_t **mph_out,
+    const ccol_hash_table_t *hash_table,
+    ccol_hash_policy_t policy,
+    ccol_comparator_t comparator
+);
+
+// Access
+// CCOL_STATUS_NOT_FOUND for keys outside the set
+ccol_status_t ccol_mph_index(const ccol_mph_t *mph, const void *key, size_t *index_out);
+// Skips the key compare; any key, member or not, maps to some index in [0, size)
+size_t ccol_mph_index_unchecked(const ccol_mph_t *mph, const void *key);
+bool ccol_mph_contains(const ccol_mph_t *mph, const void *key);
+const void *ccol_mph_key_at(const ccol_mph_t *mph, size_t index);
+
+// Attributes
+size_t ccol_mph_size(const ccol_mph_t *mph);
+double ccol_mph_bits_per_key(const ccol_mph_t *mph);  // pilots and remap table, excluding keys
+
+// Cleanup
+ccol_status_t ccol_mph_destroy(ccol_mph_t *mph);
+ccol_status_t ccol_mph_free(ccol_mph_t **mph_ptr);
+
+#endif  // CCOL_MPH_H
@@ -12,6 +12,7 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "ccol_constants.h"
 #include "ccol_status.h"
@@ -21,6 +22,23 @@
 #include "ccol_print.h"
 #include "ccol_comparator.h"
 
+#define CCOL_VECTOR_DEFAULT_GROWTH_FACTOR 2.0
+#define CCOL_VECTOR_MIN_CAPACITY 4  // first allocation made by growth
+
+// On Linux, buffers of at least this many bytes are mmap-backed and grow with mremap, which
+// moves page mappings instead of copying; elsewhere every size goes through realloc
+#define CCOL_VECTOR_MAP_THRESHOLD ((size_t)64 << 20)
+
+// Elements a worker claims at a time in the parallel algorithms; vectors no larger than one
+// grain run on the calling thread
+#define CCOL_VECTOR_DEFAULT_GRAIN_SIZE 16384
+
+// Callbacks for the parallel algorithms; with more than one thread they run concurrently
+typedef void (*ccol_vector_apply_func_t)(void *element, void *ctx);
+typedef void (*ccol_vector_transform_func_t)(const void *element, void *out, void *ctx);
+typedef void (*ccol_vector_reduce_func_t)(void *acc, const void *element, void *ctx);  // acc = acc op element
+typedef bool (*ccol_vector_predicate_func_t)(const void *element, void *ctx);
+
 typedef struct ccol_vector {
     void *data;
 
@@ -28,6 +46,12 @@ typedef struct ccol_vector {
     size_t capacity;
     size_t element_size;
 
+    double growth_factor;  // capacity multiplier when an insert finds the vector full
+    bool is_mapped;        // data is an anonymous mapping, not a malloc block
+
+    size_t num_threads;  // parallel algorithms; 0 or 1 = serial
+    size_t grain_size;   // elements per claimed chunk
+
     ccol_copy_t copier;
     ccol_free_t freer;
     ccol_print_t printer;
@@ -36,6 +60,20 @@ typedef struct ccol_vector {
     bool is_initialized;
 } ccol_vector_t;
 
+// Read-only search index over a sorted vector with a built-in integer comparator: keys in
+// breadth-first (Eytzinger) tree order, so lookups are branch-free and cache friendly.
+// It copies the keys; rebuild it after the vector changes.
+typedef struct ccol_vector_eytzinger {
+    void *block;      // allocation behind keys
+    uint64_t *keys;   // 1-based, cache-line aligned; node k's children are 2k and 2k + 1
+    size_t *ranks;    // index in the vector of each node's key
+    size_t size;
+    size_t element_size;
+    bool is_signed;   // keys were stored with the sign bit flipped
+
+    bool is_initialized;
+} ccol_vector_eytzinger_t;
+
 // Create / Initialize
 ccol_status_t ccol_vector_init(
     ccol_vector_t *vec,
@@ -60,7 +98,7 @@ ccol_status_t ccol_vector_create(
 // Insertion
 ccol_status_t ccol_vector_append(ccol_vector_t *vec, void *data);
 ccol_status_t ccol_vector_insert(ccol_vector_t *vec, size_t index, void *data);
-ccol_status_t ccol_vector_insert_middle(ccol_vector_t *vec, size_t index, void *data);
+ccol_status_t ccol_vector_insert_middle(ccol_vector_t *vec, void *data);
 
 // Fill / Assign
 ccol_status_t ccol_vector_fill(ccol_vector_t *vec, size_t count, void *value);
@@ -101,9 +139,53 @@ ccol_status_t ccol_vector_set(ccol_vector_t *vec, size_t index, void *value);
 ccol_status_t ccol_vector_swap(ccol_vector_t *vec, size_t i, size_t j);
 ccol_status_t ccol_vector_reserve(ccol_vector_t *vec, size_t new_capacity);
 ccol_status_t ccol_vector_reserve_exact(ccol_vector_t *vec, size_t exact_capacity);
+// Grows geometrically (growth_factor) until min_capacity fits
+ccol_status_t ccol_vector_ensure_capacity(ccol_vector_t *vec, size_t min_capacity);
+// growth_factor must be > 1, e.g. 1.5 to waste less memory or 2 for fewer reallocations
+ccol_status_t ccol_vector_set_growth_factor(ccol_vector_t *vec, double growth_factor);
 ccol_status_t ccol_vector_shrink_to_fit(ccol_vector_t *vec);
 ccol_status_t ccol_vector_resize(ccol_vector_t *vec, size_t new_size, void *default_value);
 
+// Sorting
+// Ascending by the comparator; built-in integer comparators take a radix sort
+ccol_status_t ccol_vector_sort(ccol_vector_t *vec);
+// Like ccol_vector_sort, but equal elements keep their order; needs a buffer of size elements
+ccol_status_t ccol_vector_stable_sort(ccol_vector_t *vec);
+
+// Sorted search
+// vec must be sorted by its comparator. Bounds are indices in [0, size]: lower is the first
+// element not less than value, upper the first greater than it
+ccol_status_t ccol_vector_binary_search(const ccol_vector_t *vec, const void *value, size_t *index_out);
+ccol_status_t ccol_vector_lower_bound(const ccol_vector_t *vec, const void *value, size_t *index_out);
+ccol_status_t ccol_vector_upper_bound(const ccol_vector_t *vec, const void *value, size_t *index_out);
+ccol_status_t ccol_vector_equal_range(const ccol_vector_t *vec, const void *value, size_t *begin_out, size_t *end_out);
+
+// CCOL_STATUS_COMPARATOR_FUNC unless vec uses a built-in integer comparator, INVALID_ARG
+// unless it is sorted; the bounds match ccol_vector_lower_bound / upper_bound on vec
+ccol_status_t ccol_vector_eytzinger_init(ccol_vector_eytzinger_t *index, const ccol_vector_t *vec);
+ccol_status_t ccol_vector_eytzinger_lower_bound(const ccol_vector_eytzinger_t *index, const void *value, size_t *index_out);
+ccol_status_t ccol_vector_eytzinger_upper_bound(const ccol_vector_eytzinger_t *index, const void *value, size_t *index_out);
+ccol_status_t ccol_vector_eytzinger_destroy(ccol_vector_eytzinger_t *index);
+
+// Parallel algorithms
+// Each splits the buffer into grain_size chunks that num_threads workers claim in turn
+ccol_status_t ccol_vector_set_threads(ccol_vector_t *vec, size_t num_threads);
+// 0 restores CCOL_VECTOR_DEFAULT_GRAIN_SIZE
+ccol_status_t ccol_vector_set_grain_size(ccol_vector_t *vec, size_t grain_size);
+
+// Sorts equal-sized blocks in parallel, then merges them pairwise with every pass split
+// across all threads; needs a buffer of size elements
+ccol_status_t ccol_vector_parallel_sort(ccol_vector_t *vec);
+ccol_status_t ccol_vector_for_each(ccol_vector_t *vec, ccol_vector_apply_func_t func, void *ctx);
+// dest (already initialized, dest->element_size bytes per output) ends up with one output per
+// element of src; its old contents are cleared unless dest == src, which transforms in place
+ccol_status_t ccol_vector_transform(const ccol_vector_t *src, ccol_vector_t *dest, ccol_vector_transform_func_t func, void *ctx);
+// func must be associative and identity its identity; result_out gets element_size bytes
+ccol_status_t ccol_vector_reduce(const ccol_vector_t *vec, const void *identity, ccol_vector_reduce_func_t func, void *ctx, void *result_out);
+ccol_status_t ccol_vector_count_if(const ccol_vector_t *vec, ccol_vector_predicate_func_t func, void *ctx, size_t *count_out);
+// Lowest matching index, the same one a serial scan returns
+ccol_status_t ccol_vector_find_first(const ccol_vector_t *vec, ccol_vector_predicate_func_t func, void *ctx, size_t *index_out);
+
 // Copy / Clone
 ccol_status_t ccol_vector_clone(const ccol_vector_t *src, ccol_vector_t **vec_out);
 ccol_status_t ccol_vector_deep_clone(const ccol_vector_t *src, ccol_vector_t **vec_out);
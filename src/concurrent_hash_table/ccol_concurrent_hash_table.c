@@ -0,0 +1,330 @@
+/*
+ * ccol/src/concurrent_hash_table/ccol_concurrent_hash_table.c
+ *
+ * Sharded concurrent hash table implementation.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L  // pthread rwlocks under -std=c99
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "ccol/ccol_concurrent_hash_table.h"
+#include "ccol/ccol_epoch.h"
+#include "ccol/ccol_hash.h"
+#include "ccol/ccol_hash_table.h"
+#include "ccol/ccol_macros.h"
+#include "ccol/ccol_status.h"
+
+#include "internal.h"
+#include "hash_table/internal.h"
+#include "internal_rwlock.h"
+#include "internal_atomic.h"
+
+// Create / Initialize
+ccol_status_t ccol_concurrent_hash_table_init(
+    ccol_concurrent_hash_table_t *table,
+    size_t num_shards,
+    size_t buckets_per_shard,
+    size_t key_size,
+    ccol_hash_table_engine_t engine,
+    ccol_concurrent_hash_table_mode_t mode,
+    ccol_hash_policy_t policy,
+    ccol_hash_t hasher,
+    ccol_copy_t copier,
+    ccol_free_t freer,
+    ccol_print_t printer,
+    ccol_comparator_t comparator
+) {
+    if (!table || num_shards < 1 || num_shards > CCOL_CONCURRENT_HASH_TABLE_MAX_SHARDS) return CCOL_STATUS_INVALID_ARG;
+    if (buckets_per_shard < 1 || key_size < 1) return CCOL_STATUS_INVALID_ARG;
+    if (engine != CCOL_HASH_TABLE_CHAINED && engine != CCOL_HASH_TABLE_SWISS &&
+        engine != CCOL_HASH_TABLE_ROBIN_HOOD) return CCOL_STATUS_INVALID_ARG;
+    if (mode != CCOL_CONCURRENT_HASH_TABLE_LOCKED && mode != CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY) return CCOL_STATUS_INVALID_ARG;
+    if (mode == CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY && engine != CCOL_HASH_TABLE_CHAINED) return CCOL_STATUS_INVALID_ARG;
+    if (!comparator.func) return CCOL_STATUS_COMPARATOR_FUNC;
+    if (!hasher.func) return CCOL_STATUS_HASH_FUNC;
+
+    size_t count = 1;
+    unsigned bits = 0;
+    while (count < num_shards) {
+        count <<= 1;
+        bits++;
+    }
+
+    // Read-mostly shards index their buckets with a mask
+    size_t min_buckets = 1;
+    while (min_buckets < buckets_per_shard) {
+        if (min_buckets > SIZE_MAX / 2) return CCOL_STATUS_INVALID_ARG;
+        min_buckets <<= 1;
+    }
+
+    *table = (ccol_concurrent_hash_table_t){0};
+
+    // The shard is chosen with the same hash the shard table indexes with, so every
+    // shard must hash identically: resolve the secure key once, here
+    if (policy == CCOL_HASH_SECURE && !hasher.ctx) {
+        ccol_status_t status = ccol_hash_key_random(&table->hash_key);
+        if (status != CCOL_STATUS_OK) return status;
+        hasher.ctx = &table->hash_key;
+    }
+    table->hasher = ccol_hash_create(hasher.func, hasher.ctx, policy);
+
+    table->shards = calloc(count, sizeof(ccol__concurrent_shard_t));
+    if (!table->shards) return CCOL_STATUS_ALLOC;
+
+    table->shard_shift = 32 - bits;
+    table->key_size = key_size;
+    table->engine = engine;
+    table->mode = mode;
+    table->is_initialized = true;
+
+    if (mode == CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY) {
+        ccol_status_t status = ccol_epoch_create(&table->epoch);
+        if (status != CCOL_STATUS_OK) {
+            ccol__concurrent_hash_table_uninit(table);
+            return status;
+        }
+
+        table->min_buckets = min_buckets;
+        table->freer = freer;
+        table->comparator = comparator;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        ccol__concurrent_shard_t *shard = &table->shards[i];
+        if (ccol__rwlock_init(&shard->lock) != 0) {
+            ccol__concurrent_hash_table_uninit(table);
+            return CCOL_STATUS_ERROR;
+        }
+
+        // Counted before the table exists so uninit destroys this shard's lock too
+        table->num_shards = i + 1;
+
+        if (mode == CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY) {
+            ccol_status_t status = ccol__read_mostly_init(shard, min_buckets);
+            if (status != CCOL_STATUS_OK) {
+                ccol__concurrent_hash_table_uninit(table);
+                return status;
+            }
+            continue;
+        }
+
+        ccol_status_t status = ccol_hash_table_create_with_engine(
+            &shard->table,
+            buckets_per_shard,
+            key_size,
+            engine,
+            policy,
+            table->hasher,
+            copier,
+            freer,
+            printer,
+            comparator
+        );
+        if (status != CCOL_STATUS_OK) {
+            ccol__concurrent_hash_table_uninit(table);
+            return status;
+        }
+    }
+
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_concurrent_hash_table_create(
+    ccol_concurrent_hash_table_t **table_out,
+    size_t num_shards,
+    size_t buckets_per_shard,
+    size_t key_size,
+    ccol_hash_table_engine_t engine,
+    ccol_concurrent_hash_table_mode_t mode,
+    ccol_hash_policy_t policy,
+    ccol_hash_t hasher,
+    ccol_copy_t copier,
+    ccol_free_t freer,
+    ccol_print_t printer,
+    ccol_comparator_t comparator
+) {
+    if (!table_out) return CCOL_STATUS_INVALID_ARG;
+
+    *table_out = NULL;
+
+    ccol_concurrent_hash_table_t *table = calloc(1, sizeof(ccol_concurrent_hash_table_t));
+    if (!table) return CCOL_STATUS_ALLOC;
+
+    ccol_status_t status = ccol_concurrent_hash_table_init(
+        table,
+        num_shards,
+        buckets_per_shard,
+        key_size,
+        engine,
+        mode,
+        policy,
+        hasher,
+        copier,
+        freer,
+        printer,
+        comparator
+    );
+    if (status != CCOL_STATUS_OK) {
+        free(table);
+        return status;
+    }
+
+    *table_out = table;
+    return CCOL_STATUS_OK;
+}
+
+// Insertion / Removal
+ccol_status_t ccol_concurrent_hash_table_insert(ccol_concurrent_hash_table_t *table, void *key, void *data) {
+    CCOL_CHECK_INIT(table);
+    if (!key) return CCOL_STATUS_INVALID_ARG;
+
+    // Hash outside the lock; the shard table reuses it instead of hashing again
+    uint32_t hash = table->hasher.func(key, table->hasher.ctx);
+    ccol__concurrent_shard_t *shard = ccol__concurrent_shard_for(table, hash);
+
+    if (ccol__rwlock_wrlock(&shard->lock) != 0) return CCOL_STATUS_ERROR;
+    ccol_status_t status = table->mode == CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY
+        ? ccol__read_mostly_insert(table, shard, key, data, hash)
+        : ccol__hash_table_insert_hashed(shard->table, key, data, hash);
+    ccol__rwlock_wrunlock(&shard->lock);
+
+    return status;
+}
+
+ccol_status_t ccol_concurrent_hash_table_remove(ccol_concurrent_hash_table_t *table, const void *key) {
+    CCOL_CHECK_INIT(table);
+    if (!key) return CCOL_STATUS_INVALID_ARG;
+
+    uint32_t hash = table->hasher.func(key, table->hasher.ctx);
+    ccol__concurrent_shard_t *shard = ccol__concurrent_shard_for(table, hash);
+
+    if (ccol__rwlock_wrlock(&shard->lock) != 0) return CCOL_STATUS_ERROR;
+    ccol_status_t status = table->mode == CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY
+        ? ccol__read_mostly_remove(table, shard, key, hash)
+        : ccol__hash_table_remove_hashed(shard->table, key, hash);
+    ccol__rwlock_wrunlock(&shard->lock);
+
+    return status;
+}
+
+// Access
+// Readers share the lock, so they use the non-migrating lookup; a migration left pending by a
+// failed allocation is only advanced by insert and remove under the write lock
+ccol_status_t ccol_concurrent_hash_table_get(ccol_concurrent_hash_table_t *table, const void *key, void **data_out) {
+    CCOL_CHECK_INIT(table);
+    if (!key || !data_out) return CCOL_STATUS_INVALID_ARG;
+
+    uint32_t hash = table->hasher.func(key, table->hasher.ctx);
+    ccol__concurrent_shard_t *shard = ccol__concurrent_shard_for(table, hash);
+
+    if (table->mode == CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY) return ccol__read_mostly_get(table, shard, key, hash, data_out);
+
+    if (ccol__rwlock_rdlock(&shard->lock) != 0) return CCOL_STATUS_ERROR;
+    ccol_hash_entry_t *entry = ccol__hash_table_peek_hashed(shard->table, key, hash);
+    if (entry) *data_out = entry->value;
+    ccol__rwlock_rdunlock(&shard->lock);
+
+    return entry ? CCOL_STATUS_OK : CCOL_STATUS_NOT_FOUND;
+}
+
+bool ccol_concurrent_hash_table_contains_key(ccol_concurrent_hash_table_t *table, const void *key) {
+    if (!table || !table->is_initialized || !key) return false;
+
+    uint32_t hash = table->hasher.func(key, table->hasher.ctx);
+    ccol__concurrent_shard_t *shard = ccol__concurrent_shard_for(table, hash);
+
+    if (table->mode == CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY) {
+        return ccol__read_mostly_get(table, shard, key, hash, NULL) == CCOL_STATUS_OK;
+    }
+
+    if (ccol__rwlock_rdlock(&shard->lock) != 0) return false;
+    bool found = ccol__hash_table_peek_hashed(shard->table, key, hash) != NULL;
+    ccol__rwlock_rdunlock(&shard->lock);
+
+    return found;
+}
+
+// Attributes
+size_t ccol_concurrent_hash_table_size(ccol_concurrent_hash_table_t *table) {
+    if (!table || !table->is_initialized) return 0;
+
+    size_t size = 0;
+    for (size_t i = 0; i < table->num_shards; i++) {
+        ccol__concurrent_shard_t *shard = &table->shards[i];
+        if (table->mode == CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY) {
+            size += CCOL__ATOMIC_LOAD_RELAXED(&shard->size);
+            continue;
+        }
+
+        if (ccol__rwlock_rdlock(&shard->lock) != 0) continue;
+        size += ccol_hash_table_size(shard->table);
+        ccol__rwlock_rdunlock(&shard->lock);
+    }
+
+    return size;
+}
+
+bool ccol_concurrent_hash_table_is_empty(ccol_concurrent_hash_table_t *table) {
+    return ccol_concurrent_hash_table_size(table) == 0;
+}
+
+size_t ccol_concurrent_hash_table_num_shards(const ccol_concurrent_hash_table_t *table) {
+    if (!table || !table->is_initialized) return 0;
+    return table->num_shards;
+}
+
+ccol_epoch_t *ccol_concurrent_hash_table_epoch(const ccol_concurrent_hash_table_t *table) {
+    if (!table || !table->is_initialized) return NULL;
+    return table->epoch;
+}
+
+// Cleanup
+// Shards are cleared one at a time; inserts racing with a clear may survive it
+ccol_status_t ccol_concurrent_hash_table_clear(ccol_concurrent_hash_table_t *table) {
+    CCOL_CHECK_INIT(table);
+
+    ccol_status_t result = CCOL_STATUS_OK;
+    for (size_t i = 0; i < table->num_shards; i++) {
+        ccol__concurrent_shard_t *shard = &table->shards[i];
+        if (ccol__rwlock_wrlock(&shard->lock) != 0) {
+            result = CCOL_STATUS_ERROR;
+            continue;
+        }
+
+        ccol_status_t status = table->mode == CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY
+            ? ccol__read_mostly_clear(table, shard)
+            : ccol_hash_table_clear(shard->table);
+        ccol__rwlock_wrunlock(&shard->lock);
+        if (status != CCOL_STATUS_OK && result == CCOL_STATUS_OK) result = status;
+    }
+
+    return result;
+}
+
+// Not thread-safe: no other thread may use the table once destroy starts
+ccol_status_t ccol_concurrent_hash_table_destroy(ccol_concurrent_hash_table_t *table) {
+    CCOL_CHECK_INIT(table);
+
+    ccol__concurrent_hash_table_uninit(table);
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_concurrent_hash_table_free(ccol_concurrent_hash_table_t **table_ptr) {
+    if (!table_ptr || !*table_ptr || !(*table_ptr)->is_initialized) return CCOL_STATUS_INVALID_ARG;
+
+    ccol_status_t status = ccol_concurrent_hash_table_destroy(*table_ptr);
+
+    free(*table_ptr);
+    *table_ptr = NULL;
+
+    return status;
+}
@@ -0,0 +1,54 @@
+/*
+ * ccol/src/concurrent_hash_table/internal.c
+ *
+ * Sharded concurrent hash table internal function implementations.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L  // pthread rwlocks under -std=c99
+#endif
+
+#include <stdlib.h>
+
+#include "ccol/ccol_concurrent_hash_table.h"
+#include "ccol/ccol_hash_table.h"
+#include "ccol/ccol_epoch.h"
+
+#include "internal.h"
+#include "internal_rwlock.h"
+#include "read_mostly.h"
+
+// Tears down the first num_shards shards; also cleans up after a partial init
+void ccol__concurrent_hash_table_uninit(ccol_concurrent_hash_table_t *table) {
+    if (!table || !table->is_initialized) return;
+
+    for (size_t i = 0; i < table->num_shards; i++) {
+        ccol__concurrent_shard_t *shard = &table->shards[i];
+        if (shard->table) ccol_hash_table_free(&shard->table);
+        ccol__read_mostly_uninit(table, shard);
+        ccol__rwlock_destroy(&shard->lock);
+    }
+    free(table->shards);
+
+    // After the shards: their teardown may still hand the freer entries the epoch owned
+    if (table->epoch) ccol_epoch_free(&table->epoch);
+
+    table->shards = NULL;
+    table->num_shards = 0;
+    table->shard_shift = 0;
+    table->key_size = 0;
+    table->engine = CCOL_HASH_TABLE_CHAINED;
+    table->mode = CCOL_CONCURRENT_HASH_TABLE_LOCKED;
+
+    table->min_buckets = 0;
+    table->freer = (ccol_free_t){0};
+    table->comparator = (ccol_comparator_t){0};
+
+    table->hasher = (ccol_hash_t){0};
+    table->hash_key = (ccol_hash_key_t){0};
+
+    table->is_initialized = false;
+}
@@ -0,0 +1,44 @@
+/*
+ * ccol/src/concurrent_hash_table/internal.h
+ *
+ * Internal definitions for the sharded concurrent hash table.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#ifndef CCOL_CONCURRENT_HASH_TABLE_INTERNAL_H
+#define CCOL_CONCURRENT_HASH_TABLE_INTERNAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ccol/ccol_concurrent_hash_table.h"
+#include "ccol/ccol_hash_table.h"
+
+#include "internal_rwlock.h"
+#include "internal_fibonacci.h"
+#include "read_mostly.h"
+
+#define CCOL__CACHE_LINE_SIZE 64
+
+typedef struct ccol__concurrent_shard {
+    ccol__rwlock_t lock;  // CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY: writers only
+
+    ccol_hash_table_t *table;  // CCOL_CONCURRENT_HASH_TABLE_LOCKED
+
+    // CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY; both are stored atomically for lock-free readers
+    ccol__read_mostly_buckets_t *buckets;
+    size_t size;
+
+    char pad[CCOL__CACHE_LINE_SIZE];  // keeps neighbouring shards' locks off each other's cache lines
+} ccol__concurrent_shard_t;
+
+// The top log2(num_shards) bits of the mixed hash; the shard count is a power of two
+static inline ccol__concurrent_shard_t *ccol__concurrent_shard_for(const ccol_concurrent_hash_table_t *table, uint32_t hash) {
+    return &table->shards[(size_t)((uint64_t)ccol__fibonacci_mix(hash) >> table->shard_shift)];
+}
+
+void ccol__concurrent_hash_table_uninit(ccol_concurrent_hash_table_t *table);
+
+#endif  // CCOL_CONCURRENT_HASH_TABLE_INTERNAL_H
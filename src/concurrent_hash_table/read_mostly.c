@@ -0,0 +1,263 @@
+/*
+ * ccol/src/concurrent_hash_table/read_mostly.c
+ *
+ * Lock-free-read shard implementation.
+ *
+ * Insert links a fully initialized node at the head of its chain with one
+ * release store; remove unlinks with one release store and retires the node.
+ * A reader therefore always sees a well-formed chain, old or new. Resize
+ * copies the nodes into a fresh bucket array, publishes it with a single
+ * pointer swap and retires the old array as a whole, so readers that are
+ * still walking it keep a consistent (if momentarily stale) snapshot.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L  // pthread rwlocks under -std=c99
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "ccol/ccol_concurrent_hash_table.h"
+#include "ccol/ccol_hash_table.h"
+#include "ccol/ccol_epoch.h"
+#include "ccol/ccol_hash.h"
+#include "ccol/ccol_status.h"
+
+#include "internal.h"
+#include "read_mostly.h"
+#include "internal_atomic.h"
+
+// Private
+static ccol__read_mostly_buckets_t *ccol__read_mostly_buckets_create(size_t num_buckets) {
+    if (num_buckets > (SIZE_MAX - sizeof(ccol__read_mostly_buckets_t)) / sizeof(ccol__read_mostly_node_t *)) return NULL;
+
+    ccol__read_mostly_buckets_t *buckets = calloc(1, sizeof(ccol__read_mostly_buckets_t) + num_buckets * sizeof(ccol__read_mostly_node_t *));
+    if (!buckets) return NULL;
+
+    buckets->num_buckets = num_buckets;
+    return buckets;
+}
+
+static void ccol__read_mostly_node_free(ccol__read_mostly_node_t *node) {
+    ccol__read_mostly_slab_t *slab = node->slab;
+    if (!slab) {
+        free(node);
+        return;
+    }
+
+    // Slab nodes die from whichever thread runs the epoch's free functions
+    if (CCOL__ATOMIC_FETCH_SUB(&slab->live, (size_t)1) == 1) free(slab);
+}
+
+// Epoch free function for a whole bucket array and the nodes still linked from it.
+// ctx is the table when the entries die with the nodes, NULL when a resize copied them.
+static void ccol__read_mostly_buckets_release(void *ptr, void *ctx) {
+    ccol__read_mostly_buckets_t *buckets = (ccol__read_mostly_buckets_t *)ptr;
+    const ccol_concurrent_hash_table_t *table = (const ccol_concurrent_hash_table_t *)ctx;
+
+    for (size_t i = 0; i < buckets->num_buckets; i++) {
+        ccol__read_mostly_node_t *node = buckets->heads[i];
+        while (node) {
+            ccol__read_mostly_node_t *next = node->next;
+            if (table && table->freer.func) table->freer.func(&node->entry, table->freer.ctx);
+            ccol__read_mostly_node_free(node);
+            node = next;
+        }
+    }
+
+    free(buckets);
+}
+
+// Epoch free function for one removed node
+static void ccol__read_mostly_node_dispose(void *ptr, void *ctx) {
+    ccol__read_mostly_node_t *node = (ccol__read_mostly_node_t *)ptr;
+    const ccol_concurrent_hash_table_t *table = (const ccol_concurrent_hash_table_t *)ctx;
+
+    if (table->freer.func) table->freer.func(&node->entry, table->freer.ctx);
+    ccol__read_mostly_node_free(node);
+}
+
+// Hands ptr to the epoch; if that can't allocate, waits out the readers and frees in place
+static void ccol__read_mostly_retire(ccol_epoch_t *epoch, void *ptr, ccol_epoch_free_func_t free_func, void *ctx) {
+    if (ccol_epoch_retire(epoch, ptr, free_func, ctx) == CCOL_STATUS_OK) return;
+
+    ccol_epoch_synchronize(epoch);
+    free_func(ptr, ctx);
+}
+
+static ccol_hash_entry_t *ccol__read_mostly_find(
+    const ccol_concurrent_hash_table_t *table,
+    ccol__read_mostly_buckets_t *buckets,
+    const void *key,
+    uint32_t hash
+) {
+    ccol__read_mostly_node_t *node = CCOL__ATOMIC_LOAD_ACQUIRE(&buckets->heads[hash & (buckets->num_buckets - 1)]);
+    for (; node; node = CCOL__ATOMIC_LOAD_ACQUIRE(&node->next)) {
+        if (node->entry.hash != hash) continue;
+        if (table->comparator.func(&node->entry, key, table->comparator.ctx) == 0) return &node->entry;
+    }
+
+    return NULL;
+}
+
+// Best effort: on allocation failure the shard keeps its current array
+static void ccol__read_mostly_resize(ccol_concurrent_hash_table_t *table, ccol__concurrent_shard_t *shard, size_t num_buckets) {
+    ccol__read_mostly_buckets_t *old = shard->buckets;
+    size_t count = shard->size;  // exact: the caller holds the shard lock
+    if (count > (SIZE_MAX - sizeof(ccol__read_mostly_slab_t)) / sizeof(ccol__read_mostly_node_t)) return;
+
+    ccol__read_mostly_buckets_t *fresh = ccol__read_mostly_buckets_create(num_buckets);
+    ccol__read_mostly_slab_t *slab = count ? malloc(sizeof(ccol__read_mostly_slab_t) + count * sizeof(ccol__read_mostly_node_t)) : NULL;
+    if (!fresh || (count && !slab)) {
+        free(fresh);
+        free(slab);
+        return;
+    }
+
+    // Readers may still be walking the old chains, so the nodes are copied rather than relinked.
+    // fresh and slab are private until published, so plain stores suffice while filling them.
+    size_t n = 0;
+    for (size_t i = 0; i < old->num_buckets; i++) {
+        for (ccol__read_mostly_node_t *node = old->heads[i]; node; node = node->next) {
+            ccol__read_mostly_node_t *copy = &slab->nodes[n++];
+            size_t index = node->entry.hash & (num_buckets - 1);
+            copy->entry = node->entry;
+            copy->slab = slab;
+            copy->next = fresh->heads[index];
+            fresh->heads[index] = copy;
+        }
+    }
+    if (slab) slab->live = n;
+
+    CCOL__ATOMIC_STORE_RELEASE(&shard->buckets, fresh);
+    ccol__read_mostly_retire(table->epoch, old, ccol__read_mostly_buckets_release, NULL);
+}
+
+static void ccol__read_mostly_auto_resize(ccol_concurrent_hash_table_t *table, ccol__concurrent_shard_t *shard) {
+    double size = (double)shard->size;
+    size_t num_buckets = shard->buckets->num_buckets;
+    size_t target = num_buckets;
+
+    if (size > CCOL_HASH_TABLE_DEFAULT_MAX_LOAD_FACTOR * (double)target) {
+        while (size > CCOL_HASH_TABLE_DEFAULT_MAX_LOAD_FACTOR * (double)target) {
+            if (target > SIZE_MAX / CCOL_HASH_TABLE_GROWTH_FACTOR) return;
+            target *= CCOL_HASH_TABLE_GROWTH_FACTOR;
+        }
+    } else if (size < CCOL_HASH_TABLE_DEFAULT_MIN_LOAD_FACTOR * (double)target) {
+        while (target / CCOL_HASH_TABLE_GROWTH_FACTOR >= table->min_buckets &&
+               size < CCOL_HASH_TABLE_DEFAULT_MIN_LOAD_FACTOR * (double)target) {
+            target /= CCOL_HASH_TABLE_GROWTH_FACTOR;
+        }
+    }
+
+    if (target != num_buckets) ccol__read_mostly_resize(table, shard, target);
+}
+
+// Public (internal to the library)
+ccol_status_t ccol__read_mostly_init(ccol__concurrent_shard_t *shard, size_t num_buckets) {
+    shard->buckets = ccol__read_mostly_buckets_create(num_buckets);
+    if (!shard->buckets) return CCOL_STATUS_ALLOC;
+
+    shard->size = 0;
+    return CCOL_STATUS_OK;
+}
+
+// No reader or writer may be running
+void ccol__read_mostly_uninit(const ccol_concurrent_hash_table_t *table, ccol__concurrent_shard_t *shard) {
+    if (!shard->buckets) return;
+
+    ccol__read_mostly_buckets_release(shard->buckets, (void *)table);
+    shard->buckets = NULL;
+    shard->size = 0;
+}
+
+ccol_status_t ccol__read_mostly_get(
+    const ccol_concurrent_hash_table_t *table,
+    ccol__concurrent_shard_t *shard,
+    const void *key,
+    uint32_t hash,
+    void **value_out
+) {
+    ccol_epoch_record_t *record = ccol_epoch_thread_record(table->epoch);
+    if (!record) return CCOL_STATUS_ALLOC;
+
+    ccol_epoch_enter(record);
+    ccol__read_mostly_buckets_t *buckets = CCOL__ATOMIC_LOAD_ACQUIRE(&shard->buckets);
+    ccol_hash_entry_t *entry = ccol__read_mostly_find(table, buckets, key, hash);
+    if (entry && value_out) *value_out = entry->value;
+    ccol_epoch_exit(record);
+
+    return entry ? CCOL_STATUS_OK : CCOL_STATUS_NOT_FOUND;
+}
+
+ccol_status_t ccol__read_mostly_insert(
+    ccol_concurrent_hash_table_t *table,
+    ccol__concurrent_shard_t *shard,
+    void *key,
+    void *value,
+    uint32_t hash
+) {
+    ccol__read_mostly_buckets_t *buckets = shard->buckets;
+    if (ccol__read_mostly_find(table, buckets, key, hash)) return CCOL_STATUS_ALREADY_EXISTS;
+
+    ccol__read_mostly_node_t *node = malloc(sizeof(ccol__read_mostly_node_t));
+    if (!node) return CCOL_STATUS_ALLOC;
+
+    node->slab = NULL;
+    node->entry.key = key;
+    node->entry.value = value;
+    node->entry.hash = hash;
+
+    // Fully built before the release store makes it reachable
+    ccol__read_mostly_node_t **head = &buckets->heads[hash & (buckets->num_buckets - 1)];
+    node->next = *head;
+    CCOL__ATOMIC_STORE_RELEASE(head, node);
+
+    CCOL__ATOMIC_STORE_RELAXED(&shard->size, shard->size + 1);
+    ccol__read_mostly_auto_resize(table, shard);
+
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol__read_mostly_remove(
+    ccol_concurrent_hash_table_t *table,
+    ccol__concurrent_shard_t *shard,
+    const void *key,
+    uint32_t hash
+) {
+    ccol__read_mostly_buckets_t *buckets = shard->buckets;
+    ccol__read_mostly_node_t **link = &buckets->heads[hash & (buckets->num_buckets - 1)];
+
+    for (ccol__read_mostly_node_t *node = *link; node; link = &node->next, node = *link) {
+        if (node->entry.hash != hash) continue;
+        if (table->comparator.func(&node->entry, key, table->comparator.ctx) != 0) continue;
+
+        // Readers already on node still follow its next link to the rest of the chain
+        CCOL__ATOMIC_STORE_RELEASE(link, node->next);
+        ccol__read_mostly_retire(table->epoch, node, ccol__read_mostly_node_dispose, table);
+
+        CCOL__ATOMIC_STORE_RELAXED(&shard->size, shard->size - 1);
+        ccol__read_mostly_auto_resize(table, shard);
+        return CCOL_STATUS_OK;
+    }
+
+    return CCOL_STATUS_NOT_FOUND;
+}
+
+ccol_status_t ccol__read_mostly_clear(ccol_concurrent_hash_table_t *table, ccol__concurrent_shard_t *shard) {
+    ccol__read_mostly_buckets_t *fresh = ccol__read_mostly_buckets_create(table->min_buckets);
+    if (!fresh) return CCOL_STATUS_ALLOC;
+
+    ccol__read_mostly_buckets_t *old = shard->buckets;
+    CCOL__ATOMIC_STORE_RELEASE(&shard->buckets, fresh);
+    CCOL__ATOMIC_STORE_RELAXED(&shard->size, (size_t)0);
+
+    ccol__read_mostly_retire(table->epoch, old, ccol__read_mostly_buckets_release, table);
+    return CCOL_STATUS_OK;
+}
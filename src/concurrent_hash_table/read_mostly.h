@@ -0,0 +1,74 @@
+/*
+ * ccol/src/concurrent_hash_table/read_mostly.h
+ *
+ * Lock-free-read shard layout for CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY.
+ *
+ * A shard is a chained table whose bucket heads and next links are only ever
+ * written with release stores, and whose bucket array is swapped as a whole
+ * on resize. Readers walk it inside an epoch critical section without taking
+ * any lock; writers serialize on the shard lock and hand everything they
+ * unlink to the table's epoch domain.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#ifndef CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY_H
+#define CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ccol/ccol_concurrent_hash_table.h"
+#include "ccol/ccol_hash.h"
+#include "ccol/ccol_status.h"
+
+typedef struct ccol__read_mostly_node {
+    struct ccol__read_mostly_node *next;
+    struct ccol__read_mostly_slab *slab;  // NULL when the node was allocated on its own
+    ccol_hash_entry_t entry;
+} ccol__read_mostly_node_t;
+
+// The copies one resize makes share a single allocation, freed once its last node dies
+typedef struct ccol__read_mostly_slab {
+    size_t live;
+    ccol__read_mostly_node_t nodes[];
+} ccol__read_mostly_slab_t;
+
+typedef struct ccol__read_mostly_buckets {
+    size_t num_buckets;  // power of two
+    ccol__read_mostly_node_t *heads[];
+} ccol__read_mostly_buckets_t;
+
+struct ccol__concurrent_shard;
+
+ccol_status_t ccol__read_mostly_init(struct ccol__concurrent_shard *shard, size_t num_buckets);
+void ccol__read_mostly_uninit(const ccol_concurrent_hash_table_t *table, struct ccol__concurrent_shard *shard);
+
+// Readers: take no lock, enter the table's epoch themselves
+ccol_status_t ccol__read_mostly_get(
+    const ccol_concurrent_hash_table_t *table,
+    struct ccol__concurrent_shard *shard,
+    const void *key,
+    uint32_t hash,
+    void **value_out
+);
+
+// Writers: the caller holds the shard lock
+ccol_status_t ccol__read_mostly_insert(
+    ccol_concurrent_hash_table_t *table,
+    struct ccol__concurrent_shard *shard,
+    void *key,
+    void *value,
+    uint32_t hash
+);
+ccol_status_t ccol__read_mostly_remove(
+    ccol_concurrent_hash_table_t *table,
+    struct ccol__concurrent_shard *shard,
+    const void *key,
+    uint32_t hash
+);
+ccol_status_t ccol__read_mostly_clear(ccol_concurrent_hash_table_t *table, struct ccol__concurrent_shard *shard);
+
+#endif  // CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY_H
@@ -0,0 +1,403 @@
+/*
+ * ccol/src/epoch/ccol_epoch.c
+ *
+ * Epoch-based reclamation implementation.
+ *
+ * Classic three-epoch scheme: a reader announces the global epoch it saw on
+ * entry; the epoch only advances once every active reader has announced the
+ * current one. An object retired in epoch e is unreachable for readers that
+ * entered after it was unlinked, so once the global epoch reaches e + 2 no
+ * reader can still hold it.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L  // pthread rwlocks under -std=c99
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "ccol/ccol_epoch.h"
+#include "ccol/ccol_status.h"
+
+#include "internal_atomic.h"
+#include "internal_rwlock.h"
+
+#define CCOL__EPOCH_TLS_SLOTS 8
+#define CCOL__EPOCH_CACHE_LINE_SIZE 64
+
+struct ccol_epoch_record {
+    uint64_t state;  // (epoch << 1) | 1 inside a critical section, 0 outside
+    unsigned depth;  // nesting; only the owning thread touches it
+    unsigned owned;  // 1 while a thread holds the record: claimed by CAS, cleared on thread exit
+    ccol_epoch_t *epoch;
+    struct ccol_epoch_record *next;  // fixed once the record is published
+    void *block;  // the allocation the aligned record was carved from
+};
+
+// Each record gets whole cache lines of its own, so one reader never shares a line with another
+#define CCOL__EPOCH_RECORD_SPAN \
+    ((sizeof(ccol_epoch_record_t) + CCOL__EPOCH_CACHE_LINE_SIZE - 1) / CCOL__EPOCH_CACHE_LINE_SIZE * CCOL__EPOCH_CACHE_LINE_SIZE)
+
+typedef struct ccol__epoch_retired {
+    struct ccol__epoch_retired *next;
+    void *ptr;
+    ccol_epoch_free_func_t free_func;
+    void *ctx;
+    uint64_t epoch;
+} ccol__epoch_retired_t;
+
+struct ccol_epoch {
+    uint64_t global;
+    uint64_t id;  // never reused, so a stale thread-local cache entry can't match a new domain
+
+    ccol_epoch_record_t *records;  // push-only until the domain is freed; records are reused, not unlinked
+    struct ccol_epoch *live_next;  // registry of live domains, consulted on thread exit
+
+    ccol__rwlock_t lock;  // guards the retired list; only writers take it
+    ccol__epoch_retired_t *retired;
+    size_t pending;
+};
+
+typedef struct ccol__epoch_tls {
+    uint64_t id;
+    ccol_epoch_record_t *record;
+} ccol__epoch_tls_t;
+
+static uint64_t ccol__epoch_next_id = 1;
+
+static ccol__rwlock_t ccol__epoch_registry_lock = CCOL__RWLOCK_INITIALIZER;
+static ccol_epoch_t *ccol__epoch_registry;
+
+// Per-thread record cache; an evicted record goes back to its domain for reuse
+static CCOL__THREAD_LOCAL ccol__epoch_tls_t ccol__epoch_tls[CCOL__EPOCH_TLS_SLOTS];
+static CCOL__THREAD_LOCAL unsigned ccol__epoch_tls_victim;
+static CCOL__THREAD_LOCAL bool ccol__epoch_exit_armed;
+
+#if defined(_WIN32)
+static INIT_ONCE ccol__epoch_exit_once = INIT_ONCE_STATIC_INIT;
+static DWORD ccol__epoch_exit_key = FLS_OUT_OF_INDEXES;
+#else
+static pthread_once_t ccol__epoch_exit_once = PTHREAD_ONCE_INIT;
+static pthread_key_t ccol__epoch_exit_key;
+static bool ccol__epoch_exit_key_created;
+#endif
+
+// Private
+// Empties a cache slot, handing its record back if the domain is live and no section is open.
+// Returns false, leaving the slot alone, when the record is still inside a section.
+// Caller holds the registry lock so the domain cannot be freed underneath
+static bool ccol__epoch_release_slot(ccol__epoch_tls_t *slot) {
+    for (ccol_epoch_t *epoch = ccol__epoch_registry; epoch; epoch = epoch->live_next) {
+        if (epoch->id != slot->id) continue;
+        if (slot->record->depth != 0) return false;
+        CCOL__ATOMIC_STORE_RELEASE(&slot->record->owned, 0u);
+        break;
+    }
+    slot->id = 0;
+    slot->record = NULL;
+    return true;
+}
+
+// Thread exit: hands the cached records of still-live domains back for other threads to claim
+static void ccol__epoch_thread_exit(void *tls) {
+    ccol__epoch_tls_t *slots = (ccol__epoch_tls_t *)tls;
+    if (ccol__rwlock_rdlock(&ccol__epoch_registry_lock) != 0) return;
+
+    for (unsigned i = 0; i < CCOL__EPOCH_TLS_SLOTS; i++) {
+        if (slots[i].id == 0) continue;
+        // A thread that exits inside a section keeps its record; it is stuck either way
+        if (!ccol__epoch_release_slot(&slots[i])) {
+            slots[i].id = 0;
+            slots[i].record = NULL;
+        }
+    }
+
+    ccol__rwlock_rdunlock(&ccol__epoch_registry_lock);
+}
+
+// Picks a cache slot for a new record: a free one, else the next victim that can be released.
+// Only when every cached record is inside a section does the victim stay owned
+static unsigned ccol__epoch_take_slot(void) {
+    for (unsigned i = 0; i < CCOL__EPOCH_TLS_SLOTS; i++) {
+        if (ccol__epoch_tls[i].id == 0) return i;
+    }
+
+    unsigned slot = ccol__epoch_tls_victim++ % CCOL__EPOCH_TLS_SLOTS;
+    if (ccol__rwlock_rdlock(&ccol__epoch_registry_lock) != 0) return slot;
+
+    for (unsigned n = 0; n < CCOL__EPOCH_TLS_SLOTS; n++) {
+        unsigned i = (slot + n) % CCOL__EPOCH_TLS_SLOTS;
+        if (ccol__epoch_release_slot(&ccol__epoch_tls[i])) {
+            slot = i;
+            break;
+        }
+    }
+
+    ccol__rwlock_rdunlock(&ccol__epoch_registry_lock);
+    return slot;
+}
+
+#if defined(_WIN32)
+static VOID WINAPI ccol__epoch_fls_callback(PVOID tls) {
+    if (tls) ccol__epoch_thread_exit(tls);
+}
+
+static BOOL CALLBACK ccol__epoch_exit_key_create(PINIT_ONCE once, PVOID param, PVOID *ctx) {
+    (void)once;
+    (void)param;
+    (void)ctx;
+    ccol__epoch_exit_key = FlsAlloc(ccol__epoch_fls_callback);
+    return TRUE;
+}
+
+// Best effort: without the hook the thread's records stay owned until their domains are freed
+static void ccol__epoch_arm_thread_exit(void) {
+    if (ccol__epoch_exit_armed) return;
+    if (!InitOnceExecuteOnce(&ccol__epoch_exit_once, ccol__epoch_exit_key_create, NULL, NULL)) return;
+    if (ccol__epoch_exit_key == FLS_OUT_OF_INDEXES) return;
+    ccol__epoch_exit_armed = FlsSetValue(ccol__epoch_exit_key, ccol__epoch_tls) != 0;
+}
+#else
+static void ccol__epoch_exit_key_create(void) {
+    ccol__epoch_exit_key_created = pthread_key_create(&ccol__epoch_exit_key, ccol__epoch_thread_exit) == 0;
+}
+
+// Best effort: without the hook the thread's records stay owned until their domains are freed
+static void ccol__epoch_arm_thread_exit(void) {
+    if (ccol__epoch_exit_armed) return;
+    if (pthread_once(&ccol__epoch_exit_once, ccol__epoch_exit_key_create) != 0 || !ccol__epoch_exit_key_created) return;
+    ccol__epoch_exit_armed = pthread_setspecific(ccol__epoch_exit_key, ccol__epoch_tls) == 0;
+}
+#endif
+
+// calloc only guarantees max_align_t, so the block is over-allocated and the record aligned inside it
+static ccol_epoch_record_t *ccol__epoch_record_create(ccol_epoch_t *epoch) {
+    void *block = calloc(1, CCOL__EPOCH_RECORD_SPAN + CCOL__EPOCH_CACHE_LINE_SIZE - 1);
+    if (!block) return NULL;
+
+    uintptr_t aligned = ((uintptr_t)block + CCOL__EPOCH_CACHE_LINE_SIZE - 1) & ~(uintptr_t)(CCOL__EPOCH_CACHE_LINE_SIZE - 1);
+    ccol_epoch_record_t *record = (ccol_epoch_record_t *)aligned;
+    record->block = block;
+    record->epoch = epoch;
+    record->owned = 1;
+
+    return record;
+}
+
+static bool ccol__epoch_try_advance(ccol_epoch_t *epoch) {
+    uint64_t global = CCOL__ATOMIC_LOAD_SEQ_CST(&epoch->global);
+
+    ccol_epoch_record_t *record = CCOL__ATOMIC_LOAD_ACQUIRE(&epoch->records);
+    for (; record; record = record->next) {
+        uint64_t state = CCOL__ATOMIC_LOAD_SEQ_CST(&record->state);
+        if ((state & 1) && (state >> 1) != global) return false;
+    }
+
+    return CCOL__ATOMIC_CAS(&epoch->global, &global, global + 1);
+}
+
+static size_t ccol__epoch_run(ccol__epoch_retired_t *retired) {
+    size_t count = 0;
+    while (retired) {
+        ccol__epoch_retired_t *next = retired->next;
+        retired->free_func(retired->ptr, retired->ctx);
+        free(retired);
+        retired = next;
+        count++;
+    }
+    return count;
+}
+
+// Public
+ccol_status_t ccol_epoch_create(ccol_epoch_t **epoch_out) {
+    if (!epoch_out) return CCOL_STATUS_INVALID_ARG;
+
+    *epoch_out = NULL;
+
+    ccol_epoch_t *epoch = calloc(1, sizeof(ccol_epoch_t));
+    if (!epoch) return CCOL_STATUS_ALLOC;
+
+    if (ccol__rwlock_init(&epoch->lock) != 0) {
+        free(epoch);
+        return CCOL_STATUS_ERROR;
+    }
+
+    epoch->id = CCOL__ATOMIC_FETCH_ADD(&ccol__epoch_next_id, 1);
+
+    if (ccol__rwlock_wrlock(&ccol__epoch_registry_lock) != 0) {
+        ccol__rwlock_destroy(&epoch->lock);
+        free(epoch);
+        return CCOL_STATUS_ERROR;
+    }
+    epoch->live_next = ccol__epoch_registry;
+    ccol__epoch_registry = epoch;
+    ccol__rwlock_wrunlock(&ccol__epoch_registry_lock);
+
+    *epoch_out = epoch;
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_epoch_free(ccol_epoch_t **epoch_ptr) {
+    if (!epoch_ptr || !*epoch_ptr) return CCOL_STATUS_INVALID_ARG;
+    ccol_epoch_t *epoch = *epoch_ptr;
+
+    // Once unregistered, an exiting thread no longer touches this domain's records
+    if (ccol__rwlock_wrlock(&ccol__epoch_registry_lock) != 0) return CCOL_STATUS_ERROR;
+    ccol_epoch_t **link = &ccol__epoch_registry;
+    while (*link != epoch) link = &(*link)->live_next;
+    *link = epoch->live_next;
+    ccol__rwlock_wrunlock(&ccol__epoch_registry_lock);
+
+    ccol__epoch_run(epoch->retired);
+
+    ccol_epoch_record_t *record = epoch->records;
+    while (record) {
+        ccol_epoch_record_t *next = record->next;
+        free(record->block);
+        record = next;
+    }
+
+    ccol__rwlock_destroy(&epoch->lock);
+    free(epoch);
+    *epoch_ptr = NULL;
+
+    return CCOL_STATUS_OK;
+}
+
+ccol_epoch_record_t *ccol_epoch_thread_record(ccol_epoch_t *epoch) {
+    if (!epoch) return NULL;
+
+    for (unsigned i = 0; i < CCOL__EPOCH_TLS_SLOTS; i++) {
+        if (ccol__epoch_tls[i].id == epoch->id) return ccol__epoch_tls[i].record;
+    }
+
+    // Claim a record released by an exited thread before registering a new one
+    ccol_epoch_record_t *record = CCOL__ATOMIC_LOAD_ACQUIRE(&epoch->records);
+    for (; record; record = record->next) {
+        unsigned idle = 0;
+        if (CCOL__ATOMIC_LOAD_RELAXED(&record->owned) == 0 && CCOL__ATOMIC_CAS(&record->owned, &idle, 1u)) break;
+    }
+
+    if (!record) {
+        record = ccol__epoch_record_create(epoch);
+        if (!record) return NULL;
+
+        record->next = CCOL__ATOMIC_LOAD_ACQUIRE(&epoch->records);
+        while (!CCOL__ATOMIC_CAS(&epoch->records, &record->next, record)) {}
+    }
+
+    ccol__epoch_arm_thread_exit();
+
+    unsigned slot = ccol__epoch_take_slot();
+    ccol__epoch_tls[slot].id = epoch->id;
+    ccol__epoch_tls[slot].record = record;
+
+    return record;
+}
+
+void ccol_epoch_enter(ccol_epoch_record_t *record) {
+    if (record->depth++ > 0) return;
+
+    // Announce, then confirm the epoch didn't move meanwhile: a stale announcement
+    // could otherwise let the epoch run two steps past this reader. The sequentially
+    // consistent store also orders the announcement before every read the section makes.
+    uint64_t global = CCOL__ATOMIC_LOAD_SEQ_CST(&record->epoch->global);
+    for (;;) {
+        CCOL__ATOMIC_STORE_SEQ_CST(&record->state, (global << 1) | 1);
+        uint64_t current = CCOL__ATOMIC_LOAD_SEQ_CST(&record->epoch->global);
+        if (current == global) break;
+        global = current;
+    }
+}
+
+void ccol_epoch_exit(ccol_epoch_record_t *record) {
+    if (--record->depth > 0) return;
+    CCOL__ATOMIC_STORE_RELEASE(&record->state, (uint64_t)0);
+}
+
+ccol_status_t ccol_epoch_retire(ccol_epoch_t *epoch, void *ptr, ccol_epoch_free_func_t free_func, void *ctx) {
+    if (!epoch || !free_func) return CCOL_STATUS_INVALID_ARG;
+
+    ccol__epoch_retired_t *retired = malloc(sizeof(ccol__epoch_retired_t));
+    if (!retired) return CCOL_STATUS_ALLOC;
+
+    retired->ptr = ptr;
+    retired->free_func = free_func;
+    retired->ctx = ctx;
+
+    // The caller's unlink must be visible before the epoch is sampled, or a reader that
+    // entered after the sample could still find ptr
+    CCOL__ATOMIC_FENCE();
+    retired->epoch = CCOL__ATOMIC_LOAD_SEQ_CST(&epoch->global);
+
+    if (ccol__rwlock_wrlock(&epoch->lock) != 0) {
+        free(retired);
+        return CCOL_STATUS_ERROR;
+    }
+    retired->next = epoch->retired;
+    epoch->retired = retired;
+    size_t pending = ++epoch->pending;
+    ccol__rwlock_wrunlock(&epoch->lock);
+
+    if (pending >= CCOL_EPOCH_RECLAIM_THRESHOLD) ccol_epoch_reclaim(epoch);
+
+    return CCOL_STATUS_OK;
+}
+
+size_t ccol_epoch_reclaim(ccol_epoch_t *epoch) {
+    if (!epoch) return 0;
+    if (ccol__rwlock_wrlock(&epoch->lock) != 0) return 0;
+
+    // Two steps when no reader is in the way, so a quiet domain drains in one call
+    if (ccol__epoch_try_advance(epoch)) ccol__epoch_try_advance(epoch);
+    uint64_t global = CCOL__ATOMIC_LOAD_SEQ_CST(&epoch->global);
+
+    ccol__epoch_retired_t *ready = NULL;
+    ccol__epoch_retired_t **link = &epoch->retired;
+    while (*link) {
+        ccol__epoch_retired_t *retired = *link;
+        if (retired->epoch + 2 <= global) {
+            *link = retired->next;
+            retired->next = ready;
+            ready = retired;
+            epoch->pending--;
+        } else {
+            link = &retired->next;
+        }
+    }
+    ccol__rwlock_wrunlock(&epoch->lock);
+
+    // Free functions run outside the lock so they may retire more objects
+    return ccol__epoch_run(ready);
+}
+
+void ccol_epoch_synchronize(ccol_epoch_t *epoch) {
+    if (!epoch) return;
+
+    // Two advances past the current epoch outlast every section open right now
+    CCOL__ATOMIC_FENCE();
+    uint64_t target = CCOL__ATOMIC_LOAD_SEQ_CST(&epoch->global) + 2;
+
+    while (CCOL__ATOMIC_LOAD_SEQ_CST(&epoch->global) < target) {
+        bool advanced = false;
+        if (ccol__rwlock_wrlock(&epoch->lock) == 0) {
+            advanced = ccol__epoch_try_advance(epoch);
+            ccol__rwlock_wrunlock(&epoch->lock);
+        }
+        if (!advanced) ccol__thread_yield();
+    }
+}
+
+size_t ccol_epoch_pending(ccol_epoch_t *epoch) {
+    if (!epoch) return 0;
+    if (ccol__rwlock_wrlock(&epoch->lock) != 0) return 0;
+    size_t pending = epoch->pending;
+    ccol__rwlock_wrunlock(&epoch->lock);
+    return pending;
+}
@@ -0,0 +1,416 @@
+/*
+ * ccol/src/frozen_table/ccol_frozen_table.c
+ *
+ * Frozen hash table implementation.
+ *
+ * Freezing rehashes every key's bytes with a seeded built-in hash, so the
+ * file never depends on the source table's hasher (function pointers,
+ * per-process SECURE keys) and any process can probe it. Slots are placed
+ * Robin Hood style, which lets a lookup stop at the first slot whose
+ * resident sits closer to home than the probe.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L  // mmap/fstat under -std=c99
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "ccol/ccol_frozen_table.h"
+#include "ccol/ccol_hash_table.h"
+#include "ccol/ccol_macros.h"
+#include "ccol/ccol_status.h"
+
+#include "internal.h"
+#include "hash_table/internal.h"
+#include "robust.h"
+
+// Private
+static size_t ccol__frozen_max_load(size_t num_slots) {
+    size_t reserve = num_slots / 10;
+    return num_slots - (reserve > 0 ? reserve : 1);
+}
+
+// Gathers every entry of any engine, including buckets an incremental rehash hasn't moved yet
+static ccol_status_t ccol__frozen_collect(const ccol_hash_table_t *hash_table, const ccol_hash_entry_t **entries) {
+    size_t count = 0;
+
+    for (size_t i = 0; ccol__hash_table_is_open(hash_table) && i < hash_table->num_buckets; i++) {
+        ccol_hash_entry_t *entry = ccol__hash_table_slot_entry(hash_table, i);
+        if (entry) entries[count++] = entry;
+    }
+
+    for (size_t i = 0; !ccol__hash_table_is_open(hash_table) && i < ccol__hash_table_total_buckets(hash_table); i++) {
+        ccol_dll_t *bucket = ccol__hash_table_bucket_at(hash_table, i);
+        if (!bucket) continue;
+
+        ccol_dll_node_t *node = bucket->head;
+        for (size_t j = 0; j < bucket->size; j++, node = node->next) {
+            entries[count++] = (const ccol_hash_entry_t *)node->data;
+        }
+    }
+
+    return count == hash_table->size ? CCOL_STATUS_OK : CCOL_STATUS_ERROR;
+}
+
+// Robin Hood placement of entry indices; false if some run outgrows a distance byte
+static bool ccol__frozen_place_all(
+    const uint32_t *entry_hashes,
+    size_t count,
+    size_t num_slots,
+    uint8_t *ctrl,
+    size_t *slot_entry
+) {
+    memset(ctrl, 0, num_slots);
+    size_t mask = num_slots - 1;
+
+    for (size_t e = 0; e < count; e++) {
+        size_t carried = e;
+        size_t index = ccol__frozen_home(entry_hashes[e], num_slots);
+
+        for (unsigned distance = 0; ; distance++, index = (index + 1) & mask) {
+            if (distance > CCOL__FROZEN_MAX_DISTANCE) return false;
+
+            if (ctrl[index] == 0) {
+                ctrl[index] = (uint8_t)(distance + 1);
+                slot_entry[index] = carried;
+                break;
+            }
+
+            if (ctrl[index] - 1u < distance) {
+                size_t resident = slot_entry[index];
+                unsigned resident_distance = ctrl[index] - 1u;
+                slot_entry[index] = carried;
+                ctrl[index] = (uint8_t)(distance + 1);
+                carried = resident;
+                distance = resident_distance;
+            }
+        }
+    }
+
+    return true;
+}
+
+// position tracks the bytes written so far, so offsets never pass through a long (32-bit on LLP64)
+static bool ccol__frozen_write_at(FILE *file, uint64_t *position, uint64_t offset, const void *data, size_t len) {
+    if (*position > offset) return false;
+
+    // Zero padding up to the section start
+    static const unsigned char zeros[8] = {0};
+    while (*position < offset) {
+        size_t pad = offset - *position < sizeof(zeros) ? (size_t)(offset - *position) : sizeof(zeros);
+        if (fwrite(zeros, 1, pad, file) != pad) return false;
+        *position += pad;
+    }
+
+    if (len > 0 && fwrite(data, 1, len, file) != len) return false;
+    *position += len;
+    return true;
+}
+
+static ccol_status_t ccol__frozen_write(
+    const char *path,
+    const ccol__frozen_header_t *header,
+    const uint8_t *ctrl,
+    const uint32_t *hashes,
+    const size_t *slot_entry,
+    const ccol_hash_entry_t **entries
+) {
+    unsigned char *record = calloc(1, (size_t)header->record_size);
+    if (!record) return CCOL_STATUS_ALLOC;
+
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        free(record);
+        return CCOL_STATUS_ERROR;
+    }
+
+    size_t num_slots = (size_t)header->num_slots;
+    uint64_t position = 0;
+    bool ok = ccol__frozen_write_at(file, &position, 0, header, sizeof(*header)) &&
+              ccol__frozen_write_at(file, &position, header->ctrl_offset, ctrl, num_slots) &&
+              ccol__frozen_write_at(file, &position, header->hashes_offset, hashes, num_slots * sizeof(uint32_t)) &&
+              ccol__frozen_write_at(file, &position, header->records_offset, NULL, 0);
+
+    for (size_t i = 0; ok && i < num_slots; i++) {
+        memset(record, 0, (size_t)header->record_size);
+        if (ctrl[i] != 0) {
+            const ccol_hash_entry_t *entry = entries[slot_entry[i]];
+            memcpy(record, entry->key, (size_t)header->key_size);
+            if (header->value_size > 0 && entry->value) {
+                memcpy(record + header->value_offset, entry->value, (size_t)header->value_size);
+            }
+        }
+        ok = fwrite(record, 1, (size_t)header->record_size, file) == header->record_size;
+    }
+
+    free(record);
+    if (fclose(file) != 0) ok = false;
+    if (!ok) {
+        remove(path);
+        return CCOL_STATUS_ERROR;
+    }
+
+    return CCOL_STATUS_OK;
+}
+
+// Checks the header against the mapped length; nothing past it is read until a lookup
+static bool ccol__frozen_header_valid(const ccol__frozen_header_t *header, size_t mapped_size) {
+    if (memcmp(header->magic, CCOL__FROZEN_MAGIC, sizeof(header->magic)) != 0) return false;
+    if (header->version != CCOL__FROZEN_VERSION || header->byte_order != CCOL__FROZEN_BYTE_ORDER) return false;
+    if (header->file_size != mapped_size) return false;
+
+    uint64_t num_slots = header->num_slots;
+    if (num_slots == 0 || num_slots > CCOL__FROZEN_MAX_SLOTS || (num_slots & (num_slots - 1)) != 0) return false;
+    if (header->size > num_slots || header->key_size == 0) return false;
+
+    // Record layout; each subtraction is preceded by the check that keeps it from wrapping
+    if (header->record_size == 0 || header->record_size % 8 != 0) return false;
+    if (header->value_offset < header->key_size || header->value_offset % 8 != 0) return false;
+    if (header->value_offset > header->record_size) return false;
+    if (header->value_size > header->record_size - header->value_offset) return false;
+
+    // Sections: in order, inside the mapping, each large enough for num_slots entries
+    if (header->ctrl_offset < sizeof(*header) || header->ctrl_offset > mapped_size) return false;
+    if (header->hashes_offset < header->ctrl_offset || header->hashes_offset > mapped_size) return false;
+    if (header->hashes_offset % 4 != 0 || header->hashes_offset - header->ctrl_offset < num_slots) return false;
+    if (header->records_offset < header->hashes_offset || header->records_offset > mapped_size) return false;
+    if (header->records_offset % 8 != 0) return false;
+    if ((header->records_offset - header->hashes_offset) / sizeof(uint32_t) < num_slots) return false;
+    if (num_slots > (mapped_size - header->records_offset) / header->record_size) return false;
+
+    return true;
+}
+
+static void ccol__frozen_unmap(ccol_frozen_table_t *table) {
+#if defined(_WIN32)
+    if (table->base) UnmapViewOfFile(table->base);
+    if (table->mapping) CloseHandle((HANDLE)table->mapping);
+#else
+    if (table->base) munmap((void *)table->base, table->mapped_size);
+#endif
+    *table = (ccol_frozen_table_t){0};
+}
+
+static ccol_status_t ccol__frozen_map(ccol_frozen_table_t *table, const char *path) {
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return CCOL_STATUS_ERROR;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || (uint64_t)size.QuadPart < sizeof(ccol__frozen_header_t) ||
+        (uint64_t)size.QuadPart > SIZE_MAX) {
+        CloseHandle(file);
+        return CCOL_STATUS_INVALID_ARG;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping) return CCOL_STATUS_ERROR;
+
+    void *base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!base) {
+        CloseHandle(mapping);
+        return CCOL_STATUS_ERROR;
+    }
+
+    table->mapping = mapping;
+    table->mapped_size = (size_t)size.QuadPart;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return CCOL_STATUS_ERROR;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(ccol__frozen_header_t) || (uint64_t)st.st_size > SIZE_MAX) {
+        close(fd);
+        return CCOL_STATUS_INVALID_ARG;
+    }
+
+    // The mapping outlives the descriptor
+    void *base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return CCOL_STATUS_ERROR;
+
+    table->mapped_size = (size_t)st.st_size;
+#endif
+
+    table->base = (const unsigned char *)base;
+    return CCOL_STATUS_OK;
+}
+
+static const unsigned char *ccol__frozen_find(const ccol_frozen_table_t *table, const void *key) {
+    uint32_t hash = ccol__hash_robust_block(key, table->key_size, table->seed);
+    size_t mask = table->num_slots - 1;
+    size_t index = ccol__frozen_home(hash, table->num_slots);
+
+    for (unsigned distance = 0; ; distance++, index = (index + 1) & mask) {
+        uint8_t ctrl = table->ctrl[index];
+        if (ctrl == 0 || ctrl - 1u < distance) return NULL;
+        if (table->hashes[index] != hash) continue;
+
+        const unsigned char *record = table->records + index * table->record_size;
+        if (memcmp(record, key, table->key_size) == 0) return record;
+    }
+}
+
+// Freeze
+ccol_status_t ccol_hash_table_freeze(const ccol_hash_table_t *hash_table, size_t value_size, const char *path) {
+    CCOL_CHECK_INIT(hash_table);
+    if (!path || hash_table->key_size == 0) return CCOL_STATUS_INVALID_ARG;
+
+    size_t count = hash_table->size;
+    size_t num_slots = 8;
+    while (ccol__frozen_max_load(num_slots) < count) {
+        if ((uint64_t)num_slots >= CCOL__FROZEN_MAX_SLOTS) return CCOL_STATUS_OVERFLOW;
+        num_slots *= 2;
+    }
+
+    uint64_t value_offset = ccol__frozen_align8(hash_table->key_size);
+    uint64_t record_size = ccol__frozen_align8(value_offset + value_size);
+    if (record_size < value_offset || num_slots > (SIZE_MAX - 64) / record_size) return CCOL_STATUS_OVERFLOW;
+
+    const ccol_hash_entry_t **entries = malloc((count > 0 ? count : 1) * sizeof(*entries));
+    uint32_t *entry_hashes = malloc((count > 0 ? count : 1) * sizeof(uint32_t));
+    uint32_t *hashes = calloc(num_slots, sizeof(uint32_t));
+    size_t *slot_entry = malloc(num_slots * sizeof(size_t));
+    uint8_t *ctrl = malloc(num_slots);
+
+    ccol_status_t status = CCOL_STATUS_ALLOC;
+    if (!entries || !entry_hashes || !hashes || !slot_entry || !ctrl) goto cleanup;
+
+    status = ccol__frozen_collect(hash_table, entries);
+    if (status != CCOL_STATUS_OK) goto cleanup;
+
+    // A fresh seed reshuffles every run, so a bad draw never forces a bigger file
+    uint64_t seed = 0;
+    status = CCOL_STATUS_FULL;
+    for (; seed < CCOL__FROZEN_SEED_ATTEMPTS; seed++) {
+        for (size_t e = 0; e < count; e++) {
+            entry_hashes[e] = ccol__hash_robust_block(entries[e]->key, hash_table->key_size, seed);
+        }
+        if (ccol__frozen_place_all(entry_hashes, count, num_slots, ctrl, slot_entry)) {
+            status = CCOL_STATUS_OK;
+            break;
+        }
+    }
+    if (status != CCOL_STATUS_OK) goto cleanup;
+
+    for (size_t i = 0; i < num_slots; i++) {
+        if (ctrl[i] != 0) hashes[i] = entry_hashes[slot_entry[i]];
+    }
+
+    ccol__frozen_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CCOL__FROZEN_MAGIC, sizeof(header.magic));
+    header.version = CCOL__FROZEN_VERSION;
+    header.byte_order = CCOL__FROZEN_BYTE_ORDER;
+    header.key_size = hash_table->key_size;
+    header.value_size = value_size;
+    header.value_offset = value_offset;
+    header.record_size = record_size;
+    header.num_slots = num_slots;
+    header.size = count;
+    header.seed = seed;
+    header.ctrl_offset = ccol__frozen_align8(sizeof(header));
+    header.hashes_offset = ccol__frozen_align8(header.ctrl_offset + num_slots);
+    header.records_offset = ccol__frozen_align8(header.hashes_offset + num_slots * sizeof(uint32_t));
+    header.file_size = header.records_offset + num_slots * record_size;
+
+    status = ccol__frozen_write(path, &header, ctrl, hashes, slot_entry, entries);
+
+cleanup:
+    free(entries);
+    free(entry_hashes);
+    free(hashes);
+    free(slot_entry);
+    free(ctrl);
+    return status;
+}
+
+// Open / Close
+ccol_status_t ccol_frozen_table_open(ccol_frozen_table_t *table, const char *path) {
+    if (!table || !path) return CCOL_STATUS_INVALID_ARG;
+
+    *table = (ccol_frozen_table_t){0};
+
+    ccol_status_t status = ccol__frozen_map(table, path);
+    if (status != CCOL_STATUS_OK) return status;
+
+    const ccol__frozen_header_t *header = (const ccol__frozen_header_t *)table->base;
+    if (!ccol__frozen_header_valid(header, table->mapped_size)) {
+        ccol__frozen_unmap(table);
+        return CCOL_STATUS_INVALID_ARG;
+    }
+
+    table->ctrl = table->base + header->ctrl_offset;
+    table->hashes = (const uint32_t *)(table->base + header->hashes_offset);
+    table->records = table->base + header->records_offset;
+
+    table->num_slots = (size_t)header->num_slots;
+    table->size = (size_t)header->size;
+    table->key_size = (size_t)header->key_size;
+    table->value_size = (size_t)header->value_size;
+    table->value_offset = (size_t)header->value_offset;
+    table->record_size = (size_t)header->record_size;
+    table->seed = header->seed;
+
+    table->is_initialized = true;
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_frozen_table_close(ccol_frozen_table_t *table) {
+    CCOL_CHECK_INIT(table);
+
+    ccol__frozen_unmap(table);
+    return CCOL_STATUS_OK;
+}
+
+// Access
+ccol_status_t ccol_frozen_table_get(const ccol_frozen_table_t *table, const void *key, const void **value_out) {
+    CCOL_CHECK_INIT(table);
+    if (!key) return CCOL_STATUS_INVALID_ARG;
+
+    const unsigned char *record = ccol__frozen_find(table, key);
+    if (!record) return CCOL_STATUS_NOT_FOUND;
+
+    if (value_out) *value_out = table->value_size > 0 ? record + table->value_offset : NULL;
+    return CCOL_STATUS_OK;
+}
+
+bool ccol_frozen_table_contains_key(const ccol_frozen_table_t *table, const void *key) {
+    if (!table || !table->is_initialized || !key) return false;
+    return ccol__frozen_find(table, key) != NULL;
+}
+
+// Attributes
+size_t ccol_frozen_table_size(const ccol_frozen_table_t *table) {
+    if (!table || !table->is_initialized) return 0;
+    return table->size;
+}
+
+size_t ccol_frozen_table_key_size(const ccol_frozen_table_t *table) {
+    if (!table || !table->is_initialized) return 0;
+    return table->key_size;
+}
+
+size_t ccol_frozen_table_value_size(const ccol_frozen_table_t *table) {
+    if (!table || !table->is_initialized) return 0;
+    return table->value_size;
+}
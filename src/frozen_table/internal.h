@@ -0,0 +1,61 @@
+/*
+ * ccol/src/frozen_table/internal.h
+ *
+ * Frozen table file format.
+ *
+ * [header][ctrl: num_slots bytes][hashes: num_slots x uint32][records: num_slots x record_size]
+ *
+ * Sections start on 8-byte boundaries and are located by the offsets in the
+ * header. Integers are stored in the writer's byte order; byte_order lets a
+ * reader on a different machine reject the file instead of misreading it.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#ifndef CCOL_FROZEN_TABLE_INTERNAL_H
+#define CCOL_FROZEN_TABLE_INTERNAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "internal_fibonacci.h"
+
+#define CCOL__FROZEN_MAGIC "CCOLFRZ1"
+#define CCOL__FROZEN_VERSION 1
+#define CCOL__FROZEN_BYTE_ORDER 0x01020304u
+
+#define CCOL__FROZEN_MAX_DISTANCE 254
+#define CCOL__FROZEN_SEED_ATTEMPTS 8
+#define CCOL__FROZEN_MAX_SLOTS ((uint64_t)1 << 32)
+
+typedef struct ccol__frozen_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+
+    uint64_t key_size;
+    uint64_t value_size;
+    uint64_t value_offset;
+    uint64_t record_size;
+
+    uint64_t num_slots;
+    uint64_t size;
+    uint64_t seed;
+
+    uint64_t ctrl_offset;
+    uint64_t hashes_offset;
+    uint64_t records_offset;
+    uint64_t file_size;
+} ccol__frozen_header_t;
+
+static inline uint64_t ccol__frozen_align8(uint64_t n) {
+    return (n + 7) & ~(uint64_t)7;
+}
+
+// Same slot mapping as the Robin Hood engine; part of the file format
+static inline size_t ccol__frozen_home(uint32_t hash, size_t num_slots) {
+    return ccol__fibonacci_home(hash, num_slots);
+}
+
+#endif  // CCOL_FROZEN_TABLE_INTERNAL_H
@@ -7,6 +7,21 @@
  * Copyright (C) 2025 Jack Einbinder
  */
 
+#ifdef _WIN32
+#define _CRT_RAND_S  // rand_s
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__linux__) && defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 25))
+#define CCOL__HAVE_GETRANDOM 1
+#include <errno.h>
+#include <sys/random.h>
+#endif
+
 #include "ccol/ccol_hash.h"
 #include "ccol/ccol_constants.h"
 #include "ccol/ccol_status.h"
@@ -15,7 +30,7 @@
 #include "robust.h"
 #include "secure.h"
 
-static ccol_status_t ccol_resolve_hash_func(
+ccol_status_t ccol_resolve_hash_func(
     size_t key_size,
     ccol_hash_policy_t policy,
     ccol_hash_func_t *hash_func_out
@@ -84,6 +99,45 @@ static ccol_status_t ccol_resolve_hash_func(
     return CCOL_STATUS_KEY_SIZE;
 }
 
+// Fills buf from the OS entropy source
+static ccol_status_t ccol__hash_random_bytes(void *buf, size_t len) {
+#if defined(CCOL__HAVE_GETRANDOM)
+    uint8_t *p = (uint8_t *)buf;
+    while (len > 0) {
+        ssize_t n = getrandom(p, len, 0);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return CCOL_STATUS_ERROR;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return CCOL_STATUS_OK;
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+    arc4random_buf(buf, len);
+    return CCOL_STATUS_OK;
+#elif defined(_WIN32)
+    uint8_t *p = (uint8_t *)buf;
+    for (size_t i = 0; i < len; i++) {
+        unsigned int r;
+        if (rand_s(&r) != 0) return CCOL_STATUS_ERROR;
+        p[i] = (uint8_t)r;
+    }
+    return CCOL_STATUS_OK;
+#else
+    FILE *urandom = fopen("/dev/urandom", "rb");
+    if (!urandom) return CCOL_STATUS_ERROR;
+    size_t n = fread(buf, 1, len, urandom);
+    fclose(urandom);
+    return n == len ? CCOL_STATUS_OK : CCOL_STATUS_ERROR;
+#endif
+}
+
+ccol_status_t ccol_hash_key_random(ccol_hash_key_t *key_out) {
+    if (!key_out) return CCOL_STATUS_INVALID_ARG;
+    return ccol__hash_random_bytes(key_out, sizeof(*key_out));
+}
+
 ccol_status_t ccol_hash_create_from_policy(
     size_t key_size,
     ccol_hash_policy_t policy,
@@ -3,17 +3,164 @@
  *
  * Robust hash function implementations.
  *
+ * wyhash-style multiply-fold hashing: every step is a 64x64->128 multiply
+ * whose halves are xor-folded, which mixes all input bits into the low
+ * bits the tables index with. Strings are consumed 16 bytes per round
+ * (48 with three independent lanes for long keys).
+ *
+ * ctx is an optional `const uint64_t *` seed (a ccol_hash_key_t works too;
+ * only k0 is read); NULL hashes with seed 0.
+ *
  * Created by Jack Einbinder
  * Copyright (C) 2025 Jack Einbinder
  */
 
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "robust.h"
 
-uint32_t ccol__hash_robust_uint8(const void *key, void *ctx);
-uint32_t ccol__hash_robust_uint16(const void *key, void *ctx);
-uint32_t ccol__hash_robust_uint32(const void *key, void *ctx);
-uint32_t ccol__hash_robust_uint64(const void *key, void *ctx);
-uint32_t ccol__hash_robust_str(const void *key, void *ctx);
-uint32_t ccol__hash_robust_ptr(const void *key, void *ctx);
+#define CCOL__ROBUST_P0 0x2d358dccaa6c78a5ULL
+#define CCOL__ROBUST_P1 0x8bb84b93962eacc9ULL
+#define CCOL__ROBUST_P2 0x4b33a62ed433d4a3ULL
+#define CCOL__ROBUST_P3 0x4d5a2da51de1aa47ULL
+
+// Private
+// CCOL_HASH_ROBUST_NO_INT128 forces the portable multiply, which must produce the same hashes
+static inline void ccol__robust_mum(uint64_t *a, uint64_t *b) {
+#if defined(__SIZEOF_INT128__) && !defined(CCOL_HASH_ROBUST_NO_INT128)
+    __uint128_t r = (__uint128_t)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32), c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static inline uint64_t ccol__robust_mix(uint64_t a, uint64_t b) {
+    ccol__robust_mum(&a, &b);
+    return a ^ b;
+}
+
+static inline uint64_t ccol__robust_read64(const uint8_t *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t ccol__robust_read32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// 1-3 bytes, branch-free: first, middle and last byte
+static inline uint64_t ccol__robust_read_small(const uint8_t *p, size_t len) {
+    return ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+}
+
+static inline uint64_t ccol__robust_seed(const void *ctx) {
+    return ctx ? *(const uint64_t *)ctx : 0;
+}
+
+static inline uint32_t ccol__robust_fold(uint64_t hash) {
+    return (uint32_t)(hash ^ (hash >> 32));
+}
+
+static uint32_t ccol__hash_robust_word(uint64_t x, size_t len, const void *ctx) {
+    uint64_t a = x ^ CCOL__ROBUST_P0;
+    uint64_t b = ccol__robust_seed(ctx) ^ len ^ CCOL__ROBUST_P1;
+    ccol__robust_mum(&a, &b);
+    return ccol__robust_fold(ccol__robust_mix(a ^ CCOL__ROBUST_P0, b ^ CCOL__ROBUST_P1));
+}
+
+static uint64_t ccol__hash_robust_bytes(const uint8_t *p, size_t len, uint64_t seed) {
+    seed ^= ccol__robust_mix(seed ^ CCOL__ROBUST_P0, CCOL__ROBUST_P1);
+
+    uint64_t a, b;
+    if (len <= 16) {
+        if (len >= 4) {
+            // Two overlapping 4-byte reads from each end cover 4..16 bytes
+            size_t mid = (len >> 3) << 2;
+            a = (ccol__robust_read32(p) << 32) | ccol__robust_read32(p + mid);
+            b = (ccol__robust_read32(p + len - 4) << 32) | ccol__robust_read32(p + len - 4 - mid);
+        } else if (len > 0) {
+            a = ccol__robust_read_small(p, len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        if (i > 48) {
+            uint64_t seed1 = seed, seed2 = seed;
+            do {
+                seed = ccol__robust_mix(ccol__robust_read64(p) ^ CCOL__ROBUST_P1, ccol__robust_read64(p + 8) ^ seed);
+                seed1 = ccol__robust_mix(ccol__robust_read64(p + 16) ^ CCOL__ROBUST_P2, ccol__robust_read64(p + 24) ^ seed1);
+                seed2 = ccol__robust_mix(ccol__robust_read64(p + 32) ^ CCOL__ROBUST_P3, ccol__robust_read64(p + 40) ^ seed2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= seed1 ^ seed2;
+        }
+
+        while (i > 16) {
+            seed = ccol__robust_mix(ccol__robust_read64(p) ^ CCOL__ROBUST_P1, ccol__robust_read64(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+
+        // The last 16 bytes, overlapping the previous round if needed
+        a = ccol__robust_read64(p + i - 16);
+        b = ccol__robust_read64(p + i - 8);
+    }
+
+    a ^= CCOL__ROBUST_P1;
+    b ^= seed;
+    ccol__robust_mum(&a, &b);
+    return ccol__robust_mix(a ^ CCOL__ROBUST_P0 ^ len, b ^ CCOL__ROBUST_P1);
+}
+
+// Public (internal to the library)
+uint32_t ccol__hash_robust_uint8(const void *key, void *ctx) {
+    return ccol__hash_robust_word(*(const uint8_t *)key, sizeof(uint8_t), ctx);
+}
+
+uint32_t ccol__hash_robust_uint16(const void *key, void *ctx) {
+    uint16_t x;
+    memcpy(&x, key, sizeof(x));
+    return ccol__hash_robust_word(x, sizeof(uint16_t), ctx);
+}
+
+uint32_t ccol__hash_robust_uint32(const void *key, void *ctx) {
+    uint32_t x;
+    memcpy(&x, key, sizeof(x));
+    return ccol__hash_robust_word(x, sizeof(uint32_t), ctx);
+}
+
+uint32_t ccol__hash_robust_uint64(const void *key, void *ctx) {
+    uint64_t x;
+    memcpy(&x, key, sizeof(x));
+    return ccol__hash_robust_word(x, sizeof(uint64_t), ctx);
+}
+
+uint32_t ccol__hash_robust_str(const void *key, void *ctx) {
+    const char *str = (const char *)key;
+    if (!str) return 0;
+    return ccol__robust_fold(ccol__hash_robust_bytes((const uint8_t *)str, strlen(str), ccol__robust_seed(ctx)));
+}
+
+uint32_t ccol__hash_robust_ptr(const void *key, void *ctx) {
+    return ccol__hash_robust_word((uint64_t)(uintptr_t)key, sizeof(void *), ctx);
+}
+
+uint32_t ccol__hash_robust_block(const void *data, size_t len, uint64_t seed) {
+    return ccol__robust_fold(ccol__hash_robust_bytes((const uint8_t *)data, len, seed));
+}
@@ -3,6 +3,8 @@
  *
  * Robust hash functions.
  *
+ * Fast, well-mixing non-cryptographic hashes. ctx may point to a uint64_t seed.
+ *
  * Created by Jack Einbinder
  * Copyright (C) 2025 Jack Einbinder
  */
@@ -10,6 +12,7 @@
 #ifndef CCOL_HASH_ROBUST_H
 #define CCOL_HASH_ROBUST_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 uint32_t ccol__hash_robust_uint8(const void *key, void *ctx);
@@ -19,4 +22,8 @@ uint32_t ccol__hash_robust_uint64(const void *key, void *ctx);
 uint32_t ccol__hash_robust_str(const void *key, void *ctx);
 uint32_t ccol__hash_robust_ptr(const void *key, void *ctx);
 
+// Explicit-length data and seed; stable across processes and builds, and equal to
+// ccol__hash_robust_str for a string and its strlen
+uint32_t ccol__hash_robust_block(const void *data, size_t len, uint64_t seed);
+
 #endif  // CCOL_HASH_ROBUST_H
@@ -3,17 +3,123 @@
  *
  * Secure hash function implementations.
  *
+ * Keyed SipHash-1-3 (one compression round per 8-byte word, three
+ * finalization rounds). Without the key an attacker cannot predict which
+ * keys collide, so a table cannot be forced into a single long chain.
+ *
+ * ctx must point to a ccol_hash_key_t; hash tables created with the
+ * SECURE policy and no ctx generate a random per-table key.
+ *
  * Created by Jack Einbinder
  * Copyright (C) 2025 Jack Einbinder
  */
 
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
+
+#include "ccol/ccol_hash.h"
 
 #include "secure.h"
 
-uint32_t ccol__hash_secure_uint8(const void *key, void *ctx);
-uint32_t ccol__hash_secure_uint16(const void *key, void *ctx);
-uint32_t ccol__hash_secure_uint32(const void *key, void *ctx);
-uint32_t ccol__hash_secure_uint64(const void *key, void *ctx);
-uint32_t ccol__hash_secure_str(const void *key, void *ctx);
-uint32_t ccol__hash_secure_ptr(const void *key, void *ctx);
+#define CCOL__SIPHASH_C_ROUNDS 1
+#define CCOL__SIPHASH_D_ROUNDS 3
+
+#define CCOL__SIPHASH_ROTL(x, b) (uint64_t)(((x) << (b)) | ((x) >> (64 - (b))))
+
+#define CCOL__SIPHASH_ROUND(v0, v1, v2, v3)                                 \
+    do {                                                                    \
+        v0 += v1; v1 = CCOL__SIPHASH_ROTL(v1, 13); v1 ^= v0;                \
+        v0 = CCOL__SIPHASH_ROTL(v0, 32);                                    \
+        v2 += v3; v3 = CCOL__SIPHASH_ROTL(v3, 16); v3 ^= v2;                \
+        v0 += v3; v3 = CCOL__SIPHASH_ROTL(v3, 21); v3 ^= v0;                \
+        v2 += v1; v1 = CCOL__SIPHASH_ROTL(v1, 17); v1 ^= v2;                \
+        v2 = CCOL__SIPHASH_ROTL(v2, 32);                                    \
+    } while (0)
+
+// Private
+static inline uint64_t ccol__siphash_read64_le(const uint8_t *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+static uint64_t ccol__siphash(const uint8_t *p, size_t len, const ccol_hash_key_t *key) {
+    uint64_t k0 = key ? key->k0 : 0;
+    uint64_t k1 = key ? key->k1 : 0;
+
+    uint64_t v0 = 0x736f6d6570736575ULL ^ k0;
+    uint64_t v1 = 0x646f72616e646f6dULL ^ k1;
+    uint64_t v2 = 0x6c7967656e657261ULL ^ k0;
+    uint64_t v3 = 0x7465646279746573ULL ^ k1;
+
+    const uint8_t *end = p + (len & ~(size_t)7);
+    for (; p != end; p += 8) {
+        uint64_t m = ccol__siphash_read64_le(p);
+        v3 ^= m;
+        for (int i = 0; i < CCOL__SIPHASH_C_ROUNDS; i++) CCOL__SIPHASH_ROUND(v0, v1, v2, v3);
+        v0 ^= m;
+    }
+
+    // Final word: trailing bytes plus the length in the top byte
+    uint64_t b = (uint64_t)len << 56;
+    switch (len & 7) {
+        case 7: b |= (uint64_t)p[6] << 48;  /* fall through */
+        case 6: b |= (uint64_t)p[5] << 40;  /* fall through */
+        case 5: b |= (uint64_t)p[4] << 32;  /* fall through */
+        case 4: b |= (uint64_t)p[3] << 24;  /* fall through */
+        case 3: b |= (uint64_t)p[2] << 16;  /* fall through */
+        case 2: b |= (uint64_t)p[1] << 8;   /* fall through */
+        case 1: b |= (uint64_t)p[0];        break;
+        default: break;
+    }
+
+    v3 ^= b;
+    for (int i = 0; i < CCOL__SIPHASH_C_ROUNDS; i++) CCOL__SIPHASH_ROUND(v0, v1, v2, v3);
+    v0 ^= b;
+
+    v2 ^= 0xff;
+    for (int i = 0; i < CCOL__SIPHASH_D_ROUNDS; i++) CCOL__SIPHASH_ROUND(v0, v1, v2, v3);
+
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+static inline uint32_t ccol__hash_secure_bytes(const void *data, size_t len, const void *ctx) {
+    uint64_t hash = ccol__siphash((const uint8_t *)data, len, (const ccol_hash_key_t *)ctx);
+    return (uint32_t)(hash ^ (hash >> 32));
+}
+
+// Public (internal to the library)
+uint32_t ccol__hash_secure_uint8(const void *key, void *ctx) {
+    return ccol__hash_secure_bytes(key, sizeof(uint8_t), ctx);
+}
+
+uint32_t ccol__hash_secure_uint16(const void *key, void *ctx) {
+    return ccol__hash_secure_bytes(key, sizeof(uint16_t), ctx);
+}
+
+uint32_t ccol__hash_secure_uint32(const void *key, void *ctx) {
+    return ccol__hash_secure_bytes(key, sizeof(uint32_t), ctx);
+}
+
+uint32_t ccol__hash_secure_uint64(const void *key, void *ctx) {
+    return ccol__hash_secure_bytes(key, sizeof(uint64_t), ctx);
+}
+
+uint32_t ccol__hash_secure_str(const void *key, void *ctx) {
+    const char *str = (const char *)key;
+    if (!str) return 0;
+    return ccol__hash_secure_bytes(str, strlen(str), ctx);
+}
+
+uint32_t ccol__hash_secure_ptr(const void *key, void *ctx) {
+    const uintptr_t ptr = (uintptr_t)key;
+    return ccol__hash_secure_bytes(&ptr, sizeof(ptr), ctx);
+}
+
+uint32_t ccol__hash_secure_block(const void *data, size_t len, const ccol_hash_key_t *key) {
+    return ccol__hash_secure_bytes(data, len, key);
+}
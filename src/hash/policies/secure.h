@@ -10,8 +10,11 @@
 #ifndef CCOL_HASH_SECURE_H
 #define CCOL_HASH_SECURE_H
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include "ccol/ccol_hash.h"
+
 uint32_t ccol__hash_secure_uint8(const void *key, void *ctx);
 uint32_t ccol__hash_secure_uint16(const void *key, void *ctx);
 uint32_t ccol__hash_secure_uint32(const void *key, void *ctx);
@@ -19,4 +22,7 @@ uint32_t ccol__hash_secure_uint64(const void *key, void *ctx);
 uint32_t ccol__hash_secure_str(const void *key, void *ctx);
 uint32_t ccol__hash_secure_ptr(const void *key, void *ctx);
 
+// Explicit-length data; equals ccol__hash_secure_str for a string and its strlen
+uint32_t ccol__hash_secure_block(const void *data, size_t len, const ccol_hash_key_t *key);
+
 #endif  // CCOL_HASH_SECURE_H
@@ -11,9 +11,11 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "ccol/ccol_hash.h"
 #include "ccol/ccol_hash_table.h"
+#include "ccol/ccol_hash_table_iterator.h"
 #include "ccol/ccol_dll.h"
 #include "ccol/ccol_comparator.h"
 #include "ccol/ccol_status.h"
@@ -21,6 +23,8 @@
 #include "ccol/ccol_macros.h"
 
 #include "internal.h"
+#include "engines/swiss.h"
+#include "engines/robin_hood.h"
 
 // Create / Initialize
 ccol_status_t ccol_hash_table_init(
@@ -33,6 +37,13 @@ ccol_status_t ccol_hash_table_init(
 ) {
     if (!hash_table) return CCOL_STATUS_INVALID_ARG;
 
+    // Secure hashing without a caller-supplied key gets a fresh random key per table
+    if (hasher.policy == CCOL_HASH_SECURE && !hasher.ctx) {
+        ccol_status_t status = ccol_hash_key_random(&hash_table->hash_key);
+        if (status != CCOL_STATUS_OK) return status;
+        hasher.ctx = &hash_table->hash_key;
+    }
+
     hash_table->hasher = hasher;
 
     hash_table->copier = copier;
@@ -40,11 +51,49 @@ ccol_status_t ccol_hash_table_init(
     hash_table->printer = printer;
     hash_table->comparator = comparator;
 
+    hash_table->max_load_factor = CCOL_HASH_TABLE_DEFAULT_MAX_LOAD_FACTOR;
+    hash_table->min_load_factor = CCOL_HASH_TABLE_DEFAULT_MIN_LOAD_FACTOR;
+    hash_table->num_threads = 0;
+    hash_table->counters = (ccol_hash_table_counters_t){0};
+
     hash_table->is_initialized = true;
 
     return CCOL_STATUS_OK;
 }
 
+ccol_status_t ccol_hash_table_init_with_engine(
+    ccol_hash_table_t *hash_table,
+    size_t num_buckets,
+    size_t key_size,
+    ccol_hash_table_engine_t engine,
+    ccol_hash_policy_t policy,
+    ccol_hash_t hasher,
+    ccol_copy_t copier,
+    ccol_free_t freer,
+    ccol_print_t printer,
+    ccol_comparator_t comparator
+) {
+    if (!hash_table || num_buckets < 1 || key_size < 1) return CCOL_STATUS_INVALID_ARG;
+    if (engine != CCOL_HASH_TABLE_CHAINED && engine != CCOL_HASH_TABLE_SWISS &&
+        engine != CCOL_HASH_TABLE_ROBIN_HOOD) return CCOL_STATUS_INVALID_ARG;
+	if (!comparator.func) return CCOL_STATUS_COMPARATOR_FUNC;
+    if (!hasher.func) return CCOL_STATUS_HASH_FUNC;
+
+    return ccol__hash_table_init_internal(
+        hash_table,
+        num_buckets,
+        key_size,
+        engine,
+        policy,
+        hasher.func,
+        hasher.ctx,
+        copier,
+        freer,
+        printer,
+        comparator
+    );
+}
+
 ccol_status_t ccol_hash_table_create(
     ccol_hash_table_t **hash_table_out,
     size_t num_buckets,
@@ -55,8 +104,36 @@ ccol_status_t ccol_hash_table_create(
     ccol_free_t freer,
     ccol_print_t printer,
     ccol_comparator_t comparator
+) {
+    return ccol_hash_table_create_with_engine(
+        hash_table_out,
+        num_buckets,
+        key_size,
+        CCOL_HASH_TABLE_CHAINED,
+        policy,
+        hasher,
+        copier,
+        freer,
+        printer,
+        comparator
+    );
+}
+
+ccol_status_t ccol_hash_table_create_with_engine(
+    ccol_hash_table_t **hash_table_out,
+    size_t num_buckets,
+    size_t key_size,
+    ccol_hash_table_engine_t engine,
+    ccol_hash_policy_t policy,
+    ccol_hash_t hasher,
+    ccol_copy_t copier,
+    ccol_free_t freer,
+    ccol_print_t printer,
+    ccol_comparator_t comparator
 ) {
     if (!hash_table_out || num_buckets < 1 || key_size < 1) return CCOL_STATUS_INVALID_ARG;
+    if (engine != CCOL_HASH_TABLE_CHAINED && engine != CCOL_HASH_TABLE_SWISS &&
+        engine != CCOL_HASH_TABLE_ROBIN_HOOD) return CCOL_STATUS_INVALID_ARG;
 	if (!comparator.func) return CCOL_STATUS_COMPARATOR_FUNC;
     if (!hasher.func) return CCOL_STATUS_HASH_FUNC;
 
@@ -66,6 +143,7 @@ ccol_status_t ccol_hash_table_create(
         hash_table_out,
     	num_buckets,
        	key_size,
+        engine,
         policy,
         hasher.func,
         hasher.ctx,
@@ -76,56 +154,103 @@ ccol_status_t ccol_hash_table_create(
    	);
 }
 
+ccol_status_t ccol_hash_table_build(
+    ccol_hash_table_t **hash_table_out,
+    size_t key_size,
+    ccol_hash_table_engine_t engine,
+    ccol_hash_policy_t policy,
+    ccol_hash_t hasher,
+    ccol_copy_t copier,
+    ccol_free_t freer,
+    ccol_print_t printer,
+    ccol_comparator_t comparator,
+    void *const *keys,
+    void *const *values,
+    size_t n,
+    bool keys_unique
+) {
+    if (!hash_table_out) return CCOL_STATUS_INVALID_ARG;
+    if (n > 0 && !keys) return CCOL_STATUS_INVALID_ARG;
+
+    ccol_status_t status = ccol_hash_table_create_with_engine(
+        hash_table_out,
+        CCOL__HASH_TABLE_BUILD_MIN_BUCKETS,
+        key_size,
+        engine,
+        policy,
+        hasher,
+        copier,
+        freer,
+        printer,
+        comparator
+    );
+    if (status != CCOL_STATUS_OK) return status;
+
+    status = ccol_hash_table_insert_bulk(*hash_table_out, keys, values, n, keys_unique);
+    if (status != CCOL_STATUS_OK && status != CCOL_STATUS_ALREADY_EXISTS) ccol_hash_table_free(hash_table_out);
+
+    return status;
+}
+
 // Insertion
 ccol_status_t ccol_hash_table_insert(ccol_hash_table_t *hash_table, void *key, void *data) {
     CCOL_CHECK_INIT(hash_table);
     if (!key) return CCOL_STATUS_INVALID_ARG;
 
-    size_t hash_key = hash_table->hasher.func(key, hash_table->hasher.ctx) % hash_table->num_buckets;
-    ccol_status_t status;
-    if (!(hash_table->buckets[hash_key])) {
-        status = ccol_dll_create(
-            &hash_table->buckets[hash_key],
-            hash_table->copier,
-            hash_table->freer,
-            hash_table->printer,
-            hash_table->comparator
-        );
-
-        if (status != CCOL_STATUS_OK) return status;
-    }
+    uint32_t hash = hash_table->hasher.func(key, hash_table->hasher.ctx);
+    return ccol__hash_table_insert_hashed(hash_table, key, data, hash);
+}
 
-    ccol_dll_node_t *duplicate = ccol_dll_search(hash_table->buckets[hash_key], key);
-    if (duplicate) return CCOL_STATUS_ALREADY_EXISTS;
+ccol_status_t ccol_hash_table_insert_bulk(
+    ccol_hash_table_t *hash_table,
+    void *const *keys,
+    void *const *values,
+    size_t n,
+    bool keys_unique
+) {
+    CCOL_CHECK_INIT(hash_table);
+    if (n == 0) return CCOL_STATUS_OK;
+    if (!keys) return CCOL_STATUS_INVALID_ARG;
 
-    ccol_hash_entry_t *entry = malloc(sizeof(ccol_hash_entry_t));
-    if (!entry) return CCOL_STATUS_ALLOC;
-    entry->key = key;
-    entry->value = data;
+    // Size for the whole batch up front so no insert below triggers a resize
+    ccol_status_t status = ccol__hash_table_reserve(hash_table, n);
+    if (status != CCOL_STATUS_OK) return status;
 
-    status = ccol_dll_push(hash_table->buckets[hash_key], entry);
-    if (status != CCOL_STATUS_OK) {
-        free(entry);
-        return status;
+    if (n > SIZE_MAX / sizeof(uint32_t)) return CCOL_STATUS_OVERFLOW;
+    uint32_t *hashes = malloc(n * sizeof(uint32_t));
+    if (!hashes) return CCOL_STATUS_ALLOC;
+
+    for (size_t i = 0; i < n; i++) hashes[i] = hash_table->hasher.func(keys[i], hash_table->hasher.ctx);
+
+    if (ccol__hash_table_is_open(hash_table)) {
+        bool swiss = hash_table->engine == CCOL_HASH_TABLE_SWISS;
+        size_t skipped = 0;
+        for (size_t i = 0; i < n && status == CCOL_STATUS_OK; i++) {
+            void *value = values ? values[i] : NULL;
+            status = swiss
+                ? ccol__swiss_insert_hashed(hash_table, keys[i], value, hashes[i], !keys_unique)
+                : ccol__robin_hood_insert_hashed(hash_table, keys[i], value, hashes[i], !keys_unique);
+            if (status == CCOL_STATUS_ALREADY_EXISTS) {
+                skipped++;
+                status = CCOL_STATUS_OK;
+            }
+        }
+        if (status == CCOL_STATUS_OK && skipped) status = CCOL_STATUS_ALREADY_EXISTS;
+    } else {
+        status = ccol__hash_table_insert_bulk_chained(hash_table, keys, values, hashes, n, keys_unique);
     }
 
-    hash_table->size++;
-    return CCOL_STATUS_OK;
+    free(hashes);
+    ccol__auto_resize(hash_table);
+    return status;
 }
 
 // Removal
 ccol_status_t ccol_hash_table_remove(ccol_hash_table_t *hash_table, void *key) {
     CCOL_CHECK_INIT(hash_table);
 
-    size_t hash_key = hash_table->hasher.func(key, hash_table->hasher.ctx) % hash_table->num_buckets;
-    ccol_dll_t *bucket = hash_table->buckets[hash_key];
-    if (!bucket) return CCOL_STATUS_NOT_FOUND;
-
-    ccol_status_t status = ccol_dll_remove(bucket, key);
-    if (status != CCOL_STATUS_OK) return status;
-
-    hash_table->size--;
-    return CCOL_STATUS_OK;
+    uint32_t hash = hash_table->hasher.func(key, hash_table->hasher.ctx);
+    return ccol__hash_table_remove_hashed(hash_table, key, hash);
 }
 
 // Access
@@ -135,12 +260,17 @@ ccol_status_t ccol_hash_table_get_node(
     ccol_dll_node_t **node_out
 ) {
     CCOL_CHECK_INIT(hash_table);
+    if (hash_table->engine != CCOL_HASH_TABLE_CHAINED) return CCOL_STATUS_INVALID_ARG;  // no chain nodes
+
+    // Migration moves nodes but never changes what the table holds
+    ccol__hash_table_rehash_step((ccol_hash_table_t *)hash_table);
+    CCOL__HASH_TABLE_COUNT(hash_table, lookups, 1);
 
-    size_t hash_key = hash_table->hasher.func(key, hash_table->hasher.ctx) % hash_table->num_buckets;
-    ccol_dll_t *bucket = hash_table->buckets[hash_key];
+    uint32_t hash = hash_table->hasher.func(key, hash_table->hasher.ctx);
+    ccol_dll_t *bucket = *ccol__hash_table_bucket_slot(hash_table, hash);
     if (!bucket) return CCOL_STATUS_NOT_FOUND;
 
-    ccol_dll_node_t *node = ccol_dll_search(bucket, key);
+    ccol_dll_node_t *node = ccol__hash_table_chain_find(hash_table, bucket, key, hash);
     if (!node) return CCOL_STATUS_NOT_FOUND;
 
     *node_out = node;
@@ -151,10 +281,9 @@ ccol_status_t ccol_hash_table_get_node(
 ccol_status_t ccol_hash_table_get(const ccol_hash_table_t *hash_table, const void *key, void **data_out) {
     CCOL_CHECK_INIT(hash_table);
 
-    ccol_dll_node_t *node = NULL;
-    ccol_status_t status = ccol_hash_table_get_node(hash_table, key, &node);
+    ccol_hash_entry_t *entry = NULL;
+    ccol_status_t status = ccol__hash_table_get_entry(hash_table, key, &entry);
     if (status != CCOL_STATUS_OK) return status;
-    ccol_hash_entry_t *entry = (ccol_hash_entry_t *)node->data;
     *data_out = entry->value;
 
     return CCOL_STATUS_OK;
@@ -173,17 +302,8 @@ ccol_status_t ccol_hash_table_get_all_keys(const ccol_hash_table_t *hash_table,
     if (!keys) return CCOL_STATUS_ALLOC;
 
     size_t keys_copied = 0;
-    for (size_t i = 0; i < hash_table->num_buckets; i++) {
-    	ccol_dll_t *bucket = hash_table->buckets[i];
-    	if (!bucket) continue;
-
-        ccol_dll_node_t *node = bucket->head;
-        for (size_t j = 0; j < bucket->size; j++) {
-        	ccol_hash_entry_t *entry = (ccol_hash_entry_t *)node->data;
-        	keys[keys_copied++] = entry->key;
-            node = node->next;
-        }
-    }
+    ccol_hash_table_cursor_t cursor = ccol_hash_table_cursor_begin(hash_table);
+    for (ccol_kv_pair_t *item; (item = ccol_hash_table_cursor_next(&cursor)) != NULL;) keys[keys_copied++] = item->key;
 
     *keys_out = keys;
     *key_count = keys_copied;
@@ -191,6 +311,36 @@ ccol_status_t ccol_hash_table_get_all_keys(const ccol_hash_table_t *hash_table,
     return CCOL_STATUS_OK;
 }
 
+ccol_status_t ccol_hash_table_get_many(
+    const ccol_hash_table_t *hash_table,
+    void *const *keys,
+    size_t n,
+    void **values_out,
+    uint64_t *found_mask
+) {
+    CCOL_CHECK_INIT(hash_table);
+    if (n == 0) return CCOL_STATUS_OK;
+    if (!keys || !values_out) return CCOL_STATUS_INVALID_ARG;
+
+    if (found_mask) memset(found_mask, 0, ((n + 63) / 64) * sizeof(uint64_t));
+
+    // One migration step per call, like a single lookup; the batch then sees a stable layout
+    if (hash_table->engine == CCOL_HASH_TABLE_CHAINED) ccol__hash_table_rehash_step((ccol_hash_table_t *)hash_table);
+
+    size_t found = 0;
+    bool hits[CCOL__HASH_TABLE_BATCH];
+    for (size_t base = 0; base < n; base += CCOL__HASH_TABLE_BATCH) {
+        size_t count = n - base < CCOL__HASH_TABLE_BATCH ? n - base : CCOL__HASH_TABLE_BATCH;
+        found += ccol__hash_table_get_batch(hash_table, keys + base, count, values_out + base, hits);
+
+        for (size_t i = 0; found_mask && i < count; i++) {
+            if (hits[i]) found_mask[(base + i) / 64] |= (uint64_t)1 << ((base + i) % 64);
+        }
+    }
+
+    return found == n ? CCOL_STATUS_OK : CCOL_STATUS_NOT_FOUND;
+}
+
 // Attributes
 bool ccol_hash_table_is_empty(const ccol_hash_table_t *hash_table) {
     return (!hash_table || !hash_table->is_initialized || hash_table->size == 0);
@@ -209,25 +359,34 @@ size_t ccol_hash_table_num_buckets(const ccol_hash_table_t *hash_table) {
 bool ccol_hash_table_contains_key(const ccol_hash_table_t *hash_table, const void *key) {
     if (!hash_table || !hash_table->is_initialized) return 0;
 
-    size_t hash_key = hash_table->hasher.func(key, hash_table->hasher.ctx) % hash_table->num_buckets;
-    ccol_dll_t *bucket = hash_table->buckets[hash_key];
+    CCOL__HASH_TABLE_COUNT(hash_table, lookups, 1);
+    if (hash_table->engine == CCOL_HASH_TABLE_SWISS) return ccol__swiss_find(hash_table, key) != NULL;
+    if (hash_table->engine == CCOL_HASH_TABLE_ROBIN_HOOD) return ccol__robin_hood_find(hash_table, key) != NULL;
+
+    ccol__hash_table_rehash_step((ccol_hash_table_t *)hash_table);
+
+    uint32_t hash = hash_table->hasher.func(key, hash_table->hasher.ctx);
+    ccol_dll_t *bucket = *ccol__hash_table_bucket_slot(hash_table, hash);
     if (!bucket) return false;
 
-    return ccol_dll_contains(bucket, key);
+    return ccol__hash_table_chain_find(hash_table, bucket, key, hash) != NULL;
 }
 
 bool ccol_hash_table_contains(const ccol_hash_table_t *hash_table, const void *key) {
     return ccol_hash_table_contains_key(hash_table, key);
 }
 
-bool ccol_hash_table_contains_value(const ccol_hash_table_t *hash_table, void *key, void *value) {
+// ctx is an optional ccol_comparator_t * for values; without it values are compared by address
+bool ccol_hash_table_contains_value(const ccol_hash_table_t *hash_table, void *value, void *ctx) {
     if (!hash_table || !hash_table->is_initialized) return 0;
 
-    size_t hash_key = hash_table->hasher.func(key, hash_table->hasher.ctx) % hash_table->num_buckets;
-    ccol_dll_t *bucket = hash_table->buckets[hash_key];
-    if (!bucket) return false;
+    const ccol_comparator_t *value_cmp = (const ccol_comparator_t *)ctx;
+    ccol_hash_table_cursor_t cursor = ccol_hash_table_cursor_begin(hash_table);
+    for (ccol_kv_pair_t *item; (item = ccol_hash_table_cursor_next(&cursor)) != NULL;) {
+        if (ccol__hash_table_value_equals(item->value, value, value_cmp)) return true;
+    }
 
-    return ccol_dll_contains(bucket, value);
+    return false;
 }
 
 double ccol_hash_table_load_factor(const ccol_hash_table_t *hash_table) {
@@ -235,6 +394,21 @@ double ccol_hash_table_load_factor(const ccol_hash_table_t *hash_table) {
     return (double) hash_table->size / (double) hash_table->num_buckets;
 }
 
+ccol_status_t ccol_hash_table_set_load_factors(ccol_hash_table_t *hash_table, double min_load_factor, double max_load_factor) {
+    CCOL_CHECK_INIT(hash_table);
+    if (min_load_factor < 0 || max_load_factor < 0) return CCOL_STATUS_INVALID_ARG;
+
+    // Keep a 2x gap so a shrink can never immediately trigger a grow (and vice versa)
+    if (min_load_factor > 0 && max_load_factor > 0 &&
+        min_load_factor * CCOL_HASH_TABLE_GROWTH_FACTOR >= max_load_factor) return CCOL_STATUS_INVALID_ARG;
+
+    hash_table->min_load_factor = min_load_factor;
+    hash_table->max_load_factor = max_load_factor;
+
+    ccol__auto_resize(hash_table);
+    return CCOL_STATUS_OK;
+}
+
 // Utilities
 ccol_status_t ccol_hash_table_swap(ccol_hash_table_t *hash_table, void *key1, void *key2) {
 	CCOL_CHECK_INIT(hash_table);
@@ -261,55 +435,43 @@ ccol_status_t ccol_hash_table_resize(ccol_hash_table_t *hash_table, int new_num_
 	CCOL_CHECK_INIT(hash_table);
     if (new_num_buckets <= 0) return CCOL_STATUS_INVALID_ARG;
 
-	ccol_dll_t **new_buckets = calloc(new_num_buckets, sizeof(ccol_dll_t *));
-	if (!new_buckets) return CCOL_STATUS_ALLOC;
+    return ccol__hash_table_rehash(hash_table, (size_t)new_num_buckets);
+}
 
-    ccol_hash_func_t hash_func = hash_table->hasher.func;
-    void *ctx = hash_table->hasher.ctx;
-	for (size_t i = 0; i < hash_table->num_buckets; i++) {
-		ccol_dll_t *bucket = hash_table->buckets[i];
-        if (!bucket) continue;
+ccol_status_t ccol_hash_table_set_incremental_rehash(ccol_hash_table_t *hash_table, size_t buckets_per_step) {
+    CCOL_CHECK_INIT(hash_table);
+    if (hash_table->engine != CCOL_HASH_TABLE_CHAINED) return CCOL_STATUS_INVALID_ARG;
 
-        ccol_status_t status;
-        ccol_dll_node_t *node = bucket->head;
-        for (size_t j = 0; j < bucket->size; j++) {
-         	ccol_hash_entry_t *entry = (ccol_hash_entry_t *)node->data;
-            size_t new_index = hash_func(entry->key, ctx) % new_num_buckets;
-            if (!new_buckets[new_index]) {
-            	status = ccol_dll_create(
-                    &new_buckets[new_index],
-                    hash_table->copier,
-                    hash_table->freer,
-                    hash_table->printer,
-                    hash_table->comparator
-                );
-                if (status != CCOL_STATUS_OK) return status;
-            }
+    hash_table->rehash_step = buckets_per_step;
+    if (buckets_per_step == 0) return ccol__hash_table_rehash_finish(hash_table);
 
-            ccol_dll_push_back(new_buckets[new_index], entry);
-            node = node->next;
-        }
-   }
-   for (size_t i = 0; i < hash_table->num_buckets; i++) {
-       if (hash_table->buckets[i]) {
-           ccol_dll_destroy(hash_table->buckets[i]);
-           free(hash_table->buckets[i]);
-           hash_table->buckets[i] = NULL;
-       }
-   }
-   free(hash_table->buckets);
+    return CCOL_STATUS_OK;
+}
 
-   hash_table->buckets = new_buckets;
-   hash_table->num_buckets = new_num_buckets;
+ccol_status_t ccol_hash_table_set_threads(ccol_hash_table_t *hash_table, size_t num_threads) {
+    CCOL_CHECK_INIT(hash_table);
 
-   hash_table->size = 0;
-   for (size_t i = 0; i < new_num_buckets; i++) {
-       if (hash_table->buckets[i]) {
-           hash_table->size += hash_table->buckets[i]->size;
-       }
-   }
+    hash_table->num_threads = num_threads;
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_hash_table_stats(const ccol_hash_table_t *hash_table, ccol_hash_table_stats_t *stats_out) {
+    CCOL_CHECK_INIT(hash_table);
+    if (!stats_out) return CCOL_STATUS_INVALID_ARG;
 
-   return CCOL_STATUS_OK;
+    return ccol__hash_table_collect_stats(hash_table, stats_out);
+}
+
+ccol_status_t ccol_hash_table_reset_counters(ccol_hash_table_t *hash_table) {
+    CCOL_CHECK_INIT(hash_table);
+
+    hash_table->counters = (ccol_hash_table_counters_t){0};
+    return CCOL_STATUS_OK;
+}
+
+bool ccol_hash_table_is_rehashing(const ccol_hash_table_t *hash_table) {
+    if (!hash_table || !hash_table->is_initialized) return false;
+    return hash_table->old_buckets != NULL;
 }
 
 // Copy / Clone
@@ -318,10 +480,15 @@ ccol_status_t ccol_hash_table_deep_clone(const ccol_hash_table_t *src, ccol_hash
     if (!hash_table_out) return CCOL_STATUS_INVALID_ARG;
     if (!src->copier.func) return CCOL_STATUS_COPY_FUNC;
 
-    ccol_status_t status = ccol_hash_table_create(
+    // Finishing a migration moves nodes but never changes what the table holds
+    ccol_status_t status = ccol__hash_table_rehash_finish((ccol_hash_table_t *)src);
+    if (status != CCOL_STATUS_OK) return status;
+
+    status = ccol_hash_table_create_with_engine(
         hash_table_out,
         src->num_buckets,
         src->key_size,
+        src->engine,
         src->hasher.policy,
         src->hasher,
         src->copier,
@@ -331,36 +498,37 @@ ccol_status_t ccol_hash_table_deep_clone(const ccol_hash_table_t *src, ccol_hash
     );
     if (status != CCOL_STATUS_OK) return status;
 
-    if (!src->buckets) return CCOL_STATUS_OK;
-
-    for (size_t i = 0; i < src->num_buckets; i++) {
-        if (!src->buckets[i]) continue;
+    ccol__hash_table_inherit_hasher(*hash_table_out, src);
+    (*hash_table_out)->max_load_factor = src->max_load_factor;
+    (*hash_table_out)->min_load_factor = src->min_load_factor;
+    (*hash_table_out)->min_buckets = src->min_buckets;
+    (*hash_table_out)->num_threads = src->num_threads;
 
-        status = ccol_dll_clone(src->buckets[i], &((*hash_table_out)->buckets[i]));
-        if (status != CCOL_STATUS_OK) {
-            ccol_hash_table_destroy(*hash_table_out);
-            return status;
-
-        }
-    }
+    status = ccol__hash_table_copy_entries(*hash_table_out, src, true);
 
-    return CCOL_STATUS_OK;
+    if (status != CCOL_STATUS_OK) ccol_hash_table_free(hash_table_out);
+    return status;
 }
 
 ccol_status_t ccol_hash_table_clone(const ccol_hash_table_t *src, ccol_hash_table_t **hash_table_out) {
     return ccol_hash_table_deep_clone(src, hash_table_out);
 }
 
+// Shares keys and values with src; each table still owns its own entries
 ccol_status_t ccol_hash_table_shallow_clone(const ccol_hash_table_t *src, ccol_hash_table_t **hash_table_out) {
     CCOL_CHECK_INIT(src);
     if (!hash_table_out) return CCOL_STATUS_INVALID_ARG;
 
     *hash_table_out = NULL;
 
-    ccol_status_t status = ccol_hash_table_create(
+    ccol_status_t status = ccol__hash_table_rehash_finish((ccol_hash_table_t *)src);
+    if (status != CCOL_STATUS_OK) return status;
+
+    status = ccol_hash_table_create_with_engine(
         hash_table_out,
         src->num_buckets,
         src->key_size,
+        src->engine,
         src->hasher.policy,
         src->hasher,
         src->copier,
@@ -370,28 +538,20 @@ ccol_status_t ccol_hash_table_shallow_clone(const ccol_hash_table_t *src, ccol_h
     );
     if (status != CCOL_STATUS_OK) return status;
 
-    for (size_t i = 0; i < src->num_buckets; i++) {
-        if (!src->buckets[i]) continue;
-
-        ccol_dll_t *bucket_clone = NULL;
-        status = ccol_dll_shallow_clone(src->buckets[i], &bucket_clone);
-        if (status != CCOL_STATUS_OK) {
-            ccol_hash_table_destroy(*hash_table_out);
-            *hash_table_out = NULL;
-            return status;
-        }
+    ccol__hash_table_inherit_hasher(*hash_table_out, src);
+    (*hash_table_out)->max_load_factor = src->max_load_factor;
+    (*hash_table_out)->min_load_factor = src->min_load_factor;
+    (*hash_table_out)->min_buckets = src->min_buckets;
+    (*hash_table_out)->num_threads = src->num_threads;
 
-        (*hash_table_out)->buckets[i] = bucket_clone;
-    }
+    status = ccol__hash_table_copy_entries(*hash_table_out, src, false);
 
-    (*hash_table_out)->size = 0;
-    for (size_t i = 0; i < src->num_buckets; i++) {
-        if ((*hash_table_out)->buckets[i]) {
-            (*hash_table_out)->size += (*hash_table_out)->buckets[i]->size;
-        }
+    if (status != CCOL_STATUS_OK) {
+        // The shared keys and values belong to src
+        (*hash_table_out)->freer = (ccol_free_t){0};
+        ccol_hash_table_free(hash_table_out);
     }
-
-    return CCOL_STATUS_OK;
+    return status;
 }
 
 ccol_status_t ccol_hash_table_deep_copy(ccol_hash_table_t *dest, const ccol_hash_table_t *src) {
@@ -401,80 +561,19 @@ ccol_status_t ccol_hash_table_deep_copy(ccol_hash_table_t *dest, const ccol_hash
 
     if (!src->copier.func) return CCOL_STATUS_COPY_FUNC;
 
-    dest->hasher = src->hasher;
+    ccol_status_t status = ccol__hash_table_rehash_finish((ccol_hash_table_t *)src);
+    if (status != CCOL_STATUS_OK) return status;
+
+    // Release dest's contents with its own freer before taking over src's attributes
+    ccol__hash_table_release_storage(dest);
+
+    ccol__hash_table_inherit_hasher(dest, src);
     dest->copier = src->copier;
     dest->freer = src->freer;
     dest->printer = src->printer;
     dest->comparator = src->comparator;
 
-    if (src->size == 0) {
-        for (size_t i = 0; i < dest->num_buckets; i++) {
-            if (dest->buckets[i]) {
-                ccol_dll_destroy(dest->buckets[i]);
-                dest->buckets[i] = NULL;
-            }
-        }
-        dest->size = 0;
-        return CCOL_STATUS_OK;
-    }
-
-    ccol_status_t status;
-    for (size_t i = 0; i < src->num_buckets; i++) {
-        if (!src->buckets[i]) continue;
-
-        if (!dest->buckets[i]) {
-            ccol_dll_t* dest_bucket = NULL;
-            status = ccol_dll_create(
-            	&dest_bucket,
-            	src->copier,
-            	src->freer,
-            	src->printer,
-            	src->comparator
-        	);
-
-            if (status != CCOL_STATUS_OK) {
-                ccol_hash_table_destroy(dest);
-                return status;
-            }
-
-            status = ccol_dll_copy(dest_bucket, src->buckets[i]);
-            if (status != CCOL_STATUS_OK) {
-                ccol_dll_destroy(dest_bucket);
-                ccol_hash_table_destroy(dest);
-                return status;
-            }
-
-            dest->buckets[i] = dest_bucket;
-        } else {
-            status = ccol_dll_clear(dest->buckets[i]);
-            if (status != CCOL_STATUS_OK) {
-                ccol_hash_table_destroy(dest);
-                return status;
-            }
-
-            status = ccol_dll_copy(dest->buckets[i], src->buckets[i]);
-            if (status != CCOL_STATUS_OK) {
-                ccol_hash_table_destroy(dest);
-                return status;
-            }
-        }
-    }
-
-    // Clear remaining dest buckets
-    for (size_t i = src->num_buckets; i < dest->num_buckets; i++) {
-        if (dest->buckets[i]) {
-            ccol_dll_destroy(dest->buckets[i]);
-            dest->buckets[i] = NULL;
-        }
-    }
-
-    // Recalculate dest size
-    dest->size = 0;
-    for (size_t i = 0; i < dest->num_buckets; i++) {
-        if (dest->buckets[i]) dest->size += dest->buckets[i]->size;
-    }
-
-    return CCOL_STATUS_OK;
+    return ccol__hash_table_copy_engine(dest, src, true);
 }
 
 ccol_status_t ccol_hash_table_copy(ccol_hash_table_t *dest, const ccol_hash_table_t *src) {
@@ -486,47 +585,18 @@ ccol_status_t ccol_hash_table_shallow_copy(ccol_hash_table_t *dest, const ccol_h
     CCOL_CHECK_INIT(src);
     if (dest == src) return CCOL_STATUS_OK;
 
-    dest->hasher = src->hasher;
+    ccol_status_t status = ccol__hash_table_rehash_finish((ccol_hash_table_t *)src);
+    if (status != CCOL_STATUS_OK) return status;
+
+    ccol__hash_table_release_storage(dest);
+
+    ccol__hash_table_inherit_hasher(dest, src);
     dest->copier = src->copier;
     dest->freer = src->freer;
     dest->printer = src->printer;
     dest->comparator = src->comparator;
 
-    ccol_status_t status;
-    for (size_t i = 0; i < dest->num_buckets; i++) {
-        if (dest->buckets[i]) {
-            ccol_dll_node_t *node = dest->buckets[i]->head;
-            for (size_t j = 0; j < dest->buckets[i]->size; j++) {
-                ccol_dll_node_t *next = node->next;
-                free(node);
-                node=next;
-            }
-            free(dest->buckets[i]);
-            dest->buckets[i] = NULL;
-        }
-    }
-
-    for (size_t i = 0; i < dest->num_buckets; i++) {
-        if (!src->buckets[i]) continue;
-
-        ccol_dll_t *bucket_clone = NULL;
-        status = ccol_dll_shallow_clone(src->buckets[i], &bucket_clone);
-        if (status != CCOL_STATUS_OK) {
-            ccol_hash_table_destroy(dest);
-            return status;
-        }
-
-        dest->buckets[i] = bucket_clone;
-    }
-
-    dest->size = 0;
-    for (size_t i = 0; i < dest->num_buckets; i++) {
-        if (dest->buckets[i]) {
-            dest->size += dest->buckets[i]->size;
-        }
-    }
-
-    return CCOL_STATUS_OK;
+    return ccol__hash_table_copy_engine(dest, src, false);
 }
 
 // Cleanup
@@ -535,25 +605,42 @@ ccol_status_t ccol_hash_table_clear_bucket(ccol_hash_table_t *hash_table, int bu
     if (bucket_index < 0 || bucket_index > ((int)hash_table->num_buckets - 1)) return CCOL_STATUS_OUT_OF_BOUNDS;
     if (hash_table->size == 0) return CCOL_STATUS_OK;
 
+    if (hash_table->engine == CCOL_HASH_TABLE_SWISS) return ccol__swiss_erase_at(hash_table, (size_t)bucket_index);
+    if (hash_table->engine == CCOL_HASH_TABLE_ROBIN_HOOD) return ccol__robin_hood_erase_at(hash_table, (size_t)bucket_index);
+
+    // Bucket indices refer to the live bucket array
+    ccol_status_t status = ccol__hash_table_rehash_finish(hash_table);
+    if (status != CCOL_STATUS_OK) return status;
+
     ccol_dll_t *bucket = hash_table->buckets[bucket_index];
     if (!bucket) return CCOL_STATUS_NOT_FOUND;
 
     hash_table->size -= ccol_dll_size(bucket);
+    ccol__hash_table_bucket_clear(hash_table, bucket);
 
-    ccol_status_t status = ccol_dll_clear(bucket);
-    return status;
+    return CCOL_STATUS_OK;
 }
 
 ccol_status_t ccol_hash_table_clear(ccol_hash_table_t *hash_table) {
     CCOL_CHECK_INIT(hash_table);
 
-    ccol_status_t final_status = CCOL_STATUS_OK;
-    for (size_t i = 0; i < hash_table->num_buckets; i++) {
-        ccol_status_t bucket_status = ccol_hash_table_clear_bucket(hash_table, i);
-        if (bucket_status != CCOL_STATUS_OK && final_status == CCOL_STATUS_OK) final_status = bucket_status;
+    // Only the freer calls are worth spreading out; the storage is then dropped without it
+    size_t num_threads = ccol__hash_table_threads(hash_table);
+    if (num_threads > 1 && hash_table->freer.func) {
+        ccol__hash_table_free_entries_parallel(hash_table, num_threads);
+
+        ccol_free_t freer = hash_table->freer;
+        hash_table->freer = (ccol_free_t){0};
+        ccol_status_t status = ccol_hash_table_clear(hash_table);
+        hash_table->freer = freer;
+        return status;
     }
 
-    return final_status;
+    if (hash_table->engine == CCOL_HASH_TABLE_SWISS) return ccol__swiss_clear(hash_table);
+    if (hash_table->engine == CCOL_HASH_TABLE_ROBIN_HOOD) return ccol__robin_hood_clear(hash_table);
+
+    ccol__hash_table_drop_chains(hash_table);
+    return CCOL_STATUS_OK;
 }
 
 ccol_status_t ccol_hash_table_destroy(ccol_hash_table_t *hash_table) {
@@ -585,8 +672,17 @@ ccol_status_t ccol_hash_table_print(ccol_hash_table_t *hash_table) {
     }
 
     ccol_status_t status = CCOL_STATUS_OK;
-    for (size_t i = 0; i < hash_table->num_buckets; i++) {
-    	ccol_dll_t *bucket = hash_table->buckets[i];
+    for (size_t i = 0; ccol__hash_table_is_open(hash_table) && i < hash_table->num_buckets; i++) {
+        ccol_hash_entry_t *entry = ccol__hash_table_slot_entry(hash_table, i);
+        if (!entry) continue;
+
+        printf("Slot[%zu]: ", i);
+        hash_table->printer.func(entry, hash_table->printer.ctx);
+        printf("\n");
+    }
+
+    for (size_t i = 0; hash_table->engine == CCOL_HASH_TABLE_CHAINED && i < ccol__hash_table_total_buckets(hash_table); i++) {
+    	ccol_dll_t *bucket = ccol__hash_table_bucket_at(hash_table, i);
         if (!bucket) continue;
 
         printf("Bucket[%zu]: ", i);
@@ -596,3 +692,27 @@ ccol_status_t ccol_hash_table_print(ccol_hash_table_t *hash_table) {
 
     return CCOL_STATUS_OK;
 }
+
+ccol_status_t ccol_hash_table_print_stats(const ccol_hash_table_t *hash_table) {
+    ccol_hash_table_stats_t stats;
+    ccol_status_t status = ccol_hash_table_stats(hash_table, &stats);
+    if (status != CCOL_STATUS_OK) return status;
+
+    printf("%s: %zu entries, %zu buckets (%.1f%% empty), %zu bytes\n",
+        ccol_hash_table_engine_to_string(hash_table->engine),
+        stats.size, stats.num_buckets, stats.empty_ratio * 100.0, stats.memory_bytes);
+    printf("Chains: max %zu, mean %.2f, p99 %zu; chi-square/df %.2f\n",
+        stats.max_chain, stats.mean_chain, stats.p99_chain, stats.chi_square);
+    printf("Counters: %llu lookups, %llu comparisons, %llu resizes\n",
+        (unsigned long long)stats.counters.lookups,
+        (unsigned long long)stats.counters.comparisons,
+        (unsigned long long)stats.counters.resizes);
+
+    for (size_t i = 0; i < CCOL_HASH_TABLE_STATS_HISTOGRAM_SIZE; i++) {
+        if (!stats.chain_histogram[i]) continue;
+        bool last = i == CCOL_HASH_TABLE_STATS_HISTOGRAM_SIZE - 1;
+        printf("Length[%zu%s]: %zu\n", i, last ? "+" : "", stats.chain_histogram[i]);
+    }
+
+    return CCOL_STATUS_OK;
+}
@@ -0,0 +1,368 @@
+/*
+ * ccol/src/hash_table/engines/robin_hood.c
+ *
+ * Robin Hood linear-probing hash table engine.
+ *
+ * Slots are inline ccol_hash_entry_t records next to a parallel array of
+ * one-byte probe distances. An insert that reaches a resident closer to
+ * its home slot than the newcomer is takes that slot and carries the
+ * resident on, which keeps every run sorted by distance: a lookup stops
+ * at the first slot whose resident is closer to home than the probe. A
+ * removal shifts the rest of its run back one slot instead of leaving a
+ * tombstone, so probe lengths never degrade with churn.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ccol/ccol_hash.h"
+#include "ccol/ccol_hash_table.h"
+#include "ccol/ccol_macros.h"
+#include "ccol/ccol_status.h"
+
+#include "robin_hood.h"
+#include "hash_table/internal.h"
+#include "internal_fibonacci.h"
+
+// Home slots come from 32 bits of hash, so more slots than that can't be told apart
+#define CCOL__ROBIN_HOOD_MAX_CAPACITY ((uint64_t)1 << 32)
+
+// Doublings tried when a run, not the load, is what ran out of room
+#define CCOL__ROBIN_HOOD_GROW_RETRIES 2
+
+// Private
+static inline size_t ccol__robin_hood_home(uint32_t hash, size_t capacity) {
+    return ccol__fibonacci_home(hash, capacity);
+}
+
+// Always leaves a slot empty
+static inline size_t ccol__robin_hood_max_load(size_t capacity) {
+    size_t reserve = capacity / 10;
+    return capacity - (reserve > 0 ? reserve : 1);
+}
+
+// Walks the displacement chain an insert would cause without moving anything
+static bool ccol__robin_hood_fits(const ccol_hash_table_t *hash_table, uint32_t hash) {
+    size_t mask = hash_table->num_buckets - 1;
+    size_t index = ccol__robin_hood_home(hash, hash_table->num_buckets);
+
+    for (unsigned distance = 0; distance <= CCOL__ROBIN_HOOD_MAX_DISTANCE; distance++) {
+        uint8_t ctrl = hash_table->ctrl[index];
+        if (ctrl == CCOL__ROBIN_HOOD_EMPTY) return true;
+        if (ctrl - 1u < distance) distance = ctrl - 1u;  // the displaced resident carries on
+        index = (index + 1) & mask;
+    }
+
+    return false;
+}
+
+// Callers check ccol__robin_hood_fits first
+static void ccol__robin_hood_place(ccol_hash_table_t *hash_table, ccol_hash_entry_t entry) {
+    size_t mask = hash_table->num_buckets - 1;
+    size_t index = ccol__robin_hood_home(entry.hash, hash_table->num_buckets);
+
+    for (unsigned distance = 0; ; distance++, index = (index + 1) & mask) {
+        uint8_t ctrl = hash_table->ctrl[index];
+        if (ctrl == CCOL__ROBIN_HOOD_EMPTY) {
+            hash_table->ctrl[index] = (uint8_t)(distance + 1);
+            hash_table->slots[index] = entry;
+            return;
+        }
+
+        if (ctrl - 1u < distance) {
+            ccol_hash_entry_t resident = hash_table->slots[index];
+            hash_table->slots[index] = entry;
+            hash_table->ctrl[index] = (uint8_t)(distance + 1);
+            entry = resident;
+            distance = ctrl - 1u;
+        }
+    }
+}
+
+static ccol_hash_entry_t *ccol__robin_hood_find_index(
+    const ccol_hash_table_t *hash_table,
+    const void *key,
+    uint32_t hash,
+    size_t *index_out
+) {
+    size_t mask = hash_table->num_buckets - 1;
+    size_t index = ccol__robin_hood_home(hash, hash_table->num_buckets);
+
+    for (unsigned distance = 0; ; distance++, index = (index + 1) & mask) {
+        uint8_t ctrl = hash_table->ctrl[index];
+
+        // A resident closer to its home than we are to ours means the key would have been here
+        if (ctrl == CCOL__ROBIN_HOOD_EMPTY || ctrl - 1u < distance) return NULL;
+
+        ccol_hash_entry_t *entry = &hash_table->slots[index];
+        if (entry->hash != hash) continue;
+        CCOL__HASH_TABLE_COUNT(hash_table, comparisons, 1);
+        if (hash_table->comparator.func(entry, key, hash_table->comparator.ctx) == 0) {
+            if (index_out) *index_out = index;
+            return entry;
+        }
+    }
+}
+
+static ccol_status_t ccol__robin_hood_alloc(size_t capacity, uint8_t **ctrl_out, ccol_hash_entry_t **slots_out) {
+    if (capacity > SIZE_MAX / sizeof(ccol_hash_entry_t)) return CCOL_STATUS_OVERFLOW;
+
+    uint8_t *ctrl = calloc(capacity, 1);
+    if (!ctrl) return CCOL_STATUS_ALLOC;
+
+    ccol_hash_entry_t *slots = malloc(capacity * sizeof(ccol_hash_entry_t));
+    if (!slots) {
+        free(ctrl);
+        return CCOL_STATUS_ALLOC;
+    }
+
+    *ctrl_out = ctrl;
+    *slots_out = slots;
+    return CCOL_STATUS_OK;
+}
+
+// Public (internal to the library)
+size_t ccol__robin_hood_capacity_for(size_t num_slots) {
+    size_t capacity = CCOL__ROBIN_HOOD_MIN_CAPACITY;
+    while (capacity < num_slots) {
+        if ((uint64_t)capacity >= CCOL__ROBIN_HOOD_MAX_CAPACITY) return 0;
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+ccol_status_t ccol__robin_hood_init(ccol_hash_table_t *hash_table, size_t capacity) {
+    if (!hash_table) return CCOL_STATUS_INVALID_ARG;
+
+    capacity = ccol__robin_hood_capacity_for(capacity);
+    if (capacity == 0) return CCOL_STATUS_OVERFLOW;
+
+    uint8_t *ctrl = NULL;
+    ccol_hash_entry_t *slots = NULL;
+    ccol_status_t status = ccol__robin_hood_alloc(capacity, &ctrl, &slots);
+    if (status != CCOL_STATUS_OK) return status;
+
+    hash_table->ctrl = ctrl;
+    hash_table->slots = slots;
+    hash_table->num_buckets = capacity;
+    hash_table->growth_left = ccol__robin_hood_max_load(capacity);
+
+    return CCOL_STATUS_OK;
+}
+
+void ccol__robin_hood_uninit(ccol_hash_table_t *hash_table) {
+    if (!hash_table) return;
+
+    free(hash_table->ctrl);
+    free(hash_table->slots);
+
+    hash_table->ctrl = NULL;
+    hash_table->slots = NULL;
+    hash_table->growth_left = 0;
+}
+
+// Leaves the table untouched unless every entry found a slot
+ccol_status_t ccol__robin_hood_resize(ccol_hash_table_t *hash_table, size_t capacity) {
+    if (!hash_table) return CCOL_STATUS_INVALID_ARG;
+
+    capacity = ccol__robin_hood_capacity_for(capacity);
+    if (capacity == 0) return CCOL_STATUS_OVERFLOW;
+    while (ccol__robin_hood_max_load(capacity) < hash_table->size) {
+        if ((uint64_t)capacity >= CCOL__ROBIN_HOOD_MAX_CAPACITY) return CCOL_STATUS_OVERFLOW;
+        capacity *= 2;
+    }
+
+    uint8_t *old_ctrl = hash_table->ctrl;
+    ccol_hash_entry_t *old_slots = hash_table->slots;
+    size_t old_capacity = hash_table->num_buckets;
+
+    for (unsigned attempt = 0; ; attempt++) {
+        uint8_t *ctrl = NULL;
+        ccol_hash_entry_t *slots = NULL;
+        ccol_status_t status = ccol__robin_hood_alloc(capacity, &ctrl, &slots);
+        if (status != CCOL_STATUS_OK) return status;
+
+        hash_table->ctrl = ctrl;
+        hash_table->slots = slots;
+        hash_table->num_buckets = capacity;
+
+        size_t i = 0;
+        for (; i < old_capacity; i++) {
+            if (old_ctrl[i] == CCOL__ROBIN_HOOD_EMPTY) continue;
+            if (!ccol__robin_hood_fits(hash_table, old_slots[i].hash)) break;
+            ccol__robin_hood_place(hash_table, old_slots[i]);
+        }
+
+        if (i == old_capacity) {
+            hash_table->growth_left = ccol__robin_hood_max_load(capacity) - hash_table->size;
+            free(old_ctrl);
+            free(old_slots);
+            return CCOL_STATUS_OK;
+        }
+
+        free(ctrl);
+        free(slots);
+        hash_table->ctrl = old_ctrl;
+        hash_table->slots = old_slots;
+        hash_table->num_buckets = old_capacity;
+
+        // Keys whose hashes collide in full never spread out; stop doubling for them
+        if (attempt == CCOL__ROBIN_HOOD_GROW_RETRIES) return CCOL_STATUS_FULL;
+        if ((uint64_t)capacity >= CCOL__ROBIN_HOOD_MAX_CAPACITY) return CCOL_STATUS_OVERFLOW;
+        capacity *= 2;
+    }
+}
+
+ccol_status_t ccol__robin_hood_insert_hashed(
+    ccol_hash_table_t *hash_table,
+    void *key,
+    void *value,
+    uint32_t hash,
+    bool check_duplicate
+) {
+    if (check_duplicate && ccol__robin_hood_find_index(hash_table, key, hash, NULL)) return CCOL_STATUS_ALREADY_EXISTS;
+
+    for (unsigned grows = 0; hash_table->growth_left == 0 || !ccol__robin_hood_fits(hash_table, hash); ) {
+        // Growing for load is routine; growing only to break up one long run is bounded
+        if (hash_table->growth_left > 0 && grows++ == CCOL__ROBIN_HOOD_GROW_RETRIES) return CCOL_STATUS_FULL;
+
+        if ((uint64_t)hash_table->num_buckets >= CCOL__ROBIN_HOOD_MAX_CAPACITY) return CCOL_STATUS_OVERFLOW;
+        ccol_status_t status = ccol__robin_hood_resize(hash_table, hash_table->num_buckets * 2);
+        if (status != CCOL_STATUS_OK) return status;
+    }
+
+    ccol__robin_hood_place(hash_table, (ccol_hash_entry_t){ .key = key, .value = value, .hash = hash });
+    hash_table->growth_left--;
+    hash_table->size++;
+
+    return CCOL_STATUS_OK;
+}
+
+// Backward-shift deletion: the rest of the run moves one slot closer to home
+ccol_status_t ccol__robin_hood_erase_at(ccol_hash_table_t *hash_table, size_t index) {
+    if (index >= hash_table->num_buckets) return CCOL_STATUS_OUT_OF_BOUNDS;
+    if (hash_table->ctrl[index] == CCOL__ROBIN_HOOD_EMPTY) return CCOL_STATUS_NOT_FOUND;
+
+    if (hash_table->freer.func) hash_table->freer.func(&hash_table->slots[index], hash_table->freer.ctx);
+
+    size_t mask = hash_table->num_buckets - 1;
+    size_t next = (index + 1) & mask;
+    while (hash_table->ctrl[next] > 1) {
+        hash_table->slots[index] = hash_table->slots[next];
+        hash_table->ctrl[index] = (uint8_t)(hash_table->ctrl[next] - 1);
+        index = next;
+        next = (next + 1) & mask;
+    }
+    hash_table->ctrl[index] = CCOL__ROBIN_HOOD_EMPTY;
+
+    hash_table->growth_left++;
+    hash_table->size--;
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol__robin_hood_remove_hashed(ccol_hash_table_t *hash_table, const void *key, uint32_t hash) {
+    size_t index = 0;
+    if (!ccol__robin_hood_find_index(hash_table, key, hash, &index)) return CCOL_STATUS_NOT_FOUND;
+
+    return ccol__robin_hood_erase_at(hash_table, index);
+}
+
+ccol_hash_entry_t *ccol__robin_hood_find(const ccol_hash_table_t *hash_table, const void *key) {
+    uint32_t hash = hash_table->hasher.func(key, hash_table->hasher.ctx);
+    return ccol__robin_hood_find_index(hash_table, key, hash, NULL);
+}
+
+ccol_hash_entry_t *ccol__robin_hood_find_hashed(const ccol_hash_table_t *hash_table, const void *key, uint32_t hash) {
+    return ccol__robin_hood_find_index(hash_table, key, hash, NULL);
+}
+
+// Pulls in the home slot's distance byte and entry
+void ccol__robin_hood_prefetch(const ccol_hash_table_t *hash_table, uint32_t hash) {
+    size_t index = ccol__robin_hood_home(hash, hash_table->num_buckets);
+    CCOL_PREFETCH(hash_table->ctrl + index);
+    CCOL_PREFETCH(hash_table->slots + index);
+}
+
+ccol_hash_entry_t *ccol__robin_hood_entry_at(const ccol_hash_table_t *hash_table, size_t index) {
+    if (index >= hash_table->num_buckets || hash_table->ctrl[index] == CCOL__ROBIN_HOOD_EMPTY) return NULL;
+    return &hash_table->slots[index];
+}
+
+size_t ccol__robin_hood_home_slot(const ccol_hash_table_t *hash_table, uint32_t hash) {
+    return ccol__robin_hood_home(hash, hash_table->num_buckets);
+}
+
+// Slots a lookup visits to reach the slot's entry (1 = its home slot); 0 for a free slot
+size_t ccol__robin_hood_probe_length(const ccol_hash_table_t *hash_table, size_t index) {
+    return hash_table->ctrl[index];
+}
+
+ccol_status_t ccol__robin_hood_clear(ccol_hash_table_t *hash_table) {
+    if (hash_table->freer.func) {
+        for (size_t i = 0; i < hash_table->num_buckets; i++) {
+            if (hash_table->ctrl[i] == CCOL__ROBIN_HOOD_EMPTY) continue;
+            hash_table->freer.func(&hash_table->slots[i], hash_table->freer.ctx);
+        }
+    }
+
+    memset(hash_table->ctrl, CCOL__ROBIN_HOOD_EMPTY, hash_table->num_buckets);
+    hash_table->growth_left = ccol__robin_hood_max_load(hash_table->num_buckets);
+    hash_table->size = 0;
+
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol__robin_hood_clone_into(ccol_hash_table_t *dest, const ccol_hash_table_t *src, bool deep) {
+    if (!dest || !src) return CCOL_STATUS_INVALID_ARG;
+    if (deep && !src->copier.func) return CCOL_STATUS_COPY_FUNC;
+
+    ccol__robin_hood_uninit(dest);
+    ccol_status_t status = ccol__robin_hood_init(dest, src->num_buckets);
+    if (status != CCOL_STATUS_OK) return status;
+
+    // Same capacity and hasher, so every entry keeps its slot and distance
+    memcpy(dest->ctrl, src->ctrl, src->num_buckets);
+    memcpy(dest->slots, src->slots, src->num_buckets * sizeof(ccol_hash_entry_t));
+    dest->growth_left = src->growth_left;
+    dest->size = src->size;
+    if (!deep) return CCOL_STATUS_OK;
+
+    for (size_t i = 0; i < src->num_buckets; i++) {
+        if (src->ctrl[i] == CCOL__ROBIN_HOOD_EMPTY) continue;
+
+        ccol_hash_entry_t *entry_copy = src->copier.func(&src->slots[i], src->copier.ctx);
+        if (!entry_copy) {
+            // Release the copies made so far and leave dest empty rather than sharing src's data
+            for (size_t j = 0; j < i; j++) {
+                if (dest->ctrl[j] != CCOL__ROBIN_HOOD_EMPTY && dest->freer.func) {
+                    dest->freer.func(&dest->slots[j], dest->freer.ctx);
+                }
+            }
+            memset(dest->ctrl, CCOL__ROBIN_HOOD_EMPTY, dest->num_buckets);
+            dest->growth_left = ccol__robin_hood_max_load(dest->num_buckets);
+            dest->size = 0;
+            return CCOL_STATUS_COPY;
+        }
+
+        // Entries live inline, so the copier's heap entry is only a carrier
+        dest->slots[i] = *entry_copy;
+        dest->slots[i].hash = src->slots[i].hash;
+        free(entry_copy);
+    }
+
+    return CCOL_STATUS_OK;
+}
+
+// Longest probe any resident needed; 0 when empty
+size_t ccol__robin_hood_max_probe(const ccol_hash_table_t *hash_table) {
+    uint8_t longest = 0;
+    for (size_t i = 0; i < hash_table->num_buckets; i++) {
+        if (hash_table->ctrl[i] > longest) longest = hash_table->ctrl[i];
+    }
+    return longest;
+}
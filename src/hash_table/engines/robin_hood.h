@@ -0,0 +1,53 @@
+/*
+ * ccol/src/hash_table/engines/robin_hood.h
+ *
+ * Robin Hood linear-probing hash table engine.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#ifndef CCOL_HASH_TABLE_ROBIN_HOOD_H
+#define CCOL_HASH_TABLE_ROBIN_HOOD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ccol/ccol_hash.h"
+#include "ccol/ccol_hash_table.h"
+#include "ccol/ccol_status.h"
+
+#define CCOL__ROBIN_HOOD_MIN_CAPACITY 8
+
+// ctrl bytes: 0 is empty, otherwise probe distance + 1
+#define CCOL__ROBIN_HOOD_EMPTY ((uint8_t)0)
+#define CCOL__ROBIN_HOOD_MAX_DISTANCE 254
+
+ccol_status_t ccol__robin_hood_init(ccol_hash_table_t *hash_table, size_t capacity);
+void ccol__robin_hood_uninit(ccol_hash_table_t *hash_table);
+
+ccol_status_t ccol__robin_hood_insert_hashed(
+    ccol_hash_table_t *hash_table,
+    void *key,
+    void *value,
+    uint32_t hash,
+    bool check_duplicate
+);
+ccol_status_t ccol__robin_hood_remove_hashed(ccol_hash_table_t *hash_table, const void *key, uint32_t hash);
+ccol_hash_entry_t *ccol__robin_hood_find(const ccol_hash_table_t *hash_table, const void *key);
+ccol_hash_entry_t *ccol__robin_hood_find_hashed(const ccol_hash_table_t *hash_table, const void *key, uint32_t hash);
+void ccol__robin_hood_prefetch(const ccol_hash_table_t *hash_table, uint32_t hash);
+ccol_hash_entry_t *ccol__robin_hood_entry_at(const ccol_hash_table_t *hash_table, size_t index);
+size_t ccol__robin_hood_home_slot(const ccol_hash_table_t *hash_table, uint32_t hash);
+size_t ccol__robin_hood_probe_length(const ccol_hash_table_t *hash_table, size_t index);
+
+ccol_status_t ccol__robin_hood_resize(ccol_hash_table_t *hash_table, size_t capacity);
+ccol_status_t ccol__robin_hood_erase_at(ccol_hash_table_t *hash_table, size_t index);
+ccol_status_t ccol__robin_hood_clear(ccol_hash_table_t *hash_table);
+ccol_status_t ccol__robin_hood_clone_into(ccol_hash_table_t *dest, const ccol_hash_table_t *src, bool deep);
+
+size_t ccol__robin_hood_capacity_for(size_t num_slots);
+size_t ccol__robin_hood_max_probe(const ccol_hash_table_t *hash_table);
+
+#endif  // CCOL_HASH_TABLE_ROBIN_HOOD_H
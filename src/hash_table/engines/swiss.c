@@ -0,0 +1,482 @@
+/*
+ * ccol/src/hash_table/engines/swiss.c
+ *
+ * Open-addressing (SwissTable-style) hash table engine.
+ *
+ * Slots are stored inline in a flat ccol_hash_entry_t array next to a
+ * parallel array of one-byte control words. A control byte is EMPTY,
+ * DELETED, or holds 7 bits of the key's mixed hash (h2). Lookups scan
+ * a whole group of control bytes at once and only touch the slots whose
+ * h2 matches, so a probe usually costs a single cache miss.
+ *
+ * Tables whose keys are 4- or 8-byte integers compared with the stock
+ * integer comparators also keep each key inline, 8 per group; lookups
+ * match the probe key against the whole group with one SIMD compare and
+ * never call the comparator.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ccol/ccol_hash.h"
+#include "ccol/ccol_hash_table.h"
+#include "ccol/ccol_comparator.h"
+#include "ccol/ccol_macros.h"
+#include "ccol/ccol_status.h"
+
+#include "swiss.h"
+#include "hash_table/internal.h"
+#include "internal_simd.h"
+#include "internal_fibonacci.h"
+
+#define CCOL__SWISS_LSBS 0x0101010101010101ULL
+#define CCOL__SWISS_MSBS 0x8080808080808080ULL
+
+// Private
+static inline uint64_t ccol__swiss_group_load(const uint8_t *ctrl) {
+    uint64_t group;
+    memcpy(&group, ctrl, sizeof(group));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    group = __builtin_bswap64(group);
+#endif
+    return group;
+}
+
+// May report false positives on full slots; callers always confirm with the comparator.
+static inline uint64_t ccol__swiss_group_match(uint64_t group, uint8_t h2) {
+    uint64_t x = group ^ (CCOL__SWISS_LSBS * h2);
+    return (x - CCOL__SWISS_LSBS) & ~x & CCOL__SWISS_MSBS;
+}
+
+static inline uint64_t ccol__swiss_group_match_empty(uint64_t group) {
+    return group & ~(group << 6) & CCOL__SWISS_MSBS;
+}
+
+static inline uint64_t ccol__swiss_group_match_empty_or_deleted(uint64_t group) {
+    return group & ~(group << 7) & CCOL__SWISS_MSBS;
+}
+
+static inline size_t ccol__swiss_mask_first(uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctzll(mask) >> 3;
+#else
+    size_t index = 0;
+    while (!(mask & 0x80)) {
+        mask >>= 8;
+        index++;
+    }
+    return index;
+#endif
+}
+
+// Both halves come from the Fibonacci-mixed hash: raw SIMPLE hashes of sequential keys
+// differ only in their low bits and would otherwise pile into a handful of groups
+static inline uint8_t ccol__swiss_h2(uint32_t hash) {
+    return (uint8_t)(ccol__fibonacci_mix(hash) & 0x7F);
+}
+
+// Home group from the top bits of the mixed hash
+static inline size_t ccol__swiss_h1(uint32_t hash, size_t num_groups) {
+    return ccol__fibonacci_home(hash, num_groups);
+}
+
+// Integer comparators make key equality byte equality, so such keys can be matched inline
+static size_t ccol__swiss_inline_key_size(const ccol_hash_table_t *hash_table) {
+    if (hash_table->comparator.func != ccol_cmp_hash_entry_key || !hash_table->comparator.ctx) return 0;
+
+    const ccol_comparator_t *key_cmp = (const ccol_comparator_t *)hash_table->comparator.ctx;
+    if (hash_table->key_size == sizeof(uint32_t) &&
+        (key_cmp->func == ccol_cmp_int32 || key_cmp->func == ccol_cmp_uint32)) return sizeof(uint32_t);
+    if (hash_table->key_size == sizeof(uint64_t) &&
+        (key_cmp->func == ccol_cmp_int64 || key_cmp->func == ccol_cmp_uint64)) return sizeof(uint64_t);
+
+    return 0;
+}
+
+static inline void ccol__swiss_store_key(ccol_hash_table_t *hash_table, size_t index, const void *key) {
+    if (!hash_table->inline_key_size) return;
+    memcpy((unsigned char *)hash_table->inline_keys + index * hash_table->inline_key_size, key, hash_table->inline_key_size);
+}
+
+static inline size_t ccol__swiss_max_load(size_t capacity) {
+    return capacity - capacity / 8;
+}
+
+static size_t ccol__swiss_find_insert_index(const uint8_t *ctrl, size_t capacity, uint32_t hash) {
+    size_t num_groups = capacity / CCOL__SWISS_GROUP_WIDTH;
+    size_t group_mask = num_groups - 1;
+    size_t group_index = ccol__swiss_h1(hash, num_groups);
+
+    // Triangular probing visits every group exactly once for power-of-two group counts
+    for (size_t probe = 1; ; probe++) {
+        const uint8_t *group_ctrl = ctrl + group_index * CCOL__SWISS_GROUP_WIDTH;
+        uint64_t mask = ccol__swiss_group_match_empty_or_deleted(ccol__swiss_group_load(group_ctrl));
+        if (mask) return group_index * CCOL__SWISS_GROUP_WIDTH + ccol__swiss_mask_first(mask);
+        group_index = (group_index + probe) & group_mask;
+    }
+}
+
+static ccol_hash_entry_t *ccol__swiss_find_inline(
+    const ccol_hash_table_t *hash_table,
+    const void *key,
+    uint32_t hash,
+    size_t *index_out
+) {
+    size_t num_groups = hash_table->num_buckets / CCOL__SWISS_GROUP_WIDTH;
+    size_t group_mask = num_groups - 1;
+    size_t group_index = ccol__swiss_h1(hash, num_groups);
+
+    uint32_t key32 = 0;
+    uint64_t key64 = 0;
+    if (hash_table->inline_key_size == sizeof(uint32_t)) memcpy(&key32, key, sizeof(key32));
+    else memcpy(&key64, key, sizeof(key64));
+
+    for (size_t probe = 1; probe <= num_groups; probe++) {
+        size_t base = group_index * CCOL__SWISS_GROUP_WIDTH;
+        const uint8_t *group_ctrl = hash_table->ctrl + base;
+
+        uint32_t mask = hash_table->inline_key_size == sizeof(uint32_t)
+            ? ccol__simd_match_u32x8((const uint32_t *)hash_table->inline_keys + base, key32)
+            : ccol__simd_match_u64x8((const uint64_t *)hash_table->inline_keys + base, key64);
+
+        // Empty and deleted slots keep zeroed or stale keys
+        if (mask) mask &= ccol__simd_match_high_clear_u8x8(group_ctrl);
+        if (mask) {
+            size_t index = base + ccol__simd_first(mask);
+            if (index_out) *index_out = index;
+            return &hash_table->slots[index];
+        }
+
+        if (ccol__swiss_group_match_empty(ccol__swiss_group_load(group_ctrl))) return NULL;
+        group_index = (group_index + probe) & group_mask;
+    }
+
+    return NULL;
+}
+
+static ccol_hash_entry_t *ccol__swiss_find_index(
+    const ccol_hash_table_t *hash_table,
+    const void *key,
+    uint32_t hash,
+    size_t *index_out
+) {
+    if (hash_table->inline_key_size) return ccol__swiss_find_inline(hash_table, key, hash, index_out);
+
+    size_t num_groups = hash_table->num_buckets / CCOL__SWISS_GROUP_WIDTH;
+    size_t group_mask = num_groups - 1;
+    size_t group_index = ccol__swiss_h1(hash, num_groups);
+    uint8_t h2 = ccol__swiss_h2(hash);
+
+    for (size_t probe = 1; probe <= num_groups; probe++) {
+        size_t base = group_index * CCOL__SWISS_GROUP_WIDTH;
+        uint64_t group = ccol__swiss_group_load(hash_table->ctrl + base);
+
+        for (uint64_t mask = ccol__swiss_group_match(group, h2); mask; mask &= mask - 1) {
+            size_t index = base + ccol__swiss_mask_first(mask);
+            ccol_hash_entry_t *entry = &hash_table->slots[index];
+            if (entry->hash != hash) continue;  // h2 only checked 7 bits
+            CCOL__HASH_TABLE_COUNT(hash_table, comparisons, 1);
+            if (hash_table->comparator.func(entry, key, hash_table->comparator.ctx) == 0) {
+                if (index_out) *index_out = index;
+                return entry;
+            }
+        }
+
+        if (ccol__swiss_group_match_empty(group)) return NULL;
+        group_index = (group_index + probe) & group_mask;
+    }
+
+    return NULL;
+}
+
+static void ccol__swiss_set_ctrl(ccol_hash_table_t *hash_table, size_t index, uint8_t ctrl) {
+    if (hash_table->ctrl[index] == CCOL__SWISS_EMPTY && ctrl != CCOL__SWISS_EMPTY) hash_table->growth_left--;
+    hash_table->ctrl[index] = ctrl;
+}
+
+// Public (internal to the library)
+size_t ccol__swiss_capacity_for(size_t num_slots) {
+    size_t capacity = CCOL__SWISS_GROUP_WIDTH;
+    while (capacity < num_slots) {
+        if (capacity > SIZE_MAX / 2) return 0;
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+ccol_status_t ccol__swiss_init(ccol_hash_table_t *hash_table, size_t capacity) {
+    if (!hash_table) return CCOL_STATUS_INVALID_ARG;
+
+    capacity = ccol__swiss_capacity_for(capacity);
+    if (capacity == 0 || capacity > SIZE_MAX / sizeof(ccol_hash_entry_t)) return CCOL_STATUS_OVERFLOW;
+
+    uint8_t *ctrl = malloc(capacity);
+    if (!ctrl) return CCOL_STATUS_ALLOC;
+
+    ccol_hash_entry_t *slots = malloc(capacity * sizeof(ccol_hash_entry_t));
+    if (!slots) {
+        free(ctrl);
+        return CCOL_STATUS_ALLOC;
+    }
+
+    size_t inline_key_size = ccol__swiss_inline_key_size(hash_table);
+    void *inline_keys = NULL;
+    if (inline_key_size) {
+        // Zeroed: lookups compare whole groups of keys before the control bytes mask out unused lanes
+        inline_keys = calloc(capacity, inline_key_size);
+        if (!inline_keys) {
+            free(ctrl);
+            free(slots);
+            return CCOL_STATUS_ALLOC;
+        }
+    }
+
+    memset(ctrl, CCOL__SWISS_EMPTY, capacity);
+
+    hash_table->ctrl = ctrl;
+    hash_table->slots = slots;
+    hash_table->inline_keys = inline_keys;
+    hash_table->inline_key_size = inline_key_size;
+    hash_table->num_buckets = capacity;
+    hash_table->growth_left = ccol__swiss_max_load(capacity);
+
+    return CCOL_STATUS_OK;
+}
+
+void ccol__swiss_uninit(ccol_hash_table_t *hash_table) {
+    if (!hash_table) return;
+
+    free(hash_table->ctrl);
+    free(hash_table->slots);
+    free(hash_table->inline_keys);
+
+    hash_table->ctrl = NULL;
+    hash_table->slots = NULL;
+    hash_table->inline_keys = NULL;
+    hash_table->inline_key_size = 0;
+    hash_table->growth_left = 0;
+}
+
+ccol_status_t ccol__swiss_resize(ccol_hash_table_t *hash_table, size_t capacity) {
+    if (!hash_table) return CCOL_STATUS_INVALID_ARG;
+
+    capacity = ccol__swiss_capacity_for(capacity);
+    if (capacity == 0) return CCOL_STATUS_OVERFLOW;
+    while (ccol__swiss_max_load(capacity) < hash_table->size) {
+        if (capacity > SIZE_MAX / 2) return CCOL_STATUS_OVERFLOW;
+        capacity *= 2;
+    }
+
+    uint8_t *old_ctrl = hash_table->ctrl;
+    ccol_hash_entry_t *old_slots = hash_table->slots;
+    void *old_inline_keys = hash_table->inline_keys;
+    size_t old_inline_key_size = hash_table->inline_key_size;
+    size_t old_capacity = hash_table->num_buckets;
+
+    ccol_status_t status = ccol__swiss_init(hash_table, capacity);
+    if (status != CCOL_STATUS_OK) {
+        hash_table->ctrl = old_ctrl;
+        hash_table->slots = old_slots;
+        hash_table->inline_keys = old_inline_keys;
+        hash_table->inline_key_size = old_inline_key_size;
+        hash_table->num_buckets = old_capacity;
+        return status;
+    }
+
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_ctrl[i] & CCOL__SWISS_EMPTY) continue;
+
+        ccol_hash_entry_t *entry = &old_slots[i];
+        size_t index = ccol__swiss_find_insert_index(hash_table->ctrl, hash_table->num_buckets, entry->hash);
+
+        ccol__swiss_set_ctrl(hash_table, index, ccol__swiss_h2(entry->hash));
+        hash_table->slots[index] = *entry;
+        ccol__swiss_store_key(hash_table, index, entry->key);
+    }
+
+    free(old_ctrl);
+    free(old_slots);
+    free(old_inline_keys);
+
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol__swiss_insert(ccol_hash_table_t *hash_table, void *key, void *value) {
+    uint32_t hash = hash_table->hasher.func(key, hash_table->hasher.ctx);
+    return ccol__swiss_insert_hashed(hash_table, key, value, hash, true);
+}
+
+ccol_status_t ccol__swiss_insert_hashed(
+    ccol_hash_table_t *hash_table,
+    void *key,
+    void *value,
+    uint32_t hash,
+    bool check_duplicate
+) {
+    if (check_duplicate && ccol__swiss_find_index(hash_table, key, hash, NULL)) return CCOL_STATUS_ALREADY_EXISTS;
+
+    size_t index = ccol__swiss_find_insert_index(hash_table->ctrl, hash_table->num_buckets, hash);
+    if (hash_table->growth_left == 0 && hash_table->ctrl[index] == CCOL__SWISS_EMPTY) {
+        // Mostly tombstones: rehash in place instead of doubling
+        size_t capacity = hash_table->num_buckets;
+        if (hash_table->size > ccol__swiss_max_load(capacity) / 2) {
+            if (capacity > SIZE_MAX / 2) return CCOL_STATUS_OVERFLOW;
+            capacity *= 2;
+        }
+
+        ccol_status_t status = ccol__swiss_resize(hash_table, capacity);
+        if (status != CCOL_STATUS_OK) return status;
+
+        index = ccol__swiss_find_insert_index(hash_table->ctrl, hash_table->num_buckets, hash);
+    }
+
+    ccol__swiss_set_ctrl(hash_table, index, ccol__swiss_h2(hash));
+    hash_table->slots[index].key = key;
+    hash_table->slots[index].value = value;
+    hash_table->slots[index].hash = hash;
+    ccol__swiss_store_key(hash_table, index, key);
+    hash_table->size++;
+
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol__swiss_erase_at(ccol_hash_table_t *hash_table, size_t index) {
+    if (index >= hash_table->num_buckets) return CCOL_STATUS_OUT_OF_BOUNDS;
+    if (hash_table->ctrl[index] & CCOL__SWISS_EMPTY) return CCOL_STATUS_NOT_FOUND;
+
+    ccol_hash_entry_t *entry = &hash_table->slots[index];
+    if (hash_table->freer.func) hash_table->freer.func(entry, hash_table->freer.ctx);
+
+    // A group that still has an EMPTY slot never had a probe sequence continue past it
+    size_t base = index - index % CCOL__SWISS_GROUP_WIDTH;
+    if (ccol__swiss_group_match_empty(ccol__swiss_group_load(hash_table->ctrl + base))) {
+        hash_table->ctrl[index] = CCOL__SWISS_EMPTY;
+        hash_table->growth_left++;
+    } else {
+        hash_table->ctrl[index] = CCOL__SWISS_DELETED;
+    }
+
+    hash_table->size--;
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol__swiss_remove(ccol_hash_table_t *hash_table, const void *key) {
+    uint32_t hash = hash_table->hasher.func(key, hash_table->hasher.ctx);
+    return ccol__swiss_remove_hashed(hash_table, key, hash);
+}
+
+ccol_status_t ccol__swiss_remove_hashed(ccol_hash_table_t *hash_table, const void *key, uint32_t hash) {
+    size_t index = 0;
+    if (!ccol__swiss_find_index(hash_table, key, hash, &index)) return CCOL_STATUS_NOT_FOUND;
+
+    return ccol__swiss_erase_at(hash_table, index);
+}
+
+ccol_hash_entry_t *ccol__swiss_find(const ccol_hash_table_t *hash_table, const void *key) {
+    uint32_t hash = hash_table->hasher.func(key, hash_table->hasher.ctx);
+    return ccol__swiss_find_index(hash_table, key, hash, NULL);
+}
+
+ccol_hash_entry_t *ccol__swiss_find_hashed(const ccol_hash_table_t *hash_table, const void *key, uint32_t hash) {
+    return ccol__swiss_find_index(hash_table, key, hash, NULL);
+}
+
+// Pulls in the first probe group's control bytes and slots
+void ccol__swiss_prefetch(const ccol_hash_table_t *hash_table, uint32_t hash) {
+    size_t num_groups = hash_table->num_buckets / CCOL__SWISS_GROUP_WIDTH;
+    size_t base = ccol__swiss_h1(hash, num_groups) * CCOL__SWISS_GROUP_WIDTH;
+    CCOL_PREFETCH(hash_table->ctrl + base);
+    CCOL_PREFETCH(hash_table->slots + base);
+    if (hash_table->inline_key_size) {
+        CCOL_PREFETCH((const unsigned char *)hash_table->inline_keys + base * hash_table->inline_key_size);
+    }
+}
+
+ccol_hash_entry_t *ccol__swiss_entry_at(const ccol_hash_table_t *hash_table, size_t index) {
+    if (index >= hash_table->num_buckets || (hash_table->ctrl[index] & CCOL__SWISS_EMPTY)) return NULL;
+    return &hash_table->slots[index];
+}
+
+size_t ccol__swiss_home_group(const ccol_hash_table_t *hash_table, uint32_t hash) {
+    return ccol__swiss_h1(hash, hash_table->num_buckets / CCOL__SWISS_GROUP_WIDTH);
+}
+
+// Groups a lookup visits to reach the slot's entry (1 = its home group); 0 for a free slot
+size_t ccol__swiss_probe_length(const ccol_hash_table_t *hash_table, size_t index) {
+    ccol_hash_entry_t *entry = ccol__swiss_entry_at(hash_table, index);
+    if (!entry) return 0;
+
+    size_t num_groups = hash_table->num_buckets / CCOL__SWISS_GROUP_WIDTH;
+    size_t target = index / CCOL__SWISS_GROUP_WIDTH;
+    size_t group_index = ccol__swiss_home_group(hash_table, entry->hash);
+
+    size_t probe = 1;
+    while (group_index != target && probe < num_groups) {
+        group_index = (group_index + probe) & (num_groups - 1);
+        probe++;
+    }
+    return probe;
+}
+
+ccol_status_t ccol__swiss_clear(ccol_hash_table_t *hash_table) {
+    if (hash_table->freer.func) {
+        for (size_t i = 0; i < hash_table->num_buckets; i++) {
+            if (hash_table->ctrl[i] & CCOL__SWISS_EMPTY) continue;
+            hash_table->freer.func(&hash_table->slots[i], hash_table->freer.ctx);
+        }
+    }
+
+    memset(hash_table->ctrl, CCOL__SWISS_EMPTY, hash_table->num_buckets);
+    hash_table->growth_left = ccol__swiss_max_load(hash_table->num_buckets);
+    hash_table->size = 0;
+
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol__swiss_clone_into(ccol_hash_table_t *dest, const ccol_hash_table_t *src, bool deep) {
+    if (!dest || !src) return CCOL_STATUS_INVALID_ARG;
+    if (deep && !src->copier.func) return CCOL_STATUS_COPY_FUNC;
+
+    ccol__swiss_uninit(dest);
+    ccol_status_t status = ccol__swiss_init(dest, src->num_buckets);
+    if (status != CCOL_STATUS_OK) return status;
+
+    // Same capacity and hasher, so every entry keeps its slot
+    memcpy(dest->ctrl, src->ctrl, src->num_buckets);
+    dest->growth_left = src->growth_left;
+    dest->size = 0;
+
+    for (size_t i = 0; i < src->num_buckets; i++) {
+        if (src->ctrl[i] & CCOL__SWISS_EMPTY) continue;
+
+        if (!deep) {
+            dest->slots[i] = src->slots[i];
+            ccol__swiss_store_key(dest, i, dest->slots[i].key);
+            dest->size++;
+            continue;
+        }
+
+        ccol_hash_entry_t *entry_copy = src->copier.func(&src->slots[i], src->copier.ctx);
+        if (!entry_copy) {
+            // Drop the slots that were never filled so clear() only frees real copies
+            for (size_t j = i; j < src->num_buckets; j++) {
+                if (!(dest->ctrl[j] & CCOL__SWISS_EMPTY)) dest->ctrl[j] = CCOL__SWISS_DELETED;
+            }
+            return CCOL_STATUS_COPY;
+        }
+
+        // Entries live inline, so the copier's heap entry is only a carrier
+        dest->slots[i] = *entry_copy;
+        dest->slots[i].hash = src->slots[i].hash;
+        ccol__swiss_store_key(dest, i, dest->slots[i].key);
+        free(entry_copy);
+        dest->size++;
+    }
+
+    return CCOL_STATUS_OK;
+}
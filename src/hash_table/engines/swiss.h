@@ -0,0 +1,53 @@
+/*
+ * ccol/src/hash_table/engines/swiss.h
+ *
+ * Open-addressing (SwissTable-style) hash table engine.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#ifndef CCOL_HASH_TABLE_SWISS_H
+#define CCOL_HASH_TABLE_SWISS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ccol/ccol_hash.h"
+#include "ccol/ccol_hash_table.h"
+#include "ccol/ccol_status.h"
+
+#define CCOL__SWISS_GROUP_WIDTH 8
+
+#define CCOL__SWISS_EMPTY   ((uint8_t)0x80)
+#define CCOL__SWISS_DELETED ((uint8_t)0xFE)
+
+ccol_status_t ccol__swiss_init(ccol_hash_table_t *hash_table, size_t capacity);
+void ccol__swiss_uninit(ccol_hash_table_t *hash_table);
+
+ccol_status_t ccol__swiss_insert(ccol_hash_table_t *hash_table, void *key, void *value);
+ccol_status_t ccol__swiss_insert_hashed(
+    ccol_hash_table_t *hash_table,
+    void *key,
+    void *value,
+    uint32_t hash,
+    bool check_duplicate
+);
+ccol_status_t ccol__swiss_remove(ccol_hash_table_t *hash_table, const void *key);
+ccol_status_t ccol__swiss_remove_hashed(ccol_hash_table_t *hash_table, const void *key, uint32_t hash);
+ccol_hash_entry_t *ccol__swiss_find(const ccol_hash_table_t *hash_table, const void *key);
+ccol_hash_entry_t *ccol__swiss_find_hashed(const ccol_hash_table_t *hash_table, const void *key, uint32_t hash);
+void ccol__swiss_prefetch(const ccol_hash_table_t *hash_table, uint32_t hash);
+ccol_hash_entry_t *ccol__swiss_entry_at(const ccol_hash_table_t *hash_table, size_t index);
+size_t ccol__swiss_home_group(const ccol_hash_table_t *hash_table, uint32_t hash);
+size_t ccol__swiss_probe_length(const ccol_hash_table_t *hash_table, size_t index);
+
+ccol_status_t ccol__swiss_resize(ccol_hash_table_t *hash_table, size_t capacity);
+ccol_status_t ccol__swiss_erase_at(ccol_hash_table_t *hash_table, size_t index);
+ccol_status_t ccol__swiss_clear(ccol_hash_table_t *hash_table);
+ccol_status_t ccol__swiss_clone_into(ccol_hash_table_t *dest, const ccol_hash_table_t *src, bool deep);
+
+size_t ccol__swiss_capacity_for(size_t num_slots);
+
+#endif  // CCOL_HASH_TABLE_SWISS_H
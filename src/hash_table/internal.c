@@ -11,21 +11,28 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "ccol/ccol_hash.h"
 #include "ccol/ccol_hash_table.h"
 #include "ccol/ccol_constants.h"
+#include "ccol/ccol_dll.h"
 #include "ccol/ccol_macros.h"
 #include "ccol/ccol_status.h"
 
 #include "internal.h"
+#include "internal_slab.h"
+#include "engines/swiss.h"
+#include "engines/robin_hood.h"
 
-void ccol__auto_resize(ccol_hash_table_t *hash_table);
+#define CCOL__HASH_TABLE_REHASH_EMPTY_VISITS 10
 
-ccol_status_t ccol__hash_table_create_internal(
-    ccol_hash_table_t **hash_table_out,
+// Fills a caller-owned table; on failure nothing is left allocated
+ccol_status_t ccol__hash_table_init_internal(
+    ccol_hash_table_t *hash_table,
     int num_buckets,
     size_t key_size,
+    ccol_hash_table_engine_t engine,
     ccol_hash_policy_t policy,
     ccol_hash_func_t hash_func,
     void *hash_ctx,
@@ -34,13 +41,10 @@ ccol_status_t ccol__hash_table_create_internal(
     ccol_print_t printer,
     ccol_comparator_t comparator
 ) {
-    if (!hash_func || !hash_table_out || num_buckets < 1 || key_size < 1) return CCOL_STATUS_INVALID_ARG;
+    if (!hash_func || !hash_table || num_buckets < 1 || key_size < 1) return CCOL_STATUS_INVALID_ARG;
     if (!comparator.func) return CCOL_STATUS_COMPARATOR_FUNC;
 
-    *hash_table_out = NULL;
-
-    ccol_hash_table_t *hash_table = calloc(1, sizeof(ccol_hash_table_t));
-    if (!hash_table) return CCOL_STATUS_ALLOC;
+    memset(hash_table, 0, sizeof(*hash_table));
 
     ccol_hash_t hasher = ccol_hash_create(hash_func, hash_ctx, policy);
 
@@ -52,20 +56,76 @@ ccol_status_t ccol__hash_table_create_internal(
         printer,
         comparator
     );
+    if (status != CCOL_STATUS_OK) return status;
+
+    hash_table->engine = engine;
+    hash_table->key_size = key_size;
+
+    switch (engine) {
+        case CCOL_HASH_TABLE_CHAINED:
+            hash_table->buckets = calloc(num_buckets, sizeof(ccol_dll_t *));
+            if (!hash_table->buckets) status = CCOL_STATUS_ALLOC;
+            hash_table->num_buckets = num_buckets;
+            break;
+        case CCOL_HASH_TABLE_SWISS:
+            status = ccol__swiss_init(hash_table, num_buckets);
+            break;
+        case CCOL_HASH_TABLE_ROBIN_HOOD:
+            status = ccol__robin_hood_init(hash_table, num_buckets);
+            hash_table->max_load_factor = CCOL_HASH_TABLE_ROBIN_HOOD_MAX_LOAD_FACTOR;
+            break;
+        default:
+            status = CCOL_STATUS_INVALID_ARG;
+            break;
+    }
     if (status != CCOL_STATUS_OK) {
-        free(hash_table);
+        hash_table->is_initialized = false;
         return status;
     }
 
-    hash_table->buckets = calloc(num_buckets, sizeof(ccol_dll_t *));
-    if (!hash_table->buckets) {
+    hash_table->min_buckets = hash_table->num_buckets;
+
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol__hash_table_create_internal(
+    ccol_hash_table_t **hash_table_out,
+    int num_buckets,
+    size_t key_size,
+    ccol_hash_table_engine_t engine,
+    ccol_hash_policy_t policy,
+    ccol_hash_func_t hash_func,
+    void *hash_ctx,
+    ccol_copy_t copier,
+    ccol_free_t freer,
+    ccol_print_t printer,
+    ccol_comparator_t comparator
+) {
+    if (!hash_table_out) return CCOL_STATUS_INVALID_ARG;
+
+    *hash_table_out = NULL;
+
+    ccol_hash_table_t *hash_table = malloc(sizeof(ccol_hash_table_t));
+    if (!hash_table) return CCOL_STATUS_ALLOC;
+
+    ccol_status_t status = ccol__hash_table_init_internal(
+        hash_table,
+        num_buckets,
+        key_size,
+        engine,
+        policy,
+        hash_func,
+        hash_ctx,
+        copier,
+        freer,
+        printer,
+        comparator
+    );
+    if (status != CCOL_STATUS_OK) {
         free(hash_table);
-        return CCOL_STATUS_ALLOC;
+        return status;
     }
 
-    hash_table->num_buckets = num_buckets;
-    hash_table->key_size = key_size;
-
     *hash_table_out = hash_table;
 
     return CCOL_STATUS_OK;
@@ -78,6 +138,16 @@ ccol_status_t ccol__hash_table_get_entry(
 ) {
     CCOL_CHECK_INIT(hash_table);
 
+    if (ccol__hash_table_is_open(hash_table)) {
+        CCOL__HASH_TABLE_COUNT(hash_table, lookups, 1);
+        ccol_hash_entry_t *entry = hash_table->engine == CCOL_HASH_TABLE_SWISS
+            ? ccol__swiss_find(hash_table, key)
+            : ccol__robin_hood_find(hash_table, key);
+        if (!entry) return CCOL_STATUS_NOT_FOUND;
+        *entry_out = entry;
+        return CCOL_STATUS_OK;
+    }
+
     ccol_dll_node_t *node = NULL;
     ccol_status_t status = ccol_hash_table_get_node(hash_table, key, &node);
     if (status != CCOL_STATUS_OK) return status;
@@ -86,24 +156,668 @@ ccol_status_t ccol__hash_table_get_entry(
     return CCOL_STATUS_OK;
 }
 
-void ccol__hash_table_uninit(ccol_hash_table_t *hash_table) {
-    if (!hash_table || !hash_table->is_initialized) return;
+// Hashed entry points: the caller already holds the key's hash (the public API hashes
+// once and dispatches here; sharded tables reuse the hash they picked the shard with)
+ccol_hash_entry_t *ccol__hash_table_find_hashed(const ccol_hash_table_t *hash_table, const void *key, uint32_t hash) {
+    if (hash_table->engine == CCOL_HASH_TABLE_CHAINED) ccol__hash_table_rehash_step((ccol_hash_table_t *)hash_table);
+    return ccol__hash_table_peek_hashed(hash_table, key, hash);
+}
+
+// Never migrates: a pending rehash is read through whichever array still holds the key's bucket
+ccol_hash_entry_t *ccol__hash_table_peek_hashed(const ccol_hash_table_t *hash_table, const void *key, uint32_t hash) {
+    CCOL__HASH_TABLE_COUNT(hash_table, lookups, 1);
+    if (hash_table->engine == CCOL_HASH_TABLE_SWISS) return ccol__swiss_find_hashed(hash_table, key, hash);
+    if (hash_table->engine == CCOL_HASH_TABLE_ROBIN_HOOD) return ccol__robin_hood_find_hashed(hash_table, key, hash);
+
+    ccol_dll_t *bucket = *ccol__hash_table_bucket_slot(hash_table, hash);
+    if (!bucket) return NULL;
+
+    ccol_dll_node_t *node = ccol__hash_table_chain_find(hash_table, bucket, key, hash);
+    return node ? (ccol_hash_entry_t *)node->data : NULL;
+}
+
+ccol_status_t ccol__hash_table_insert_hashed(ccol_hash_table_t *hash_table, void *key, void *data, uint32_t hash) {
+    ccol_status_t status;
+    if (hash_table->engine == CCOL_HASH_TABLE_SWISS) {
+        status = ccol__swiss_insert_hashed(hash_table, key, data, hash, true);
+        if (status == CCOL_STATUS_OK) ccol__auto_resize(hash_table);
+        return status;
+    }
+    if (hash_table->engine == CCOL_HASH_TABLE_ROBIN_HOOD) {
+        status = ccol__robin_hood_insert_hashed(hash_table, key, data, hash, true);
+        if (status == CCOL_STATUS_OK) ccol__auto_resize(hash_table);
+        return status;
+    }
+
+    ccol__hash_table_rehash_step(hash_table);
+
+    ccol_dll_t **bucket = ccol__hash_table_bucket_slot(hash_table, hash);
+    if (!*bucket) {
+        status = ccol__hash_table_bucket_create(hash_table, bucket);
+        if (status != CCOL_STATUS_OK) return status;
+    }
+
+    ccol_dll_node_t *duplicate = ccol__hash_table_chain_find(hash_table, *bucket, key, hash);
+    if (duplicate) return CCOL_STATUS_ALREADY_EXISTS;
+
+    ccol_hash_entry_t *entry = ccol__hash_table_entry_alloc(hash_table);
+    if (!entry) return CCOL_STATUS_ALLOC;
+    entry->key = key;
+    entry->value = data;
+    entry->hash = hash;
+
+    status = ccol__hash_table_bucket_push(hash_table, *bucket, entry);
+    if (status != CCOL_STATUS_OK) {
+        ccol__slab_release(hash_table->entry_slab, entry);
+        return status;
+    }
+
+    hash_table->size++;
+    ccol__auto_resize(hash_table);
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol__hash_table_remove_hashed(ccol_hash_table_t *hash_table, const void *key, uint32_t hash) {
+    ccol_status_t status;
+    if (hash_table->engine == CCOL_HASH_TABLE_SWISS) {
+        status = ccol__swiss_remove_hashed(hash_table, key, hash);
+        if (status == CCOL_STATUS_OK) ccol__auto_resize(hash_table);
+        return status;
+    }
+    if (hash_table->engine == CCOL_HASH_TABLE_ROBIN_HOOD) {
+        status = ccol__robin_hood_remove_hashed(hash_table, key, hash);
+        if (status == CCOL_STATUS_OK) ccol__auto_resize(hash_table);
+        return status;
+    }
+
+    ccol__hash_table_rehash_step(hash_table);
+
+    ccol_dll_t *bucket = *ccol__hash_table_bucket_slot(hash_table, hash);
+    if (!bucket) return CCOL_STATUS_NOT_FOUND;
+
+    ccol_dll_node_t *node = ccol__hash_table_chain_find(hash_table, bucket, key, hash);
+    if (!node) return CCOL_STATUS_NOT_FOUND;
+
+    ccol_hash_entry_t *entry = (ccol_hash_entry_t *)node->data;
+    ccol__hash_table_bucket_unlink(hash_table, bucket, node);
+    ccol__hash_table_entry_dispose(hash_table, entry);
+
+    hash_table->size--;
+    ccol__auto_resize(hash_table);
+    return CCOL_STATUS_OK;
+}
+
+// Cached hashes filter the chain before any comparator call
+ccol_dll_node_t *ccol__hash_table_chain_find(
+    const ccol_hash_table_t *hash_table,
+    const ccol_dll_t *bucket,
+    const void *key,
+    uint32_t hash
+) {
+    if (!bucket || !key || !hash_table->comparator.func) return NULL;
+
+    ccol_dll_node_t *node = bucket->head;
+    for (size_t i = 0; i < bucket->size; i++, node = node->next) {
+        const ccol_hash_entry_t *entry = (const ccol_hash_entry_t *)node->data;
+        if (entry->hash != hash) continue;
+        CCOL__HASH_TABLE_COUNT(hash_table, comparisons, 1);
+        if (hash_table->comparator.func(entry, key, hash_table->comparator.ctx) == 0) return node;
+    }
+
+    return NULL;
+}
+
+// Chained entries, nodes and bucket headers live in table-owned slabs created on first use
+ccol__slab_t *ccol__hash_table_slab(ccol__slab_t **slab, size_t obj_size) {
+    if (!*slab) {
+        *slab = malloc(sizeof(ccol__slab_t));
+        if (!*slab) return NULL;
+        ccol__slab_init(*slab, obj_size);
+    }
+    return *slab;
+}
+
+static void ccol__hash_table_slab_free(ccol__slab_t **slab) {
+    if (!*slab) return;
+    ccol__slab_destroy(*slab);
+    free(*slab);
+    *slab = NULL;
+}
+
+static void ccol__hash_table_link_node(ccol_dll_t *bucket, ccol_dll_node_t *node) {
+    node->next = NULL;
+    node->prev = bucket->tail;
+
+    if (bucket->tail) bucket->tail->next = node;
+    else bucket->head = node;
+
+    bucket->tail = node;
+    bucket->size++;
+}
+
+ccol_hash_entry_t *ccol__hash_table_entry_alloc(ccol_hash_table_t *hash_table) {
+    ccol__slab_t *slab = ccol__hash_table_slab(&hash_table->entry_slab, sizeof(ccol_hash_entry_t));
+    return slab ? (ccol_hash_entry_t *)ccol__slab_alloc(slab) : NULL;
+}
+
+// The freer releases what the entry points to; the entry itself goes back to the slab
+void ccol__hash_table_entry_dispose(ccol_hash_table_t *hash_table, ccol_hash_entry_t *entry) {
+    if (hash_table->freer.func) hash_table->freer.func(entry, hash_table->freer.ctx);
+    ccol__slab_release(hash_table->entry_slab, entry);
+}
 
-    for (int i = 0; i < hash_table->num_buckets; i++) {
-        if (hash_table->buckets[i]) {
-            ccol_dll_clear(hash_table->buckets[i]);
-            free(hash_table->buckets[i]);
+ccol_status_t ccol__hash_table_place(ccol_hash_table_t *hash_table, ccol_hash_entry_t *entry) {
+    ccol_dll_t **bucket = ccol__hash_table_bucket_slot(hash_table, entry->hash);
+    if (!*bucket) {
+        ccol_status_t status = ccol__hash_table_bucket_create(hash_table, bucket);
+        if (status != CCOL_STATUS_OK) return status;
+    }
+
+    return ccol__hash_table_bucket_push(hash_table, *bucket, entry);
+}
+
+ccol_status_t ccol__hash_table_bucket_push(ccol_hash_table_t *hash_table, ccol_dll_t *bucket, ccol_hash_entry_t *entry) {
+    ccol__slab_t *slab = ccol__hash_table_slab(&hash_table->node_slab, sizeof(ccol_dll_node_t));
+    ccol_dll_node_t *node = slab ? (ccol_dll_node_t *)ccol__slab_alloc(slab) : NULL;
+    if (!node) return CCOL_STATUS_ALLOC;
+
+    node->data = entry;
+    ccol__hash_table_link_node(bucket, node);
+    return CCOL_STATUS_OK;
+}
+
+void ccol__hash_table_bucket_unlink(ccol_hash_table_t *hash_table, ccol_dll_t *bucket, ccol_dll_node_t *node) {
+    if (node->prev) node->prev->next = node->next;
+    else bucket->head = node->next;
+
+    if (node->next) node->next->prev = node->prev;
+    else bucket->tail = node->prev;
+
+    bucket->size--;
+    ccol__slab_release(hash_table->node_slab, node);
+}
+
+void ccol__hash_table_bucket_clear(ccol_hash_table_t *hash_table, ccol_dll_t *bucket) {
+    ccol_dll_node_t *node = bucket->head;
+    while (node) {
+        ccol_dll_node_t *next = node->next;
+        ccol__hash_table_entry_dispose(hash_table, (ccol_hash_entry_t *)node->data);
+        ccol__slab_release(hash_table->node_slab, node);
+        node = next;
+    }
+
+    bucket->head = bucket->tail = NULL;
+    bucket->size = 0;
+}
+
+// Empties every chain at once. Entries, nodes and headers all sit in the table's slabs,
+// so only a freer needs the chains walked; the storage goes back a whole block at a time.
+void ccol__hash_table_drop_chains(ccol_hash_table_t *hash_table) {
+    if (hash_table->freer.func) {
+        for (size_t i = 0; i < ccol__hash_table_total_buckets(hash_table); i++) {
+            ccol_dll_t *bucket = ccol__hash_table_bucket_at(hash_table, i);
+            if (!bucket) continue;
+
+            ccol_dll_node_t *node = bucket->head;
+            for (size_t j = 0; j < bucket->size; j++, node = node->next) {
+                hash_table->freer.func(node->data, hash_table->freer.ctx);
+            }
         }
     }
-    free(hash_table->buckets);
 
-    hash_table->buckets = NULL;
+    // An in-flight migration has nothing left to move
+    free(hash_table->old_buckets);
+    hash_table->old_buckets = NULL;
+    hash_table->old_num_buckets = 0;
+    hash_table->rehash_index = 0;
+
+    if (hash_table->buckets) memset(hash_table->buckets, 0, hash_table->num_buckets * sizeof(ccol_dll_t *));
+
+    if (hash_table->entry_slab) ccol__slab_destroy(hash_table->entry_slab);
+    if (hash_table->node_slab) ccol__slab_destroy(hash_table->node_slab);
+    if (hash_table->bucket_slab) ccol__slab_destroy(hash_table->bucket_slab);
+
+    hash_table->size = 0;
+}
+
+// Grows once so that n more entries fit under max_load_factor
+ccol_status_t ccol__hash_table_reserve(ccol_hash_table_t *hash_table, size_t n) {
+    if (n > SIZE_MAX - hash_table->size) return CCOL_STATUS_OVERFLOW;
+    size_t total = hash_table->size + n;
+
+    if (hash_table->engine == CCOL_HASH_TABLE_SWISS) {
+        if (total > SIZE_MAX / 8 * 7) return CCOL_STATUS_OVERFLOW;
+        size_t capacity = ccol__swiss_capacity_for(total + total / 7 + 1);
+        if (capacity == 0) return CCOL_STATUS_OVERFLOW;
+        if (capacity <= hash_table->num_buckets) return CCOL_STATUS_OK;
+        CCOL__HASH_TABLE_COUNT(hash_table, resizes, 1);
+        return ccol__swiss_resize(hash_table, capacity);
+    }
+
+    if (hash_table->engine == CCOL_HASH_TABLE_ROBIN_HOOD) {
+        if (total > SIZE_MAX / 10 * 9) return CCOL_STATUS_OVERFLOW;
+        size_t capacity = ccol__robin_hood_capacity_for(total + total / 9 + 1);
+        if (capacity == 0) return CCOL_STATUS_OVERFLOW;
+        if (capacity <= hash_table->num_buckets) return CCOL_STATUS_OK;
+        CCOL__HASH_TABLE_COUNT(hash_table, resizes, 1);
+        return ccol__robin_hood_resize(hash_table, capacity);
+    }
+
+    ccol_status_t status = ccol__hash_table_rehash_finish(hash_table);
+    if (status != CCOL_STATUS_OK || hash_table->max_load_factor <= 0) return status;
 
+    size_t target = hash_table->num_buckets;
+    while ((double)total > hash_table->max_load_factor * (double)target) {
+        if (target > SIZE_MAX / CCOL_HASH_TABLE_GROWTH_FACTOR) return CCOL_STATUS_OVERFLOW;
+        target *= CCOL_HASH_TABLE_GROWTH_FACTOR;
+    }
+    if (target == hash_table->num_buckets) return CCOL_STATUS_OK;
+
+    status = ccol__hash_table_rehash(hash_table, target);
+    if (status != CCOL_STATUS_OK) return status;
+    return ccol__hash_table_rehash_finish(hash_table);
+}
+
+// Places pre-hashed keys using one contiguous run of entries
+ccol_status_t ccol__hash_table_insert_bulk_chained(
+    ccol_hash_table_t *hash_table,
+    void *const *keys,
+    void *const *values,
+    const uint32_t *hashes,
+    size_t n,
+    bool keys_unique
+) {
+    ccol__slab_t *slab = ccol__hash_table_slab(&hash_table->entry_slab, sizeof(ccol_hash_entry_t));
+    if (!slab) return CCOL_STATUS_ALLOC;
+
+    char *run = ccol__slab_alloc_run(slab, n);
+    if (!run) return CCOL_STATUS_ALLOC;
+
+    size_t skipped = 0;
+    for (size_t i = 0; i < n; i++) {
+        ccol_hash_entry_t *entry = (ccol_hash_entry_t *)(run + i * slab->obj_size);
+
+        if (!keys_unique) {
+            ccol_dll_t *bucket = *ccol__hash_table_bucket_slot(hash_table, hashes[i]);
+            if (bucket && ccol__hash_table_chain_find(hash_table, bucket, keys[i], hashes[i])) {
+                ccol__slab_release(slab, entry);
+                skipped++;
+                continue;
+            }
+        }
+
+        entry->key = keys[i];
+        entry->value = values ? values[i] : NULL;
+        entry->hash = hashes[i];
+
+        ccol_status_t status = ccol__hash_table_place(hash_table, entry);
+        if (status != CCOL_STATUS_OK) {
+            for (size_t j = i; j < n; j++) ccol__slab_release(slab, run + j * slab->obj_size);
+            return status;
+        }
+        hash_table->size++;
+    }
+
+    return skipped ? CCOL_STATUS_ALREADY_EXISTS : CCOL_STATUS_OK;
+}
+
+// Rebuilds src's chained contents into an empty dest with the same bucket count.
+// Deep copies go through the copier, whose heap entry is only a carrier for key/value.
+ccol_status_t ccol__hash_table_clone_entries(ccol_hash_table_t *dest, const ccol_hash_table_t *src, bool deep) {
+    if (deep && !src->copier.func) return CCOL_STATUS_COPY_FUNC;
+
+    for (size_t i = 0; i < ccol__hash_table_total_buckets(src); i++) {
+        ccol_dll_t *bucket = ccol__hash_table_bucket_at(src, i);
+        if (!bucket) continue;
+
+        ccol_dll_node_t *node = bucket->head;
+        for (size_t j = 0; j < bucket->size; j++, node = node->next) {
+            const ccol_hash_entry_t *src_entry = (const ccol_hash_entry_t *)node->data;
+
+            ccol_hash_entry_t *entry = ccol__hash_table_entry_alloc(dest);
+            if (!entry) return CCOL_STATUS_ALLOC;
+
+            if (deep) {
+                ccol_hash_entry_t *entry_copy = src->copier.func(src_entry, src->copier.ctx);
+                if (!entry_copy) {
+                    ccol__slab_release(dest->entry_slab, entry);
+                    return CCOL_STATUS_COPY;
+                }
+                entry->key = entry_copy->key;
+                entry->value = entry_copy->value;
+                free(entry_copy);
+            } else {
+                entry->key = src_entry->key;
+                entry->value = src_entry->value;
+            }
+            entry->hash = src_entry->hash;
+
+            ccol_status_t status = ccol__hash_table_place(dest, entry);
+            if (status != CCOL_STATUS_OK) {
+                // Only a deep copy owns what the entry points to
+                if (deep) ccol__hash_table_entry_dispose(dest, entry);
+                else ccol__slab_release(dest->entry_slab, entry);
+                return status;
+            }
+            dest->size++;
+        }
+    }
+
+    return CCOL_STATUS_OK;
+}
+
+// A table-owned key travels by value; dest must never point into src
+void ccol__hash_table_inherit_hasher(ccol_hash_table_t *dest, const ccol_hash_table_t *src) {
+    dest->hasher = src->hasher;
+    if (src->hasher.ctx == &src->hash_key) {
+        dest->hash_key = src->hash_key;
+        dest->hasher.ctx = &dest->hash_key;
+    }
+}
+
+// Resolves up to CCOL__HASH_TABLE_BATCH keys in stages so that each stage's misses overlap:
+// hash everything, then walk bucket slot -> bucket header -> head node -> entry, prefetching
+// the next level for every key before touching any of them.
+size_t ccol__hash_table_get_batch(
+    const ccol_hash_table_t *hash_table,
+    void *const *keys,
+    size_t count,
+    void **values_out,
+    bool *found_out
+) {
+    uint32_t hashes[CCOL__HASH_TABLE_BATCH];
+    size_t found = 0;
+
+    CCOL__HASH_TABLE_COUNT(hash_table, lookups, count);
+
+    for (size_t i = 0; i < count; i++) hashes[i] = hash_table->hasher.func(keys[i], hash_table->hasher.ctx);
+
+    if (ccol__hash_table_is_open(hash_table)) {
+        bool swiss = hash_table->engine == CCOL_HASH_TABLE_SWISS;
+        for (size_t i = 0; i < count; i++) {
+            if (swiss) ccol__swiss_prefetch(hash_table, hashes[i]);
+            else ccol__robin_hood_prefetch(hash_table, hashes[i]);
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            ccol_hash_entry_t *entry = swiss
+                ? ccol__swiss_find_hashed(hash_table, keys[i], hashes[i])
+                : ccol__robin_hood_find_hashed(hash_table, keys[i], hashes[i]);
+            values_out[i] = entry ? entry->value : NULL;
+            found_out[i] = entry != NULL;
+            found += entry != NULL;
+        }
+        return found;
+    }
+
+    ccol_dll_t *buckets[CCOL__HASH_TABLE_BATCH];
+    ccol_dll_t **slots[CCOL__HASH_TABLE_BATCH];
+
+    for (size_t i = 0; i < count; i++) {
+        slots[i] = ccol__hash_table_bucket_slot(hash_table, hashes[i]);
+        CCOL_PREFETCH(slots[i]);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        buckets[i] = *slots[i];
+        if (buckets[i]) CCOL_PREFETCH(buckets[i]);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (buckets[i] && buckets[i]->head) CCOL_PREFETCH(buckets[i]->head);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (buckets[i] && buckets[i]->head) CCOL_PREFETCH(buckets[i]->head->data);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        ccol_dll_node_t *node = buckets[i] ? ccol__hash_table_chain_find(hash_table, buckets[i], keys[i], hashes[i]) : NULL;
+        values_out[i] = node ? ((ccol_hash_entry_t *)node->data)->value : NULL;
+        found_out[i] = node != NULL;
+        found += node != NULL;
+    }
+
+    return found;
+}
+
+// Buckets only link entries; copying and freeing entries is the table's job
+ccol_status_t ccol__hash_table_bucket_create(ccol_hash_table_t *hash_table, ccol_dll_t **bucket_out) {
+    ccol__slab_t *slab = ccol__hash_table_slab(&hash_table->bucket_slab, sizeof(ccol_dll_t));
+    ccol_dll_t *bucket = slab ? (ccol_dll_t *)ccol__slab_alloc(slab) : NULL;
+    if (!bucket) return CCOL_STATUS_ALLOC;
+
+    ccol_status_t status = ccol_dll_init(
+        bucket,
+        (ccol_copy_t){0},
+        (ccol_free_t){0},
+        hash_table->printer,
+        hash_table->comparator
+    );
+    if (status != CCOL_STATUS_OK) {
+        ccol__slab_release(slab, bucket);
+        return status;
+    }
+
+    *bucket_out = bucket;
+    return CCOL_STATUS_OK;
+}
+
+// Moves one old bucket's chain into the live buckets; all-or-nothing per bucket.
+// Entries carry their hash, so no key is rehashed.
+static ccol_status_t ccol__hash_table_migrate_bucket(ccol_hash_table_t *hash_table, ccol_dll_t *bucket) {
+    // Create the destination buckets first so a failed allocation never splits a chain
+    ccol_dll_node_t *node = bucket->head;
+    for (size_t i = 0; i < bucket->size; i++, node = node->next) {
+        ccol_hash_entry_t *entry = (ccol_hash_entry_t *)node->data;
+        ccol_dll_t **dest = &hash_table->buckets[entry->hash % hash_table->num_buckets];
+        if (*dest) continue;
+
+        ccol_status_t status = ccol__hash_table_bucket_create(hash_table, dest);
+        if (status != CCOL_STATUS_OK) return status;
+    }
+
+    // Relink the existing nodes; no entry or node is reallocated
+    node = bucket->head;
+    while (node) {
+        ccol_dll_node_t *next = node->next;
+        ccol_hash_entry_t *entry = (ccol_hash_entry_t *)node->data;
+        ccol__hash_table_link_node(hash_table->buckets[entry->hash % hash_table->num_buckets], node);
+        node = next;
+    }
+
+    ccol__slab_release(hash_table->bucket_slab, bucket);
+    return CCOL_STATUS_OK;
+}
+
+static ccol_status_t ccol__hash_table_migrate(ccol_hash_table_t *hash_table, size_t max_buckets) {
+    if (!hash_table->old_buckets) return CCOL_STATUS_OK;
+
+    // Bound the empty buckets skipped too, so a sparse old table can't stall one call
+    size_t empty_visits = max_buckets > SIZE_MAX / CCOL__HASH_TABLE_REHASH_EMPTY_VISITS
+        ? SIZE_MAX
+        : max_buckets * CCOL__HASH_TABLE_REHASH_EMPTY_VISITS;
+    size_t migrated = 0;
+
+    while (migrated < max_buckets && hash_table->rehash_index < hash_table->old_num_buckets) {
+        ccol_dll_t *bucket = hash_table->old_buckets[hash_table->rehash_index];
+        if (!bucket) {
+            hash_table->rehash_index++;
+            if (--empty_visits == 0) break;
+            continue;
+        }
+
+        ccol_status_t status = ccol__hash_table_migrate_bucket(hash_table, bucket);
+        if (status != CCOL_STATUS_OK) return status;
+
+        hash_table->old_buckets[hash_table->rehash_index++] = NULL;
+        migrated++;
+    }
+
+    if (hash_table->rehash_index == hash_table->old_num_buckets) {
+        free(hash_table->old_buckets);
+        hash_table->old_buckets = NULL;
+        hash_table->old_num_buckets = 0;
+        hash_table->rehash_index = 0;
+    }
+
+    return CCOL_STATUS_OK;
+}
+
+void ccol__hash_table_rehash_step(ccol_hash_table_t *hash_table) {
+    if (!hash_table->old_buckets) return;
+
+    // Best effort: a failed allocation is retried by a later operation
+    (void)ccol__hash_table_migrate(hash_table, hash_table->rehash_step ? hash_table->rehash_step : SIZE_MAX);
+}
+
+ccol_status_t ccol__hash_table_rehash_finish(ccol_hash_table_t *hash_table) {
+    while (hash_table->old_buckets) {
+        ccol_status_t status = ccol__hash_table_migrate(hash_table, SIZE_MAX);
+        if (status != CCOL_STATUS_OK) return status;
+    }
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol__hash_table_rehash(ccol_hash_table_t *hash_table, size_t new_num_buckets) {
+    CCOL_CHECK_INIT(hash_table);
+    if (new_num_buckets == 0) return CCOL_STATUS_INVALID_ARG;
+
+    CCOL__HASH_TABLE_COUNT(hash_table, resizes, 1);
+    if (hash_table->engine == CCOL_HASH_TABLE_SWISS) return ccol__swiss_resize(hash_table, new_num_buckets);
+    if (hash_table->engine == CCOL_HASH_TABLE_ROBIN_HOOD) return ccol__robin_hood_resize(hash_table, new_num_buckets);
+
+    ccol_status_t status = ccol__hash_table_rehash_finish(hash_table);
+    if (status != CCOL_STATUS_OK) return status;
+
+    // Incremental mode keeps its bounded steps; a parallel rehash is all-at-once
+    size_t num_threads = ccol__hash_table_threads(hash_table);
+    if (num_threads > 1 && hash_table->rehash_step == 0) {
+        return ccol__hash_table_rehash_parallel(hash_table, new_num_buckets, num_threads);
+    }
+
+    ccol_dll_t **new_buckets = calloc(new_num_buckets, sizeof(ccol_dll_t *));
+    if (!new_buckets) return CCOL_STATUS_ALLOC;
+
+    hash_table->old_buckets = hash_table->buckets;
+    hash_table->old_num_buckets = hash_table->num_buckets;
+    hash_table->rehash_index = 0;
+
+    hash_table->buckets = new_buckets;
+    hash_table->num_buckets = new_num_buckets;
+
+    // Incremental mode leaves the rest of the migration to subsequent operations.
+    // A failure part-way leaves a consistent mid-migration table either way.
+    if (hash_table->rehash_step > 0) {
+        ccol__hash_table_rehash_step(hash_table);
+        return CCOL_STATUS_OK;
+    }
+
+    return ccol__hash_table_rehash_finish(hash_table);
+}
+
+void ccol__auto_resize(ccol_hash_table_t *hash_table) {
+    if (!hash_table || !hash_table->is_initialized || hash_table->num_buckets == 0) return;
+    if (hash_table->old_buckets) return;  // let the in-flight migration finish first
+
+    double size = (double)hash_table->size;
+    size_t target = hash_table->num_buckets;
+
+    if (hash_table->max_load_factor > 0 && size > hash_table->max_load_factor * (double)target) {
+        while (size > hash_table->max_load_factor * (double)target) {
+            if (target > SIZE_MAX / CCOL_HASH_TABLE_GROWTH_FACTOR) return;
+            target *= CCOL_HASH_TABLE_GROWTH_FACTOR;
+        }
+    } else if (hash_table->min_load_factor > 0 && size < hash_table->min_load_factor * (double)target) {
+        while (target / CCOL_HASH_TABLE_GROWTH_FACTOR >= hash_table->min_buckets &&
+               size < hash_table->min_load_factor * (double)target) {
+            target /= CCOL_HASH_TABLE_GROWTH_FACTOR;
+        }
+    }
+
+    if (target == hash_table->num_buckets) return;
+
+    // Best effort: on allocation failure the table keeps working at its current size
+    (void)ccol__hash_table_rehash(hash_table, target);
+}
+
+void ccol__hash_table_release_storage(ccol_hash_table_t *hash_table) {
+    if (!hash_table) return;
+
+    if (hash_table->engine == CCOL_HASH_TABLE_SWISS) {
+        if (hash_table->ctrl) ccol__swiss_clear(hash_table);
+        ccol__swiss_uninit(hash_table);
+    } else if (hash_table->engine == CCOL_HASH_TABLE_ROBIN_HOOD) {
+        if (hash_table->ctrl) ccol__robin_hood_clear(hash_table);
+        ccol__robin_hood_uninit(hash_table);
+    } else if (hash_table->buckets) {
+        ccol__hash_table_drop_chains(hash_table);
+        free(hash_table->buckets);
+    }
+
+    ccol__hash_table_slab_free(&hash_table->entry_slab);
+    ccol__hash_table_slab_free(&hash_table->node_slab);
+    ccol__hash_table_slab_free(&hash_table->bucket_slab);
+
+    hash_table->buckets = NULL;
     hash_table->num_buckets = 0;
+    hash_table->old_buckets = NULL;
+    hash_table->old_num_buckets = 0;
+    hash_table->rehash_index = 0;
     hash_table->size = 0;
+}
+
+ccol_status_t ccol__hash_table_copy_engine(ccol_hash_table_t *dest, const ccol_hash_table_t *src, bool deep) {
+    CCOL_CHECK_INIT(dest);
+    CCOL_CHECK_INIT(src);
+
+    ccol__hash_table_release_storage(dest);
+    dest->engine = src->engine;
+    dest->key_size = src->key_size;
+
+    if (src->engine == CCOL_HASH_TABLE_CHAINED) {
+        dest->buckets = calloc(src->num_buckets, sizeof(ccol_dll_t *));
+        if (!dest->buckets) return CCOL_STATUS_ALLOC;
+        dest->num_buckets = src->num_buckets;
+    }
+
+    return ccol__hash_table_copy_entries(dest, src, deep);
+}
+
+// Fills dest, already laid out like src, with src's entries. Large tables copy the layout
+// across src's threads and, when deep, run the copier there too; copier must then be thread-safe.
+ccol_status_t ccol__hash_table_copy_entries(ccol_hash_table_t *dest, const ccol_hash_table_t *src, bool deep) {
+    if (deep && !src->copier.func) return CCOL_STATUS_COPY_FUNC;
+
+    size_t num_threads = ccol__hash_table_threads(src);
+    bool parallel = num_threads > 1 && !src->old_buckets;
+
+    ccol_status_t status;
+    if (src->engine == CCOL_HASH_TABLE_SWISS) status = ccol__swiss_clone_into(dest, src, deep && !parallel);
+    else if (src->engine == CCOL_HASH_TABLE_ROBIN_HOOD) status = ccol__robin_hood_clone_into(dest, src, deep && !parallel);
+    else if (parallel) status = ccol__hash_table_clone_entries_parallel(dest, src, num_threads);
+    else status = ccol__hash_table_clone_entries(dest, src, deep);
+
+    if (status != CCOL_STATUS_OK || !deep || !parallel) return status;
+    return ccol__hash_table_deep_copy_parallel(dest, src->copier, num_threads);
+}
+
+ccol_hash_entry_t *ccol__hash_table_slot_entry(const ccol_hash_table_t *hash_table, size_t index) {
+    if (hash_table->engine == CCOL_HASH_TABLE_SWISS) return ccol__swiss_entry_at(hash_table, index);
+    if (hash_table->engine == CCOL_HASH_TABLE_ROBIN_HOOD) return ccol__robin_hood_entry_at(hash_table, index);
+    return NULL;
+}
+
+void ccol__hash_table_uninit(ccol_hash_table_t *hash_table) {
+    if (!hash_table || !hash_table->is_initialized) return;
+
+    ccol__hash_table_release_storage(hash_table);
+
     hash_table->key_size = 0;
+    hash_table->engine = CCOL_HASH_TABLE_CHAINED;
 
     hash_table->hasher = (ccol_hash_t){0};
+    hash_table->hash_key = (ccol_hash_key_t){0};
     hash_table->copier = (ccol_copy_t){0};
     hash_table->freer = (ccol_free_t){0};
     hash_table->printer = (ccol_print_t){0};
@@ -11,15 +11,41 @@
 #define CCOL_HASH_TABLE_INTERNAL_H
 
 #include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
 
 #include "ccol/ccol_hash.h"
 #include "ccol/ccol_hash_table.h"
 #include "ccol/ccol_status.h"
 
+// Operation counters compile away unless CCOL_HASH_TABLE_STATS is defined; relaxed atomics
+// since readers of a concurrent table's shard may count at the same time
+#if defined(CCOL_HASH_TABLE_STATS)
+#include "internal_atomic.h"
+#define CCOL__HASH_TABLE_COUNT(hash_table, counter, n) \
+    ((void)CCOL__ATOMIC_FETCH_ADD_RELAXED(&((ccol_hash_table_t *)(hash_table))->counters.counter, (uint64_t)(n)))
+#else
+#define CCOL__HASH_TABLE_COUNT(hash_table, counter, n) ((void)0)
+#endif
+
+ccol_status_t ccol__hash_table_init_internal(
+    ccol_hash_table_t *hash_table,
+    int num_buckets,
+    size_t key_size,
+    ccol_hash_table_engine_t engine,
+    ccol_hash_policy_t policy,
+    ccol_hash_func_t hash_func,
+    void *hash_ctx,
+    ccol_copy_t copier,
+    ccol_free_t freer,
+    ccol_print_t printer,
+    ccol_comparator_t comparator
+);
 ccol_status_t ccol__hash_table_create_internal(
     ccol_hash_table_t **hash_table_out,
     int num_buckets,
     size_t key_size,
+    ccol_hash_table_engine_t engine,
     ccol_hash_policy_t policy,
     ccol_hash_func_t hash_func,
     void *hash_ctx,
@@ -29,13 +55,109 @@ ccol_status_t ccol__hash_table_create_internal(
     ccol_comparator_t comparator
 );
 
-ccol_status_t ccol__resolve_hash_func(size_t key_size, ccol_hash_policy_t policy, ccol_hash_func_t *hash_func_out);
 ccol_status_t ccol__hash_table_get_entry(
     const ccol_hash_table_t *hash_table,
     const void *key,
     ccol_hash_entry_t **entry_out
 );
 
+ccol_hash_entry_t *ccol__hash_table_find_hashed(const ccol_hash_table_t *hash_table, const void *key, uint32_t hash);
+ccol_hash_entry_t *ccol__hash_table_peek_hashed(const ccol_hash_table_t *hash_table, const void *key, uint32_t hash);
+ccol_status_t ccol__hash_table_insert_hashed(ccol_hash_table_t *hash_table, void *key, void *data, uint32_t hash);
+ccol_status_t ccol__hash_table_remove_hashed(ccol_hash_table_t *hash_table, const void *key, uint32_t hash);
+
+// Open-addressing engines store entries inline; their "buckets" are slots
+static inline bool ccol__hash_table_is_open(const ccol_hash_table_t *hash_table) {
+    return hash_table->engine != CCOL_HASH_TABLE_CHAINED;
+}
+
+ccol_hash_entry_t *ccol__hash_table_slot_entry(const ccol_hash_table_t *hash_table, size_t index);
+
+static inline bool ccol__hash_table_value_equals(const void *a, const void *b, const ccol_comparator_t *value_cmp) {
+    if (!value_cmp || !value_cmp->func) return a == b;
+    return value_cmp->func(a, b, value_cmp->ctx) == 0;
+}
+
+// Bucket that holds (or would hold) a key with this hash while a migration may be in flight
+static inline ccol_dll_t **ccol__hash_table_bucket_slot(const ccol_hash_table_t *hash_table, uint32_t hash) {
+    if (hash_table->old_buckets) {
+        size_t old_index = hash % hash_table->old_num_buckets;
+        if (old_index >= hash_table->rehash_index) return &hash_table->old_buckets[old_index];
+    }
+    return &hash_table->buckets[hash % hash_table->num_buckets];
+}
+
+// Flat view over the not-yet-migrated old buckets followed by the live ones
+static inline size_t ccol__hash_table_total_buckets(const ccol_hash_table_t *hash_table) {
+    return hash_table->old_num_buckets + hash_table->num_buckets;
+}
+
+static inline ccol_dll_t *ccol__hash_table_bucket_at(const ccol_hash_table_t *hash_table, size_t index) {
+    if (index < hash_table->old_num_buckets) return hash_table->old_buckets[index];
+    return hash_table->buckets[index - hash_table->old_num_buckets];
+}
+
+ccol_dll_node_t *ccol__hash_table_chain_find(
+    const ccol_hash_table_t *hash_table,
+    const ccol_dll_t *bucket,
+    const void *key,
+    uint32_t hash
+);
+
+struct ccol__slab *ccol__hash_table_slab(struct ccol__slab **slab, size_t obj_size);
+ccol_hash_entry_t *ccol__hash_table_entry_alloc(ccol_hash_table_t *hash_table);
+void ccol__hash_table_entry_dispose(ccol_hash_table_t *hash_table, ccol_hash_entry_t *entry);
+ccol_status_t ccol__hash_table_place(ccol_hash_table_t *hash_table, ccol_hash_entry_t *entry);
+ccol_status_t ccol__hash_table_bucket_push(ccol_hash_table_t *hash_table, ccol_dll_t *bucket, ccol_hash_entry_t *entry);
+void ccol__hash_table_bucket_unlink(ccol_hash_table_t *hash_table, ccol_dll_t *bucket, ccol_dll_node_t *node);
+void ccol__hash_table_bucket_clear(ccol_hash_table_t *hash_table, ccol_dll_t *bucket);
+void ccol__hash_table_drop_chains(ccol_hash_table_t *hash_table);
+
+ccol_status_t ccol__hash_table_reserve(ccol_hash_table_t *hash_table, size_t n);
+ccol_status_t ccol__hash_table_collect_stats(const ccol_hash_table_t *hash_table, ccol_hash_table_stats_t *stats);
+ccol_status_t ccol__hash_table_insert_bulk_chained(
+    ccol_hash_table_t *hash_table,
+    void *const *keys,
+    void *const *values,
+    const uint32_t *hashes,
+    size_t n,
+    bool keys_unique
+);
+ccol_status_t ccol__hash_table_clone_entries(ccol_hash_table_t *dest, const ccol_hash_table_t *src, bool deep);
+void ccol__hash_table_inherit_hasher(ccol_hash_table_t *dest, const ccol_hash_table_t *src);
+
+#define CCOL__HASH_TABLE_BATCH 16
+#define CCOL__HASH_TABLE_BUILD_MIN_BUCKETS 16
+
+size_t ccol__hash_table_get_batch(
+    const ccol_hash_table_t *hash_table,
+    void *const *keys,
+    size_t count,
+    void **values_out,
+    bool *found_out
+);
+
+ccol_status_t ccol__hash_table_copy_engine(ccol_hash_table_t *dest, const ccol_hash_table_t *src, bool deep);
+
+ccol_status_t ccol__hash_table_bucket_create(ccol_hash_table_t *hash_table, ccol_dll_t **bucket_out);
+ccol_status_t ccol__hash_table_rehash(ccol_hash_table_t *hash_table, size_t new_num_buckets);
+void ccol__hash_table_rehash_step(ccol_hash_table_t *hash_table);
+ccol_status_t ccol__hash_table_rehash_finish(ccol_hash_table_t *hash_table);
+void ccol__auto_resize(ccol_hash_table_t *hash_table);
+
+// Threads a bulk operation should use: 1 unless the table opted in and is large enough
+static inline size_t ccol__hash_table_threads(const ccol_hash_table_t *hash_table) {
+    if (hash_table->num_threads < 2 || hash_table->size < CCOL_HASH_TABLE_PARALLEL_MIN_SIZE) return 1;
+    return hash_table->num_threads;
+}
+
+ccol_status_t ccol__hash_table_rehash_parallel(ccol_hash_table_t *hash_table, size_t new_num_buckets, size_t num_threads);
+ccol_status_t ccol__hash_table_clone_entries_parallel(ccol_hash_table_t *dest, const ccol_hash_table_t *src, size_t num_threads);
+ccol_status_t ccol__hash_table_deep_copy_parallel(ccol_hash_table_t *hash_table, ccol_copy_t copier, size_t num_threads);
+void ccol__hash_table_free_entries_parallel(ccol_hash_table_t *hash_table, size_t num_threads);
+ccol_status_t ccol__hash_table_copy_entries(ccol_hash_table_t *dest, const ccol_hash_table_t *src, bool deep);
+
+void ccol__hash_table_release_storage(ccol_hash_table_t *hash_table);
 void ccol__hash_table_uninit(ccol_hash_table_t *hash_table);
 
 #endif  // CCOL_HASH_TABLE_INTERNAL_H
\ No newline at end of file
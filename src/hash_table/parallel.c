@@ -0,0 +1,421 @@
+/*
+ * ccol/src/hash_table/parallel.c
+ *
+ * Multi-threaded bulk operations for hash tables.
+ *
+ * Every pass partitions a flat bucket (or slot) range with ccol__parallel_for.
+ * Passes that allocate take whole runs from the table's slabs up front, so
+ * workers only write memory they were handed and never take a lock.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "ccol/ccol_hash.h"
+#include "ccol/ccol_hash_table.h"
+#include "ccol/ccol_dll.h"
+#include "ccol/ccol_status.h"
+
+#include "internal.h"
+#include "internal_atomic.h"
+#include "internal_slab.h"
+#include "internal_thread_pool.h"
+
+typedef struct ccol__parallel_rehash {
+    ccol_hash_table_t *hash_table;
+    ccol_dll_t **new_buckets;
+    size_t new_num_buckets;
+
+    size_t *ends;              // per destination bucket: count, then write cursor, then end offset
+    ccol_dll_node_t **nodes;   // every node, grouped by destination bucket
+    char *headers;             // slab run with one header per non-empty destination bucket
+
+    size_t block_entries[CCOL__THREAD_POOL_MAX_THREADS];  // per task, then the task's base offset
+    size_t block_headers[CCOL__THREAD_POOL_MAX_THREADS];
+} ccol__parallel_rehash_t;
+
+typedef struct ccol__parallel_clone {
+    ccol_hash_table_t *dest;
+    const ccol_hash_table_t *src;
+
+    char *entries;  // slab runs, one entry and node per source entry
+    char *nodes;
+    char *headers;
+
+    size_t block_entries[CCOL__THREAD_POOL_MAX_THREADS];
+    size_t block_headers[CCOL__THREAD_POOL_MAX_THREADS];
+} ccol__parallel_clone_t;
+
+typedef struct ccol__parallel_deep {
+    ccol_hash_table_t *hash_table;
+    ccol_copy_t copier;
+    size_t replaced[CCOL__THREAD_POOL_MAX_THREADS];  // entries copied, in walk order
+    bool failed[CCOL__THREAD_POOL_MAX_THREADS];
+} ccol__parallel_deep_t;
+
+// Private
+static inline ccol_hash_entry_t *ccol__parallel_node_entry(const ccol_dll_node_t *node) {
+    return (ccol_hash_entry_t *)node->data;
+}
+
+static void ccol__parallel_bucket_reset(const ccol_hash_table_t *hash_table, ccol_dll_t *bucket) {
+    (void)ccol_dll_init(bucket, (ccol_copy_t){0}, (ccol_free_t){0}, hash_table->printer, hash_table->comparator);
+}
+
+static void ccol__parallel_link(ccol_dll_t *bucket, ccol_dll_node_t *node) {
+    node->next = NULL;
+    node->prev = bucket->tail;
+
+    if (bucket->tail) bucket->tail->next = node;
+    else bucket->head = node;
+
+    bucket->tail = node;
+    bucket->size++;
+}
+
+// Turns per-task totals into per-task base offsets; returns the grand total
+static size_t ccol__parallel_exclusive_scan(size_t *blocks, size_t num_tasks) {
+    size_t total = 0;
+    for (size_t i = 0; i < num_tasks; i++) {
+        size_t count = blocks[i];
+        blocks[i] = total;
+        total += count;
+    }
+    return total;
+}
+
+// Rehash pass 1: count entries per destination bucket
+static void ccol__parallel_rehash_count(void *arg, size_t task, size_t begin, size_t end) {
+    ccol__parallel_rehash_t *rehash = arg;
+    (void)task;
+
+    for (size_t i = begin; i < end; i++) {
+        ccol_dll_t *bucket = rehash->hash_table->buckets[i];
+        if (!bucket) continue;
+
+        for (ccol_dll_node_t *node = bucket->head; node; node = node->next) {
+            size_t dest = ccol__parallel_node_entry(node)->hash % rehash->new_num_buckets;
+            CCOL__ATOMIC_FETCH_ADD(&rehash->ends[dest], 1);
+        }
+    }
+}
+
+// Rehash pass 2: per-task totals over a range of destination buckets
+static void ccol__parallel_rehash_totals(void *arg, size_t task, size_t begin, size_t end) {
+    ccol__parallel_rehash_t *rehash = arg;
+
+    size_t entries = 0, headers = 0;
+    for (size_t i = begin; i < end; i++) {
+        entries += rehash->ends[i];
+        headers += rehash->ends[i] != 0;
+    }
+
+    rehash->block_entries[task] = entries;
+    rehash->block_headers[task] = headers;
+}
+
+// Rehash pass 3: counts become each bucket's first write position
+static void ccol__parallel_rehash_offsets(void *arg, size_t task, size_t begin, size_t end) {
+    ccol__parallel_rehash_t *rehash = arg;
+
+    size_t offset = rehash->block_entries[task];
+    for (size_t i = begin; i < end; i++) {
+        size_t count = rehash->ends[i];
+        rehash->ends[i] = offset;
+        offset += count;
+    }
+}
+
+// Rehash pass 4: scatter every node to its slot; afterwards ends[i] is bucket i's end offset
+static void ccol__parallel_rehash_scatter(void *arg, size_t task, size_t begin, size_t end) {
+    ccol__parallel_rehash_t *rehash = arg;
+    (void)task;
+
+    for (size_t i = begin; i < end; i++) {
+        ccol_dll_t *bucket = rehash->hash_table->buckets[i];
+        if (!bucket) continue;
+
+        for (ccol_dll_node_t *node = bucket->head; node; node = node->next) {
+            size_t dest = ccol__parallel_node_entry(node)->hash % rehash->new_num_buckets;
+            rehash->nodes[CCOL__ATOMIC_FETCH_ADD(&rehash->ends[dest], 1)] = node;
+        }
+    }
+}
+
+// Rehash pass 5: each task builds the chains of its own destination buckets
+static void ccol__parallel_rehash_link(void *arg, size_t task, size_t begin, size_t end) {
+    ccol__parallel_rehash_t *rehash = arg;
+    size_t header_size = rehash->hash_table->bucket_slab->obj_size;
+
+    size_t start = rehash->block_entries[task];
+    size_t header = rehash->block_headers[task];
+    for (size_t i = begin; i < end; i++) {
+        size_t stop = rehash->ends[i];
+        if (stop == start) {
+            rehash->new_buckets[i] = NULL;
+            continue;
+        }
+
+        ccol_dll_t *bucket = (ccol_dll_t *)(rehash->headers + header++ * header_size);
+        ccol__parallel_bucket_reset(rehash->hash_table, bucket);
+        for (size_t j = start; j < stop; j++) ccol__parallel_link(bucket, rehash->nodes[j]);
+
+        rehash->new_buckets[i] = bucket;
+        start = stop;
+    }
+}
+
+// Clone pass 1: per-task totals over a range of source buckets
+static void ccol__parallel_clone_totals(void *arg, size_t task, size_t begin, size_t end) {
+    ccol__parallel_clone_t *clone = arg;
+
+    size_t entries = 0, headers = 0;
+    for (size_t i = begin; i < end; i++) {
+        ccol_dll_t *bucket = clone->src->buckets[i];
+        if (!bucket || bucket->size == 0) continue;
+        entries += bucket->size;
+        headers++;
+    }
+
+    clone->block_entries[task] = entries;
+    clone->block_headers[task] = headers;
+}
+
+// Clone pass 2: rebuild each source bucket bucket-for-bucket from the preallocated runs
+static void ccol__parallel_clone_fill(void *arg, size_t task, size_t begin, size_t end) {
+    ccol__parallel_clone_t *clone = arg;
+    ccol_hash_table_t *dest = clone->dest;
+    size_t entry_size = dest->entry_slab->obj_size;
+    size_t node_size = dest->node_slab->obj_size;
+    size_t header_size = dest->bucket_slab->obj_size;
+
+    size_t entry_index = clone->block_entries[task];
+    size_t header_index = clone->block_headers[task];
+    for (size_t i = begin; i < end; i++) {
+        ccol_dll_t *src_bucket = clone->src->buckets[i];
+        if (!src_bucket || src_bucket->size == 0) continue;
+
+        ccol_dll_t *bucket = (ccol_dll_t *)(clone->headers + header_index++ * header_size);
+        ccol__parallel_bucket_reset(dest, bucket);
+
+        for (ccol_dll_node_t *src_node = src_bucket->head; src_node; src_node = src_node->next) {
+            ccol_hash_entry_t *entry = (ccol_hash_entry_t *)(clone->entries + entry_index * entry_size);
+            ccol_dll_node_t *node = (ccol_dll_node_t *)(clone->nodes + entry_index * node_size);
+            entry_index++;
+
+            *entry = *ccol__parallel_node_entry(src_node);
+            node->data = entry;
+            ccol__parallel_link(bucket, node);
+        }
+
+        dest->buckets[i] = bucket;
+    }
+}
+
+// Visits up to limit entries of [begin, end) in a fixed order; limit SIZE_MAX visits all
+static size_t ccol__parallel_walk(
+    ccol_hash_table_t *hash_table,
+    size_t begin,
+    size_t end,
+    size_t limit,
+    bool (*visit)(ccol_hash_table_t *hash_table, ccol_hash_entry_t *entry, void *ctx),
+    void *ctx
+) {
+    size_t visited = 0;
+    for (size_t i = begin; i < end && visited < limit; i++) {
+        if (ccol__hash_table_is_open(hash_table)) {
+            ccol_hash_entry_t *entry = ccol__hash_table_slot_entry(hash_table, i);
+            if (!entry) continue;
+            if (!visit(hash_table, entry, ctx)) return visited;
+            visited++;
+            continue;
+        }
+
+        ccol_dll_t *bucket = ccol__hash_table_bucket_at(hash_table, i);
+        for (ccol_dll_node_t *node = bucket ? bucket->head : NULL; node && visited < limit; node = node->next) {
+            if (!visit(hash_table, ccol__parallel_node_entry(node), ctx)) return visited;
+            visited++;
+        }
+    }
+    return visited;
+}
+
+static size_t ccol__parallel_walk_end(const ccol_hash_table_t *hash_table) {
+    return ccol__hash_table_is_open(hash_table) ? hash_table->num_buckets : ccol__hash_table_total_buckets(hash_table);
+}
+
+static bool ccol__parallel_free_visit(ccol_hash_table_t *hash_table, ccol_hash_entry_t *entry, void *ctx) {
+    (void)ctx;
+    hash_table->freer.func(entry, hash_table->freer.ctx);
+    return true;
+}
+
+static void ccol__parallel_free(void *arg, size_t task, size_t begin, size_t end) {
+    (void)task;
+    ccol__parallel_walk(arg, begin, end, SIZE_MAX, ccol__parallel_free_visit, NULL);
+}
+
+typedef struct ccol__parallel_deep_task {
+    const ccol_copy_t *copier;
+    bool failed;
+} ccol__parallel_deep_task_t;
+
+static bool ccol__parallel_deep_visit(ccol_hash_table_t *hash_table, ccol_hash_entry_t *entry, void *ctx) {
+    ccol__parallel_deep_task_t *deep_task = ctx;
+    (void)hash_table;
+
+    ccol_hash_entry_t *entry_copy = deep_task->copier->func(entry, deep_task->copier->ctx);
+    if (!entry_copy) {
+        deep_task->failed = true;
+        return false;
+    }
+
+    // The copier's heap entry is only a carrier; the hash stays with the entry
+    entry->key = entry_copy->key;
+    entry->value = entry_copy->value;
+    free(entry_copy);
+    return true;
+}
+
+static void ccol__parallel_deep(void *arg, size_t task, size_t begin, size_t end) {
+    ccol__parallel_deep_t *deep = arg;
+
+    ccol__parallel_deep_task_t deep_task = { .copier = &deep->copier, .failed = false };
+    deep->replaced[task] = ccol__parallel_walk(deep->hash_table, begin, end, SIZE_MAX, ccol__parallel_deep_visit, &deep_task);
+    deep->failed[task] = deep_task.failed;
+}
+
+// Public (internal to the library)
+
+// Chained only, with no migration in flight. Count-then-scatter: nodes are grouped by
+// destination with one atomic add each, then every task links its own destination range.
+// Existing nodes and entries are relinked; only bucket headers are new.
+ccol_status_t ccol__hash_table_rehash_parallel(ccol_hash_table_t *hash_table, size_t new_num_buckets, size_t num_threads) {
+    ccol__parallel_rehash_t *rehash = calloc(1, sizeof(ccol__parallel_rehash_t));
+    if (!rehash) return CCOL_STATUS_ALLOC;
+
+    rehash->hash_table = hash_table;
+    rehash->new_num_buckets = new_num_buckets;
+    rehash->new_buckets = malloc(new_num_buckets * sizeof(ccol_dll_t *));
+    rehash->ends = calloc(new_num_buckets, sizeof(size_t));
+    rehash->nodes = malloc((hash_table->size ? hash_table->size : 1) * sizeof(ccol_dll_node_t *));
+
+    ccol_status_t status = CCOL_STATUS_ALLOC;
+    if (!rehash->new_buckets || !rehash->ends || !rehash->nodes) goto cleanup;
+
+    size_t old_num_buckets = hash_table->num_buckets;
+    ccol__parallel_for(num_threads, old_num_buckets, ccol__parallel_rehash_count, rehash);
+    ccol__parallel_for(num_threads, new_num_buckets, ccol__parallel_rehash_totals, rehash);
+
+    size_t num_tasks = ccol__parallel_num_tasks(num_threads);
+    ccol__parallel_exclusive_scan(rehash->block_entries, num_tasks);
+    size_t num_headers = ccol__parallel_exclusive_scan(rehash->block_headers, num_tasks);
+
+    ccol__slab_t *bucket_slab = ccol__hash_table_slab(&hash_table->bucket_slab, sizeof(ccol_dll_t));
+    rehash->headers = bucket_slab && num_headers ? ccol__slab_alloc_run(bucket_slab, num_headers) : NULL;
+    if (num_headers && !rehash->headers) goto cleanup;
+
+    // Nothing below can fail; the old chains are only read until the link pass
+    ccol__parallel_for(num_threads, new_num_buckets, ccol__parallel_rehash_offsets, rehash);
+    ccol__parallel_for(num_threads, old_num_buckets, ccol__parallel_rehash_scatter, rehash);
+
+    for (size_t i = 0; i < old_num_buckets; i++) {
+        if (hash_table->buckets[i]) ccol__slab_release(hash_table->bucket_slab, hash_table->buckets[i]);
+    }
+
+    ccol__parallel_for(num_threads, new_num_buckets, ccol__parallel_rehash_link, rehash);
+
+    free(hash_table->buckets);
+    hash_table->buckets = rehash->new_buckets;
+    hash_table->num_buckets = new_num_buckets;
+    rehash->new_buckets = NULL;
+    status = CCOL_STATUS_OK;
+
+cleanup:
+    free(rehash->new_buckets);
+    free(rehash->ends);
+    free(rehash->nodes);
+    free(rehash);
+    return status;
+}
+
+// Chained only: dest is empty with src's bucket count and src has no migration in flight.
+// Copies entries shallowly; ccol__hash_table_deep_copy_parallel then replaces keys/values.
+ccol_status_t ccol__hash_table_clone_entries_parallel(ccol_hash_table_t *dest, const ccol_hash_table_t *src, size_t num_threads) {
+    ccol__parallel_clone_t *clone = calloc(1, sizeof(ccol__parallel_clone_t));
+    if (!clone) return CCOL_STATUS_ALLOC;
+
+    clone->dest = dest;
+    clone->src = src;
+
+    ccol__parallel_for(num_threads, src->num_buckets, ccol__parallel_clone_totals, clone);
+
+    size_t num_tasks = ccol__parallel_num_tasks(num_threads);
+    size_t num_entries = ccol__parallel_exclusive_scan(clone->block_entries, num_tasks);
+    size_t num_headers = ccol__parallel_exclusive_scan(clone->block_headers, num_tasks);
+
+    ccol_status_t status = CCOL_STATUS_OK;
+    if (num_entries > 0) {
+        ccol__slab_t *entry_slab = ccol__hash_table_slab(&dest->entry_slab, sizeof(ccol_hash_entry_t));
+        ccol__slab_t *node_slab = ccol__hash_table_slab(&dest->node_slab, sizeof(ccol_dll_node_t));
+        ccol__slab_t *bucket_slab = ccol__hash_table_slab(&dest->bucket_slab, sizeof(ccol_dll_t));
+
+        clone->entries = entry_slab ? ccol__slab_alloc_run(entry_slab, num_entries) : NULL;
+        clone->nodes = node_slab ? ccol__slab_alloc_run(node_slab, num_entries) : NULL;
+        clone->headers = bucket_slab ? ccol__slab_alloc_run(bucket_slab, num_headers) : NULL;
+
+        if (clone->entries && clone->nodes && clone->headers) {
+            ccol__parallel_for(num_threads, src->num_buckets, ccol__parallel_clone_fill, clone);
+            dest->size = num_entries;
+        } else {
+            // Runs are returned whole by destroy; the table itself is still empty
+            status = CCOL_STATUS_ALLOC;
+        }
+    }
+
+    free(clone);
+    return status;
+}
+
+// Replaces every entry's key/value with the copier's copy. On failure the copies made so
+// far are freed and the table is emptied without touching the entries it shared.
+ccol_status_t ccol__hash_table_deep_copy_parallel(ccol_hash_table_t *hash_table, ccol_copy_t copier, size_t num_threads) {
+    ccol__parallel_deep_t *deep = calloc(1, sizeof(ccol__parallel_deep_t));
+    if (!deep) return CCOL_STATUS_ALLOC;
+
+    deep->hash_table = hash_table;
+    deep->copier = copier;
+
+    size_t end = ccol__parallel_walk_end(hash_table);
+    ccol__parallel_for(num_threads, end, ccol__parallel_deep, deep);
+
+    size_t num_tasks = ccol__parallel_num_tasks(num_threads);
+    bool failed = false;
+    for (size_t i = 0; i < num_tasks; i++) failed = failed || deep->failed[i];
+
+    if (failed) {
+        for (size_t i = 0; i < num_tasks && hash_table->freer.func; i++) {
+            size_t begin = ccol__parallel_range_begin(end, num_tasks, i);
+            size_t stop = ccol__parallel_range_begin(end, num_tasks, i + 1);
+            ccol__parallel_walk(hash_table, begin, stop, deep->replaced[i], ccol__parallel_free_visit, NULL);
+        }
+
+        ccol_free_t freer = hash_table->freer;
+        hash_table->freer = (ccol_free_t){0};
+        ccol_hash_table_clear(hash_table);
+        hash_table->freer = freer;
+    }
+
+    free(deep);
+    return failed ? CCOL_STATUS_COPY : CCOL_STATUS_OK;
+}
+
+// Runs the freer over every entry; the caller then drops the storage without it
+void ccol__hash_table_free_entries_parallel(ccol_hash_table_t *hash_table, size_t num_threads) {
+    ccol__parallel_for(num_threads, ccol__parallel_walk_end(hash_table), ccol__parallel_free, hash_table);
+}
@@ -0,0 +1,147 @@
+/*
+ * ccol/src/hash_table/stats.c
+ *
+ * Hash table distribution statistics.
+ *
+ * Every engine is viewed as a flat run of positions with a chain length
+ * each: a chained bucket's list size, or the probe length of the entry in
+ * an open-addressing slot. Max, mean, percentile and histogram all come
+ * from that one view; the chi-square score instead bins entries by the
+ * home bucket their hash picks, so it grades the hasher, not the engine.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "ccol/ccol_dll.h"
+#include "ccol/ccol_hash_table.h"
+#include "ccol/ccol_status.h"
+
+#include "internal.h"
+#include "internal_slab.h"
+#include "engines/swiss.h"
+#include "engines/robin_hood.h"
+
+#define CCOL__HASH_TABLE_STATS_PERCENTILE 99
+
+// Private
+static inline size_t ccol__hash_table_stats_positions(const ccol_hash_table_t *hash_table) {
+    return ccol__hash_table_is_open(hash_table) ? hash_table->num_buckets : ccol__hash_table_total_buckets(hash_table);
+}
+
+static size_t ccol__hash_table_chain_at(const ccol_hash_table_t *hash_table, size_t position) {
+    if (hash_table->engine == CCOL_HASH_TABLE_SWISS) return ccol__swiss_probe_length(hash_table, position);
+    if (hash_table->engine == CCOL_HASH_TABLE_ROBIN_HOOD) return ccol__robin_hood_probe_length(hash_table, position);
+
+    ccol_dll_t *bucket = ccol__hash_table_bucket_at(hash_table, position);
+    return bucket ? bucket->size : 0;
+}
+
+static inline double ccol__hash_table_chi_square_term(size_t observed, double expected) {
+    double delta = (double)observed - expected;
+    return delta * delta / expected;
+}
+
+// Chained entries already sit in their home bucket; open-addressing ones are binned by hash
+static ccol_status_t ccol__hash_table_chi_square(const ccol_hash_table_t *hash_table, double *chi_square_out) {
+    *chi_square_out = 0;
+
+    size_t num_bins = ccol__hash_table_stats_positions(hash_table);
+    if (hash_table->engine == CCOL_HASH_TABLE_SWISS) num_bins /= CCOL__SWISS_GROUP_WIDTH;
+    if (num_bins < 2 || hash_table->size == 0) return CCOL_STATUS_OK;
+
+    double expected = (double)hash_table->size / (double)num_bins;
+    double sum = 0;
+
+    if (!ccol__hash_table_is_open(hash_table)) {
+        for (size_t i = 0; i < num_bins; i++) {
+            sum += ccol__hash_table_chi_square_term(ccol__hash_table_chain_at(hash_table, i), expected);
+        }
+        *chi_square_out = sum / (double)(num_bins - 1);
+        return CCOL_STATUS_OK;
+    }
+
+    size_t *bins = calloc(num_bins, sizeof(size_t));
+    if (!bins) return CCOL_STATUS_ALLOC;
+
+    bool swiss = hash_table->engine == CCOL_HASH_TABLE_SWISS;
+    for (size_t i = 0; i < hash_table->num_buckets; i++) {
+        ccol_hash_entry_t *entry = ccol__hash_table_slot_entry(hash_table, i);
+        if (!entry) continue;
+        bins[swiss ? ccol__swiss_home_group(hash_table, entry->hash) : ccol__robin_hood_home_slot(hash_table, entry->hash)]++;
+    }
+
+    for (size_t i = 0; i < num_bins; i++) sum += ccol__hash_table_chi_square_term(bins[i], expected);
+    free(bins);
+
+    *chi_square_out = sum / (double)(num_bins - 1);
+    return CCOL_STATUS_OK;
+}
+
+static size_t ccol__hash_table_memory_bytes(const ccol_hash_table_t *hash_table) {
+    size_t bytes = sizeof(ccol_hash_table_t);
+
+    if (ccol__hash_table_is_open(hash_table)) {
+        return bytes + hash_table->num_buckets * (1 + sizeof(ccol_hash_entry_t) + hash_table->inline_key_size);
+    }
+
+    bytes += ccol__hash_table_total_buckets(hash_table) * sizeof(ccol_dll_t *);
+    if (hash_table->entry_slab) bytes += ccol__slab_footprint(hash_table->entry_slab);
+    if (hash_table->node_slab) bytes += ccol__slab_footprint(hash_table->node_slab);
+    if (hash_table->bucket_slab) bytes += ccol__slab_footprint(hash_table->bucket_slab);
+    return bytes;
+}
+
+// Public (internal to the library)
+ccol_status_t ccol__hash_table_collect_stats(const ccol_hash_table_t *hash_table, ccol_hash_table_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+
+    size_t positions = ccol__hash_table_stats_positions(hash_table);
+    stats->size = hash_table->size;
+    stats->num_buckets = positions;
+    stats->memory_bytes = ccol__hash_table_memory_bytes(hash_table);
+    stats->counters = hash_table->counters;
+
+    size_t chains = 0;
+    size_t total = 0;
+    for (size_t i = 0; i < positions; i++) {
+        size_t length = ccol__hash_table_chain_at(hash_table, i);
+        stats->chain_histogram[length < CCOL_HASH_TABLE_STATS_HISTOGRAM_SIZE ? length : CCOL_HASH_TABLE_STATS_HISTOGRAM_SIZE - 1]++;
+        if (length == 0) continue;
+
+        chains++;
+        total += length;
+        if (length > stats->max_chain) stats->max_chain = length;
+    }
+
+    stats->empty_buckets = stats->chain_histogram[0];
+    if (positions > 0) stats->empty_ratio = (double)stats->empty_buckets / (double)positions;
+    if (chains > 0) stats->mean_chain = (double)total / (double)chains;
+
+    // Exact percentile from a second pass over a histogram as long as the longest chain
+    if (chains > 0) {
+        size_t *lengths = calloc(stats->max_chain + 1, sizeof(size_t));
+        if (!lengths) return CCOL_STATUS_ALLOC;
+
+        for (size_t i = 0; i < positions; i++) lengths[ccol__hash_table_chain_at(hash_table, i)]++;
+
+        size_t needed = (chains * CCOL__HASH_TABLE_STATS_PERCENTILE + 99) / 100;
+        size_t seen = 0;
+        for (size_t length = 1; length <= stats->max_chain; length++) {
+            seen += lengths[length];
+            if (seen >= needed) {
+                stats->p99_chain = length;
+                break;
+            }
+        }
+        free(lengths);
+    }
+
+    return ccol__hash_table_chi_square(hash_table, &stats->chi_square);
+}
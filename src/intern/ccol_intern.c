@@ -0,0 +1,311 @@
+/*
+ * ccol/src/intern/ccol_intern.c
+ *
+ * String interning implementation.
+ *
+ * Slots cache each string's hash next to its id, so most probes are
+ * rejected without leaving the slot array; a hash hit is confirmed by
+ * length and prefix, and strings longer than the prefix finish with one
+ * memcmp against the arena.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "ccol/ccol_intern.h"
+#include "ccol/ccol_hash.h"
+#include "ccol/ccol_macros.h"
+#include "ccol/ccol_status.h"
+
+#include "robust.h"
+#include "secure.h"
+#include "internal_fibonacci.h"
+
+#define CCOL__INTERN_MIN_SLOTS 16
+#define CCOL__INTERN_MAX_ENTRIES ((size_t)UINT32_MAX - 1)
+
+// Private
+static inline uint32_t ccol__intern_hash(const ccol_intern_t *intern, const char *data, size_t length) {
+    if (intern->policy == CCOL_HASH_SECURE) return ccol__hash_secure_block(data, length, &intern->hash_key);
+    return ccol__hash_robust_block(data, length, intern->hash_key.k0);
+}
+
+static inline void ccol__intern_prefix(char *prefix, const char *data, size_t length) {
+    memset(prefix, 0, CCOL_INTERN_PREFIX_SIZE);
+    memcpy(prefix, data, length < CCOL_INTERN_PREFIX_SIZE ? length : CCOL_INTERN_PREFIX_SIZE);
+}
+
+static inline const char *ccol__intern_entry_str(const ccol_intern_t *intern, const ccol_intern_entry_t *entry) {
+    return intern->chunks[entry->chunk] + entry->offset;
+}
+
+static bool ccol__intern_matches(
+    const ccol_intern_t *intern,
+    const ccol_intern_entry_t *entry,
+    const char *data,
+    size_t length,
+    const char *prefix
+) {
+    if (entry->length != length) return false;
+    if (memcmp(entry->prefix, prefix, CCOL_INTERN_PREFIX_SIZE) != 0) return false;
+    if (length <= CCOL_INTERN_PREFIX_SIZE) return true;
+
+    const char *stored = ccol__intern_entry_str(intern, entry);
+    return memcmp(stored + CCOL_INTERN_PREFIX_SIZE, data + CCOL_INTERN_PREFIX_SIZE, length - CCOL_INTERN_PREFIX_SIZE) == 0;
+}
+
+// Slot holding the string, or the empty slot where it would go
+static size_t ccol__intern_probe(
+    const ccol_intern_t *intern,
+    const char *data,
+    size_t length,
+    uint32_t hash,
+    bool *found_out
+) {
+    char prefix[CCOL_INTERN_PREFIX_SIZE];
+    ccol__intern_prefix(prefix, data, length);
+
+    size_t mask = intern->num_slots - 1;
+    size_t index = ccol__fibonacci_home(hash, intern->num_slots);
+
+    for (;; index = (index + 1) & mask) {
+        const ccol_intern_slot_t *slot = &intern->slots[index];
+        if (slot->id_plus_one == 0) {
+            *found_out = false;
+            return index;
+        }
+        if (slot->hash != hash) continue;
+
+        if (ccol__intern_matches(intern, &intern->entries[slot->id_plus_one - 1], data, length, prefix)) {
+            *found_out = true;
+            return index;
+        }
+    }
+}
+
+// Stored hashes make growth a pure slot shuffle; no string is rehashed
+static ccol_status_t ccol__intern_grow_slots(ccol_intern_t *intern) {
+    if (intern->num_slots > SIZE_MAX / 2 / sizeof(ccol_intern_slot_t)) return CCOL_STATUS_OVERFLOW;
+
+    size_t num_slots = intern->num_slots * 2;
+    ccol_intern_slot_t *slots = calloc(num_slots, sizeof(ccol_intern_slot_t));
+    if (!slots) return CCOL_STATUS_ALLOC;
+
+    size_t mask = num_slots - 1;
+    for (size_t i = 0; i < intern->num_slots; i++) {
+        ccol_intern_slot_t slot = intern->slots[i];
+        if (slot.id_plus_one == 0) continue;
+
+        size_t index = ccol__fibonacci_home(slot.hash, num_slots);
+        while (slots[index].id_plus_one != 0) index = (index + 1) & mask;
+        slots[index] = slot;
+    }
+
+    free(intern->slots);
+    intern->slots = slots;
+    intern->num_slots = num_slots;
+    return CCOL_STATUS_OK;
+}
+
+// Copies the string (plus a NUL) into the arena, opening a new chunk when it does not fit
+static ccol_status_t ccol__intern_store(ccol_intern_t *intern, const char *data, size_t length, ccol_intern_entry_t *entry) {
+    size_t needed = length + 1;
+
+    if (intern->num_chunks == 0 || intern->chunk_size - intern->chunk_used < needed) {
+        if (intern->num_chunks >= UINT32_MAX) return CCOL_STATUS_OVERFLOW;
+
+        if (intern->num_chunks == intern->chunks_capacity) {
+            size_t capacity = intern->chunks_capacity ? intern->chunks_capacity * 2 : 8;
+            char **chunks = realloc(intern->chunks, capacity * sizeof(char *));
+            if (!chunks) return CCOL_STATUS_ALLOC;
+            intern->chunks = chunks;
+            intern->chunks_capacity = capacity;
+        }
+
+        size_t chunk_size = needed > CCOL_INTERN_CHUNK_SIZE ? needed : CCOL_INTERN_CHUNK_SIZE;
+        char *chunk = malloc(chunk_size);
+        if (!chunk) return CCOL_STATUS_ALLOC;
+
+        intern->chunks[intern->num_chunks++] = chunk;
+        intern->chunk_size = chunk_size;
+        intern->chunk_used = 0;
+    }
+
+    char *dest = intern->chunks[intern->num_chunks - 1] + intern->chunk_used;
+    memcpy(dest, data, length);
+    dest[length] = '\0';
+
+    entry->chunk = (uint32_t)(intern->num_chunks - 1);
+    entry->offset = (uint32_t)intern->chunk_used;
+    intern->chunk_used += needed;
+    intern->arena_bytes += needed;
+
+    return CCOL_STATUS_OK;
+}
+
+// Create / Initialize
+ccol_status_t ccol_intern_init(ccol_intern_t *intern, ccol_hash_policy_t policy) {
+    if (!intern) return CCOL_STATUS_INVALID_ARG;
+    if (policy != CCOL_HASH_ROBUST && policy != CCOL_HASH_SECURE) return CCOL_STATUS_HASH_POLICY;
+
+    memset(intern, 0, sizeof(*intern));
+    intern->policy = policy;
+
+    if (policy == CCOL_HASH_SECURE) {
+        ccol_status_t status = ccol_hash_key_random(&intern->hash_key);
+        if (status != CCOL_STATUS_OK) return status;
+    }
+
+    intern->slots = calloc(CCOL__INTERN_MIN_SLOTS, sizeof(ccol_intern_slot_t));
+    if (!intern->slots) return CCOL_STATUS_ALLOC;
+    intern->num_slots = CCOL__INTERN_MIN_SLOTS;
+
+    intern->is_initialized = true;
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_intern_create(ccol_intern_t **intern_out, ccol_hash_policy_t policy) {
+    if (!intern_out) return CCOL_STATUS_INVALID_ARG;
+
+    ccol_intern_t *intern = malloc(sizeof(ccol_intern_t));
+    if (!intern) return CCOL_STATUS_ALLOC;
+
+    ccol_status_t status = ccol_intern_init(intern, policy);
+    if (status != CCOL_STATUS_OK) {
+        free(intern);
+        return status;
+    }
+
+    *intern_out = intern;
+    return CCOL_STATUS_OK;
+}
+
+// Insertion
+ccol_status_t ccol_intern_n(ccol_intern_t *intern, const char *data, size_t length, ccol_intern_id_t *id_out) {
+    CCOL_CHECK_INIT(intern);
+    if (!data && length > 0) return CCOL_STATUS_INVALID_ARG;
+    if (length >= UINT32_MAX) return CCOL_STATUS_OVERFLOW;
+    if (!data) data = "";
+
+    uint32_t hash = ccol__intern_hash(intern, data, length);
+
+    bool found = false;
+    size_t index = ccol__intern_probe(intern, data, length, hash, &found);
+    if (found) {
+        if (id_out) *id_out = intern->slots[index].id_plus_one - 1;
+        return CCOL_STATUS_OK;
+    }
+
+    if (intern->size >= CCOL__INTERN_MAX_ENTRIES) return CCOL_STATUS_FULL;
+
+    // Grow before inserting: a table left past its load limit by a failed grow could fill up,
+    // and a probe over a full table never finds an empty slot
+    if ((double)(intern->size + 1) > (double)intern->num_slots * CCOL_INTERN_MAX_LOAD_FACTOR) {
+        ccol_status_t status = ccol__intern_grow_slots(intern);
+        if (status != CCOL_STATUS_OK) return status;
+        index = ccol__intern_probe(intern, data, length, hash, &found);
+    }
+
+    if (intern->size == intern->entries_capacity) {
+        size_t capacity = intern->entries_capacity ? intern->entries_capacity * 2 : 16;
+        ccol_intern_entry_t *entries = realloc(intern->entries, capacity * sizeof(ccol_intern_entry_t));
+        if (!entries) return CCOL_STATUS_ALLOC;
+        intern->entries = entries;
+        intern->entries_capacity = capacity;
+    }
+
+    ccol_intern_entry_t *entry = &intern->entries[intern->size];
+    ccol_status_t status = ccol__intern_store(intern, data, length, entry);
+    if (status != CCOL_STATUS_OK) return status;
+
+    entry->hash = hash;
+    entry->length = (uint32_t)length;
+    ccol__intern_prefix(entry->prefix, data, length);
+
+    ccol_intern_id_t id = (ccol_intern_id_t)intern->size;
+    intern->slots[index].id_plus_one = id + 1;
+    intern->slots[index].hash = hash;
+    intern->size++;
+
+    if (id_out) *id_out = id;
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_intern(ccol_intern_t *intern, const char *str, ccol_intern_id_t *id_out) {
+    if (!str) return CCOL_STATUS_INVALID_ARG;
+    return ccol_intern_n(intern, str, strlen(str), id_out);
+}
+
+// Access
+ccol_status_t ccol_intern_find_n(
+    const ccol_intern_t *intern,
+    const char *data,
+    size_t length,
+    ccol_intern_id_t *id_out
+) {
+    CCOL_CHECK_INIT(intern);
+    if (!data && length > 0) return CCOL_STATUS_INVALID_ARG;
+    if (length >= UINT32_MAX) return CCOL_STATUS_NOT_FOUND;
+    if (!data) data = "";
+
+    bool found = false;
+    size_t index = ccol__intern_probe(intern, data, length, ccol__intern_hash(intern, data, length), &found);
+    if (!found) return CCOL_STATUS_NOT_FOUND;
+
+    if (id_out) *id_out = intern->slots[index].id_plus_one - 1;
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_intern_find(const ccol_intern_t *intern, const char *str, ccol_intern_id_t *id_out) {
+    if (!str) return CCOL_STATUS_INVALID_ARG;
+    return ccol_intern_find_n(intern, str, strlen(str), id_out);
+}
+
+const char *ccol_intern_str(const ccol_intern_t *intern, ccol_intern_id_t id) {
+    if (!intern || !intern->is_initialized || id >= intern->size) return NULL;
+    return ccol__intern_entry_str(intern, &intern->entries[id]);
+}
+
+size_t ccol_intern_length(const ccol_intern_t *intern, ccol_intern_id_t id) {
+    if (!intern || !intern->is_initialized || id >= intern->size) return 0;
+    return intern->entries[id].length;
+}
+
+// Attributes
+size_t ccol_intern_size(const ccol_intern_t *intern) {
+    if (!intern || !intern->is_initialized) return 0;
+    return intern->size;
+}
+
+size_t ccol_intern_arena_bytes(const ccol_intern_t *intern) {
+    if (!intern || !intern->is_initialized) return 0;
+    return intern->arena_bytes;
+}
+
+// Cleanup
+ccol_status_t ccol_intern_destroy(ccol_intern_t *intern) {
+    CCOL_CHECK_INIT(intern);
+
+    for (size_t i = 0; i < intern->num_chunks; i++) free(intern->chunks[i]);
+    free(intern->chunks);
+    free(intern->entries);
+    free(intern->slots);
+
+    memset(intern, 0, sizeof(*intern));
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_intern_free(ccol_intern_t **intern_ptr) {
+    if (!intern_ptr || !*intern_ptr) return CCOL_STATUS_INVALID_ARG;
+
+    ccol_status_t status = ccol_intern_destroy(*intern_ptr);
+    free(*intern_ptr);
+    *intern_ptr = NULL;
+    return status;
+}
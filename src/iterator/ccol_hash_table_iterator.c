@@ -7,12 +7,209 @@
  * Copyright (C) 2025 Jack Einbinder
  */
 
-#include "ccol/ccol_iterator.h"
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "ccol/ccol_dll.h"
+#include "ccol/ccol_hash_table.h"
 #include "ccol/ccol_hash_table_iterator.h"
+#include "ccol/ccol_iterator.h"
+#include "ccol/ccol_macros.h"
+#include "ccol/ccol_status.h"
+
+#include "hash_table/internal.h"
+
+typedef enum ccol__hash_table_iterator_mode {
+    CCOL__HASH_TABLE_ITERATE_VALUES,
+    CCOL__HASH_TABLE_ITERATE_KEYS,
+    CCOL__HASH_TABLE_ITERATE_ITEMS,
+} ccol__hash_table_iterator_mode_t;
+
+// Iterator and its state share one allocation
+typedef struct ccol__hash_table_iterator {
+    ccol_iterator_t iter;
+    ccol_hash_table_cursor_t cursor;
+    ccol_kv_pair_t *pending;  // looked ahead by has_next, not yet returned
+    bool has_pending;
+    ccol__hash_table_iterator_mode_t mode;
+} ccol__hash_table_iterator_t;
+
+// Private
+static inline size_t ccol__hash_table_cursor_end(const ccol_hash_table_t *hash_table) {
+    return ccol__hash_table_is_open(hash_table) ? hash_table->num_buckets : ccol__hash_table_total_buckets(hash_table);
+}
+
+static inline ccol_kv_pair_t *ccol__hash_table_cursor_yield(ccol_hash_table_cursor_t *cursor, const ccol_hash_entry_t *entry) {
+    cursor->item.key = entry->key;
+    cursor->item.value = entry->value;
+    return &cursor->item;
+}
+
+// Entries in one bucket; 0 or 1 for open-addressing slots
+static size_t ccol__hash_table_bucket_count(const ccol_hash_table_t *hash_table, size_t position) {
+    if (ccol__hash_table_is_open(hash_table)) return ccol__hash_table_slot_entry(hash_table, position) ? 1 : 0;
+
+    ccol_dll_t *bucket = ccol__hash_table_bucket_at(hash_table, position);
+    return bucket ? bucket->size : 0;
+}
+
+static bool ccol__hash_table_iterator_has_next(ccol_iterator_t *iter) {
+    if (!iter) return false;
+    ccol__hash_table_iterator_t *self = (ccol__hash_table_iterator_t *)iter;
+
+    if (!self->has_pending) {
+        self->pending = ccol_hash_table_cursor_next(&self->cursor);
+        self->has_pending = true;
+    }
+    return self->pending != NULL;
+}
+
+static void *ccol__hash_table_iterator_next(ccol_iterator_t *iter) {
+    if (!ccol__hash_table_iterator_has_next(iter)) return NULL;
+    ccol__hash_table_iterator_t *self = (ccol__hash_table_iterator_t *)iter;
+
+    self->has_pending = false;
+    switch (self->mode) {
+        case CCOL__HASH_TABLE_ITERATE_KEYS:  return self->pending->key;
+        case CCOL__HASH_TABLE_ITERATE_ITEMS: return self->pending;
+        default:                            return self->pending->value;
+    }
+}
+
+static void ccol__hash_table_iterator_destroy(ccol_iterator_t *iter) {
+    free(iter);
+}
+
+static ccol_iterator_t *ccol__hash_table_iterator_create(
+    const ccol_hash_table_t *hash_table,
+    ccol__hash_table_iterator_mode_t mode
+) {
+    if (!hash_table || !hash_table->is_initialized) return NULL;
+
+    ccol__hash_table_iterator_t *self = calloc(1, sizeof(ccol__hash_table_iterator_t));
+    if (!self) return NULL;
+
+    ccol_hash_table_cursor_init(&self->cursor, hash_table);
+    self->mode = mode;
+
+    self->iter.container = (void *)hash_table;
+    self->iter.state = &self->cursor;
+    self->iter.has_next = ccol__hash_table_iterator_has_next;
+    self->iter.next = ccol__hash_table_iterator_next;
+    self->iter.destroy = ccol__hash_table_iterator_destroy;
+
+    return &self->iter;
+}
+
+// Cursor
+ccol_status_t ccol_hash_table_cursor_init(ccol_hash_table_cursor_t *cursor, const ccol_hash_table_t *hash_table) {
+    if (!cursor) return CCOL_STATUS_INVALID_ARG;
+    *cursor = (ccol_hash_table_cursor_t){0};
+    CCOL_CHECK_INIT(hash_table);
+
+    cursor->hash_table = hash_table;
+    return CCOL_STATUS_OK;
+}
+
+// By value for loop initializers; an unusable table yields a cursor with no hash_table
+ccol_hash_table_cursor_t ccol_hash_table_cursor_begin(const ccol_hash_table_t *hash_table) {
+    ccol_hash_table_cursor_t cursor;
+    ccol_hash_table_cursor_init(&cursor, hash_table);
+    return cursor;
+}
+
+ccol_status_t ccol_hash_table_cursor_seek(ccol_hash_table_cursor_t *cursor, size_t position) {
+    if (!cursor) return CCOL_STATUS_INVALID_ARG;
+    CCOL_CHECK_INIT(cursor->hash_table);
+    if (position > ccol__hash_table_cursor_end(cursor->hash_table)) return CCOL_STATUS_OUT_OF_BOUNDS;
+
+    cursor->position = position;
+    cursor->node = NULL;
+    return CCOL_STATUS_OK;
+}
+
+ccol_kv_pair_t *ccol_hash_table_cursor_next(ccol_hash_table_cursor_t *cursor) {
+    if (!cursor || !cursor->hash_table) return NULL;
+    const ccol_hash_table_t *hash_table = cursor->hash_table;
+
+    if (cursor->node) {
+        ccol_dll_node_t *node = cursor->node;
+        cursor->node = node->next;
+        return ccol__hash_table_cursor_yield(cursor, (const ccol_hash_entry_t *)node->data);
+    }
+
+    size_t end = ccol__hash_table_cursor_end(hash_table);
+
+    if (ccol__hash_table_is_open(hash_table)) {
+        while (cursor->position < end) {
+            ccol_hash_entry_t *entry = ccol__hash_table_slot_entry(hash_table, cursor->position++);
+            if (entry) return ccol__hash_table_cursor_yield(cursor, entry);
+        }
+        return NULL;
+    }
+
+    while (cursor->position < end) {
+        ccol_dll_t *bucket = ccol__hash_table_bucket_at(hash_table, cursor->position++);
+        if (!bucket || !bucket->head) continue;
+
+        cursor->node = bucket->head->next;
+        return ccol__hash_table_cursor_yield(cursor, (const ccol_hash_entry_t *)bucket->head->data);
+    }
+
+    return NULL;
+}
+
+ccol_status_t ccol_hash_table_scan(
+    const ccol_hash_table_t *hash_table,
+    size_t *position,
+    ccol_kv_pair_t *items_out,
+    size_t capacity,
+    size_t *count_out
+) {
+    CCOL_CHECK_INIT(hash_table);
+    if (!position || !count_out || (!items_out && capacity > 0)) return CCOL_STATUS_INVALID_ARG;
+
+    *count_out = 0;
+    size_t end = ccol__hash_table_cursor_end(hash_table);
+    if (*position > end) return CCOL_STATUS_OUT_OF_BOUNDS;
+
+    ccol_hash_table_cursor_t cursor;
+    ccol_hash_table_cursor_init(&cursor, hash_table);
+    cursor.position = *position;
+
+    size_t count = 0;
+    while (cursor.position < end) {
+        size_t bucket_count = ccol__hash_table_bucket_count(hash_table, cursor.position);
+        if (bucket_count > capacity - count) {
+            if (count == 0) return CCOL_STATUS_FULL;
+            break;
+        }
+
+        // Drain exactly this bucket; the cursor stops at the next non-empty one otherwise
+        size_t stop = cursor.position + 1;
+        for (size_t i = 0; i < bucket_count; i++) items_out[count++] = *ccol_hash_table_cursor_next(&cursor);
+        cursor.position = stop;
+        cursor.node = NULL;
+    }
+
+    *position = cursor.position < end ? cursor.position : 0;
+    *count_out = count;
+    return CCOL_STATUS_OK;
+}
 
 // Iterator
-ccol_iterator_t *ccol_hash_table_iterator_create(const ccol_hash_table_t *hash_table);
-ccol_iterator_t *ccol_hash_table_keys(const ccol_hash_table_t *hash_table);
-ccol_iterator_t *ccol_hash_table_values(const ccol_hash_table_t *hash_table);
-ccol_iterator_t *ccol_hash_table_items(const ccol_hash_table_t *hash_table);
+ccol_iterator_t *ccol_hash_table_iterator_create(const ccol_hash_table_t *hash_table) {
+    return ccol__hash_table_iterator_create(hash_table, CCOL__HASH_TABLE_ITERATE_VALUES);
+}
+
+ccol_iterator_t *ccol_hash_table_keys(const ccol_hash_table_t *hash_table) {
+    return ccol__hash_table_iterator_create(hash_table, CCOL__HASH_TABLE_ITERATE_KEYS);
+}
+
+ccol_iterator_t *ccol_hash_table_values(const ccol_hash_table_t *hash_table) {
+    return ccol__hash_table_iterator_create(hash_table, CCOL__HASH_TABLE_ITERATE_VALUES);
+}
 
+ccol_iterator_t *ccol_hash_table_items(const ccol_hash_table_t *hash_table) {
+    return ccol__hash_table_iterator_create(hash_table, CCOL__HASH_TABLE_ITERATE_ITEMS);
+}
@@ -0,0 +1,321 @@
+/*
+ * ccol/src/lru/ccol_lru.c
+ *
+ * Bounded least-recently-used cache implementation.
+ *
+ * The index's values point at slab nodes rather than holding the links in
+ * ccol_hash_entry_t itself: the open-addressing engines move entries when
+ * they resize or shift, while a node stays put for as long as it is cached.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "ccol/ccol_lru.h"
+#include "ccol/ccol_comparator.h"
+#include "ccol/ccol_hash_table.h"
+#include "ccol/ccol_macros.h"
+#include "ccol/ccol_status.h"
+
+#include "hash_table/internal.h"
+#include "internal_slab.h"
+
+#define CCOL__LRU_MIN_BUCKETS 16
+
+// Private
+static void ccol__lru_unlink(ccol_lru_t *lru, ccol_lru_node_t *node) {
+    if (node->newer) node->newer->older = node->older;
+    else lru->newest = node->older;
+
+    if (node->older) node->older->newer = node->newer;
+    else lru->oldest = node->newer;
+}
+
+static void ccol__lru_push_newest(ccol_lru_t *lru, ccol_lru_node_t *node) {
+    node->newer = NULL;
+    node->older = lru->newest;
+
+    if (lru->newest) lru->newest->newer = node;
+    else lru->oldest = node;
+
+    lru->newest = node;
+}
+
+static inline void ccol__lru_release(const ccol_lru_t *lru, void *key, void *value, uint32_t hash) {
+    if (!lru->evictor.func) return;
+
+    ccol_hash_entry_t entry = { .key = key, .value = value, .hash = hash };
+    lru->evictor.func(&entry, lru->evictor.ctx);
+}
+
+static void ccol__lru_drop(ccol_lru_t *lru, ccol_lru_node_t *node) {
+    ccol__lru_unlink(lru, node);
+    (void)ccol__hash_table_remove_hashed(lru->index, node->key, node->hash);
+
+    lru->size--;
+    lru->cost -= node->cost;
+
+    ccol__lru_release(lru, node->key, node->value, node->hash);
+    ccol__slab_release(lru->node_slab, node);
+}
+
+static inline bool ccol__lru_over_limit(const ccol_lru_t *lru) {
+    return (lru->max_size && lru->size > lru->max_size) || (lru->max_cost && lru->cost > lru->max_cost);
+}
+
+static void ccol__lru_trim(ccol_lru_t *lru) {
+    while (lru->oldest && ccol__lru_over_limit(lru)) ccol__lru_drop(lru, lru->oldest);
+}
+
+static ccol_lru_node_t *ccol__lru_find(const ccol_lru_t *lru, const void *key) {
+    ccol_hash_entry_t *entry = NULL;
+    if (ccol__hash_table_get_entry(lru->index, key, &entry) != CCOL_STATUS_OK) return NULL;
+    return (ccol_lru_node_t *)entry->value;
+}
+
+// Create / Initialize
+ccol_status_t ccol_lru_init(
+    ccol_lru_t *lru,
+    size_t max_size,
+    size_t max_cost,
+    size_t key_size,
+    ccol_hash_table_engine_t engine,
+    ccol_hash_policy_t policy,
+    ccol_hash_t hasher,
+    ccol_comparator_t key_cmp,
+    ccol_free_t evictor
+) {
+    if (!lru) return CCOL_STATUS_INVALID_ARG;
+    if (!key_cmp.func) return CCOL_STATUS_COMPARATOR_FUNC;
+
+    *lru = (ccol_lru_t){0};
+    lru->max_size = max_size;
+    lru->max_cost = max_cost;
+    lru->key_cmp = key_cmp;
+    lru->evictor = evictor;
+
+    lru->node_slab = malloc(sizeof(ccol__slab_t));
+    if (!lru->node_slab) return CCOL_STATUS_ALLOC;
+    ccol__slab_init(lru->node_slab, sizeof(ccol_lru_node_t));
+
+    // The index only maps keys to nodes; the cache owns keys and values
+    ccol_status_t status = ccol_hash_table_create_with_engine(
+        &lru->index,
+        CCOL__LRU_MIN_BUCKETS,
+        key_size,
+        engine,
+        policy,
+        hasher,
+        (ccol_copy_t){0},
+        (ccol_free_t){0},
+        (ccol_print_t){0},
+        ccol_comparator_create(ccol_cmp_hash_entry_key, &lru->key_cmp)
+    );
+    if (status != CCOL_STATUS_OK) {
+        free(lru->node_slab);
+        lru->node_slab = NULL;
+        return status;
+    }
+
+    lru->is_initialized = true;
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_lru_create(
+    ccol_lru_t **lru_out,
+    size_t max_size,
+    size_t max_cost,
+    size_t key_size,
+    ccol_hash_table_engine_t engine,
+    ccol_hash_policy_t policy,
+    ccol_hash_t hasher,
+    ccol_comparator_t key_cmp,
+    ccol_free_t evictor
+) {
+    if (!lru_out) return CCOL_STATUS_INVALID_ARG;
+
+    ccol_lru_t *lru = malloc(sizeof(ccol_lru_t));
+    if (!lru) return CCOL_STATUS_ALLOC;
+
+    ccol_status_t status = ccol_lru_init(lru, max_size, max_cost, key_size, engine, policy, hasher, key_cmp, evictor);
+    if (status != CCOL_STATUS_OK) {
+        free(lru);
+        return status;
+    }
+
+    *lru_out = lru;
+    return CCOL_STATUS_OK;
+}
+
+// Insertion
+ccol_status_t ccol_lru_put(ccol_lru_t *lru, void *key, void *value, size_t cost) {
+    CCOL_CHECK_INIT(lru);
+    if (!key) return CCOL_STATUS_INVALID_ARG;
+    if (lru->max_cost && cost > lru->max_cost) return CCOL_STATUS_FULL;
+
+    uint32_t hash = lru->index->hasher.func(key, lru->index->hasher.ctx);
+    ccol_hash_entry_t *entry = ccol__hash_table_find_hashed(lru->index, key, hash);
+
+    if (entry) {
+        ccol_lru_node_t *node = (ccol_lru_node_t *)entry->value;
+        if (cost > node->cost && cost - node->cost > SIZE_MAX - lru->cost) return CCOL_STATUS_OVERFLOW;
+
+        void *old_key = node->key;
+        void *old_value = node->value;
+
+        // Equal keys share a hash and a slot, so the index can take the new pointer in place
+        entry->key = key;
+        node->key = key;
+        node->value = value;
+        lru->cost = lru->cost - node->cost + cost;
+        node->cost = cost;
+
+        ccol__lru_unlink(lru, node);
+        ccol__lru_push_newest(lru, node);
+
+        if (old_key != key || old_value != value) ccol__lru_release(lru, old_key, old_value, hash);
+        ccol__lru_trim(lru);
+        return CCOL_STATUS_OK;
+    }
+
+    if (cost > SIZE_MAX - lru->cost) return CCOL_STATUS_OVERFLOW;
+
+    ccol_lru_node_t *node = ccol__slab_alloc(lru->node_slab);
+    if (!node) return CCOL_STATUS_ALLOC;
+
+    node->key = key;
+    node->value = value;
+    node->cost = cost;
+    node->hash = hash;
+
+    ccol_status_t status = ccol__hash_table_insert_hashed(lru->index, key, node, hash);
+    if (status != CCOL_STATUS_OK) {
+        ccol__slab_release(lru->node_slab, node);
+        return status;
+    }
+
+    ccol__lru_push_newest(lru, node);
+    lru->size++;
+    lru->cost += cost;
+
+    // The new node is newest and fits on its own, so trimming never reaches it
+    ccol__lru_trim(lru);
+    return CCOL_STATUS_OK;
+}
+
+// Removal
+ccol_status_t ccol_lru_remove(ccol_lru_t *lru, const void *key) {
+    CCOL_CHECK_INIT(lru);
+    if (!key) return CCOL_STATUS_INVALID_ARG;
+
+    ccol_lru_node_t *node = ccol__lru_find(lru, key);
+    if (!node) return CCOL_STATUS_NOT_FOUND;
+
+    ccol__lru_drop(lru, node);
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_lru_evict_oldest(ccol_lru_t *lru) {
+    CCOL_CHECK_INIT(lru);
+    if (!lru->oldest) return CCOL_STATUS_EMPTY;
+
+    ccol__lru_drop(lru, lru->oldest);
+    return CCOL_STATUS_OK;
+}
+
+// Access
+ccol_status_t ccol_lru_get(ccol_lru_t *lru, const void *key, void **value_out) {
+    CCOL_CHECK_INIT(lru);
+    if (!key) return CCOL_STATUS_INVALID_ARG;
+
+    ccol_lru_node_t *node = ccol__lru_find(lru, key);
+    if (!node) return CCOL_STATUS_NOT_FOUND;
+
+    if (node != lru->newest) {
+        ccol__lru_unlink(lru, node);
+        ccol__lru_push_newest(lru, node);
+    }
+
+    if (value_out) *value_out = node->value;
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_lru_peek(const ccol_lru_t *lru, const void *key, void **value_out) {
+    CCOL_CHECK_INIT(lru);
+    if (!key) return CCOL_STATUS_INVALID_ARG;
+
+    ccol_lru_node_t *node = ccol__lru_find(lru, key);
+    if (!node) return CCOL_STATUS_NOT_FOUND;
+
+    if (value_out) *value_out = node->value;
+    return CCOL_STATUS_OK;
+}
+
+bool ccol_lru_contains(const ccol_lru_t *lru, const void *key) {
+    if (!lru || !lru->is_initialized || !key) return false;
+    return ccol__lru_find(lru, key) != NULL;
+}
+
+// Attributes
+size_t ccol_lru_size(const ccol_lru_t *lru) {
+    if (!lru || !lru->is_initialized) return 0;
+    return lru->size;
+}
+
+size_t ccol_lru_cost(const ccol_lru_t *lru) {
+    if (!lru || !lru->is_initialized) return 0;
+    return lru->cost;
+}
+
+ccol_status_t ccol_lru_set_capacity(ccol_lru_t *lru, size_t max_size, size_t max_cost) {
+    CCOL_CHECK_INIT(lru);
+
+    lru->max_size = max_size;
+    lru->max_cost = max_cost;
+    ccol__lru_trim(lru);
+
+    return CCOL_STATUS_OK;
+}
+
+// Cleanup
+ccol_status_t ccol_lru_clear(ccol_lru_t *lru) {
+    CCOL_CHECK_INIT(lru);
+
+    for (ccol_lru_node_t *node = lru->oldest; node; node = node->newer) {
+        ccol__lru_release(lru, node->key, node->value, node->hash);
+    }
+
+    ccol_status_t status = ccol_hash_table_clear(lru->index);
+    ccol__slab_destroy(lru->node_slab);
+
+    lru->newest = lru->oldest = NULL;
+    lru->size = 0;
+    lru->cost = 0;
+
+    return status;
+}
+
+ccol_status_t ccol_lru_destroy(ccol_lru_t *lru) {
+    CCOL_CHECK_INIT(lru);
+
+    ccol_status_t status = ccol_lru_clear(lru);
+    ccol_hash_table_free(&lru->index);
+    free(lru->node_slab);
+
+    *lru = (ccol_lru_t){0};
+    return status;
+}
+
+ccol_status_t ccol_lru_free(ccol_lru_t **lru_ptr) {
+    if (!lru_ptr || !*lru_ptr) return CCOL_STATUS_INVALID_ARG;
+
+    ccol_status_t status = ccol_lru_destroy(*lru_ptr);
+    free(*lru_ptr);
+    *lru_ptr = NULL;
+    return status;
+}
@@ -0,0 +1,396 @@
+/*
+ * ccol/src/mph/ccol_mph.c
+ *
+ * Minimal perfect hash implementation.
+ *
+ * Each key gets a 64-bit hash from two seeded calls of the policy's hash
+ * function; 32 bits alone would collide between distinct keys once sets
+ * reach tens of thousands. The hash picks the bucket, and the same hash
+ * mixed with the bucket's pilot picks the slot. Buckets are placed
+ * largest first, each trying pilots until every key lands on a free slot.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "ccol/ccol_mph.h"
+#include "ccol/ccol_hash.h"
+#include "ccol/ccol_hash_table.h"
+#include "ccol/ccol_macros.h"
+#include "ccol/ccol_status.h"
+
+#define CCOL__MPH_MAX_PILOT UINT16_MAX
+#define CCOL__MPH_SEED_ATTEMPTS 8
+
+// Share of keys sent to the dense buckets, as a fraction of 2^32
+#define CCOL__MPH_DENSE_KEYS ((uint64_t)(0.6 * 4294967296.0))
+#define CCOL__MPH_DENSE_BUCKETS 0.3
+
+// Private
+static inline uint64_t ccol__mph_mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+static inline uint64_t ccol__mph_hash(const ccol_mph_t *mph, const void *key) {
+    void *ctx0 = (void *)&mph->hash_keys[0];
+    void *ctx1 = (void *)&mph->hash_keys[1];
+    return ((uint64_t)mph->hash_func(key, ctx0) << 32) | mph->hash_func(key, ctx1);
+}
+
+static inline size_t ccol__mph_bucket(const ccol_mph_t *mph, uint64_t hash) {
+    // The low half picks the region, the high half the bucket within it
+    uint64_t high = hash >> 32;
+    if ((hash & 0xffffffffULL) < CCOL__MPH_DENSE_KEYS) return (size_t)((high * mph->num_dense_buckets) >> 32);
+    return mph->num_dense_buckets + (size_t)((high * (mph->num_buckets - mph->num_dense_buckets)) >> 32);
+}
+
+static inline size_t ccol__mph_slot(const ccol_mph_t *mph, uint64_t hash, uint16_t pilot) {
+    uint64_t mixed = ccol__mph_mix(hash ^ (pilot * 0x9E3779B97F4A7C15ULL));
+    return (size_t)(((mixed >> 32) * mph->num_slots) >> 32);
+}
+
+static inline size_t ccol__mph_index_of(const ccol_mph_t *mph, uint64_t hash) {
+    size_t slot = ccol__mph_slot(mph, hash, mph->pilots[ccol__mph_bucket(mph, hash)]);
+    return slot < mph->size ? slot : mph->remap[slot - mph->size];
+}
+
+static ccol_status_t ccol__mph_seed(ccol_mph_t *mph, unsigned attempt) {
+    if (mph->policy == CCOL_HASH_SECURE) {
+        ccol_status_t status = ccol_hash_key_random(&mph->hash_keys[0]);
+        if (status != CCOL_STATUS_OK) return status;
+        return ccol_hash_key_random(&mph->hash_keys[1]);
+    }
+
+    // Deterministic for ROBUST, so rebuilding the same set gives the same indices
+    for (unsigned j = 0; j < 2; j++) {
+        mph->hash_keys[j].k0 = ccol__mph_mix(((uint64_t)attempt << 1 | j) + 0x9E3779B97F4A7C15ULL);
+        mph->hash_keys[j].k1 = ccol__mph_mix(mph->hash_keys[j].k0);
+    }
+    return CCOL_STATUS_OK;
+}
+
+// Two keys of a bucket share a 64-bit hash: duplicates, or a seed to throw away
+static bool ccol__mph_has_duplicate(
+    const ccol_mph_t *mph,
+    void *const *keys,
+    const uint64_t *hashes,
+    const uint32_t *members,
+    size_t count
+) {
+    for (size_t a = 0; a < count; a++) {
+        for (size_t b = a + 1; b < count; b++) {
+            if (hashes[members[a]] != hashes[members[b]]) continue;
+            if (mph->comparator.func(keys[members[a]], keys[members[b]], mph->comparator.ctx) == 0) return true;
+        }
+    }
+    return false;
+}
+
+typedef struct ccol__mph_scratch {
+    uint64_t *hashes;         // per key
+    uint32_t *members;        // keys grouped by bucket
+    size_t *bucket_start;     // num_buckets + 1 offsets into members
+    uint32_t *order;          // buckets, largest first
+    uint64_t *taken;          // slot bitmap
+    size_t *positions;        // candidate slots for the bucket being placed
+} ccol__mph_scratch_t;
+
+static void ccol__mph_scratch_free(ccol__mph_scratch_t *scratch) {
+    free(scratch->hashes);
+    free(scratch->members);
+    free(scratch->bucket_start);
+    free(scratch->order);
+    free(scratch->taken);
+    free(scratch->positions);
+}
+
+// Groups keys by bucket and orders the buckets by decreasing size; returns the largest size
+static size_t ccol__mph_group(const ccol_mph_t *mph, ccol__mph_scratch_t *scratch, size_t n) {
+    size_t *start = scratch->bucket_start;
+    memset(start, 0, (mph->num_buckets + 1) * sizeof(size_t));
+
+    for (size_t i = 0; i < n; i++) start[ccol__mph_bucket(mph, scratch->hashes[i]) + 1]++;
+
+    size_t max_size = 0;
+    for (size_t b = 0; b < mph->num_buckets; b++) {
+        if (start[b + 1] > max_size) max_size = start[b + 1];
+        start[b + 1] += start[b];
+    }
+
+    // Counting sort: positions[] doubles as the per-bucket fill cursor
+    for (size_t b = 0; b < mph->num_buckets; b++) scratch->positions[b] = start[b];
+    for (size_t i = 0; i < n; i++) {
+        size_t b = ccol__mph_bucket(mph, scratch->hashes[i]);
+        scratch->members[scratch->positions[b]++] = (uint32_t)i;
+    }
+
+    // Counting sort of buckets by size, largest first
+    size_t *by_size = calloc(max_size + 2, sizeof(size_t));
+    if (!by_size) return SIZE_MAX;
+
+    for (size_t b = 0; b < mph->num_buckets; b++) by_size[max_size - (start[b + 1] - start[b]) + 1]++;
+    for (size_t s = 0; s <= max_size; s++) by_size[s + 1] += by_size[s];
+    for (size_t b = 0; b < mph->num_buckets; b++) {
+        scratch->order[by_size[max_size - (start[b + 1] - start[b])]++] = (uint32_t)b;
+    }
+
+    free(by_size);
+    return max_size;
+}
+
+// Finds a pilot that sends every key of the bucket to a distinct free slot
+static bool ccol__mph_place_bucket(ccol_mph_t *mph, ccol__mph_scratch_t *scratch, size_t bucket) {
+    const uint32_t *members = scratch->members + scratch->bucket_start[bucket];
+    size_t count = scratch->bucket_start[bucket + 1] - scratch->bucket_start[bucket];
+    size_t *positions = scratch->positions;
+    uint64_t *taken = scratch->taken;
+
+    for (uint32_t pilot = 0; pilot <= CCOL__MPH_MAX_PILOT; pilot++) {
+        size_t k = 0;
+        for (; k < count; k++) {
+            size_t slot = ccol__mph_slot(mph, scratch->hashes[members[k]], (uint16_t)pilot);
+            if ((taken[slot >> 6] >> (slot & 63)) & 1) break;
+
+            size_t j = 0;
+            while (j < k && positions[j] != slot) j++;
+            if (j < k) break;
+
+            positions[k] = slot;
+        }
+        if (k < count) continue;
+
+        for (k = 0; k < count; k++) taken[positions[k] >> 6] |= (uint64_t)1 << (positions[k] & 63);
+        mph->pilots[bucket] = (uint16_t)pilot;
+        return true;
+    }
+
+    return false;
+}
+
+static ccol_status_t ccol__mph_build(ccol_mph_t *mph, void *const *keys, size_t n) {
+    ccol__mph_scratch_t scratch = {0};
+    size_t words = (mph->num_slots + 63) / 64;
+
+    scratch.hashes = malloc(n * sizeof(uint64_t));
+    scratch.members = malloc(n * sizeof(uint32_t));
+    scratch.bucket_start = malloc((mph->num_buckets + 1) * sizeof(size_t));
+    scratch.order = malloc(mph->num_buckets * sizeof(uint32_t));
+    scratch.taken = malloc(words * sizeof(uint64_t));
+    scratch.positions = malloc((mph->num_buckets > n ? mph->num_buckets : n) * sizeof(size_t));
+
+    if (!scratch.hashes || !scratch.members || !scratch.bucket_start || !scratch.order ||
+        !scratch.taken || !scratch.positions) {
+        ccol__mph_scratch_free(&scratch);
+        return CCOL_STATUS_ALLOC;
+    }
+
+    ccol_status_t status = CCOL_STATUS_FULL;
+    for (unsigned attempt = 0; attempt < CCOL__MPH_SEED_ATTEMPTS && status == CCOL_STATUS_FULL; attempt++) {
+        status = ccol__mph_seed(mph, attempt);
+        if (status != CCOL_STATUS_OK) break;
+
+        for (size_t i = 0; i < n; i++) scratch.hashes[i] = ccol__mph_hash(mph, keys[i]);
+
+        if (ccol__mph_group(mph, &scratch, n) == SIZE_MAX) {
+            status = CCOL_STATUS_ALLOC;
+            break;
+        }
+
+        memset(scratch.taken, 0, words * sizeof(uint64_t));
+        for (size_t b = 0; b < mph->num_buckets && status == CCOL_STATUS_OK; b++) {
+            size_t bucket = scratch.order[b];
+            if (ccol__mph_place_bucket(mph, &scratch, bucket)) continue;
+
+            const uint32_t *members = scratch.members + scratch.bucket_start[bucket];
+            size_t count = scratch.bucket_start[bucket + 1] - scratch.bucket_start[bucket];
+            status = ccol__mph_has_duplicate(mph, keys, scratch.hashes, members, count)
+                ? CCOL_STATUS_ALREADY_EXISTS
+                : CCOL_STATUS_FULL;
+        }
+    }
+
+    if (status == CCOL_STATUS_OK) {
+        // Slots past size borrow the free slots below it, in order
+        size_t free_slot = 0;
+        for (size_t slot = mph->size; slot < mph->num_slots; slot++) {
+            if (!((scratch.taken[slot >> 6] >> (slot & 63)) & 1)) continue;
+            while ((scratch.taken[free_slot >> 6] >> (free_slot & 63)) & 1) free_slot++;
+            mph->remap[slot - mph->size] = (uint32_t)free_slot++;
+        }
+
+        for (size_t i = 0; i < n; i++) mph->keys[ccol__mph_index_of(mph, scratch.hashes[i])] = keys[i];
+    }
+
+    ccol__mph_scratch_free(&scratch);
+    return status;
+}
+
+// Create / Initialize
+ccol_status_t ccol_mph_init(
+    ccol_mph_t *mph,
+    size_t key_size,
+    ccol_hash_policy_t policy,
+    ccol_comparator_t comparator,
+    void *const *keys,
+    size_t n
+) {
+    if (!mph || (!keys && n > 0)) return CCOL_STATUS_INVALID_ARG;
+    if (policy != CCOL_HASH_ROBUST && policy != CCOL_HASH_SECURE) return CCOL_STATUS_HASH_POLICY;
+    if (!comparator.func) return CCOL_STATUS_COMPARATOR_FUNC;
+    if (n > UINT32_MAX) return CCOL_STATUS_OVERFLOW;
+
+    memset(mph, 0, sizeof(*mph));
+
+    ccol_status_t status = ccol_resolve_hash_func(key_size, policy, &mph->hash_func);
+    if (status != CCOL_STATUS_OK) return status;
+
+    mph->size = n;
+    mph->key_size = key_size;
+    mph->policy = policy;
+    mph->comparator = comparator;
+
+    // Enough spare slots that the last buckets still find room; the remap covers them
+    size_t num_slots = (size_t)((double)n / CCOL_MPH_LOAD_FACTOR) + 1;
+    mph->num_slots = num_slots > n ? num_slots : n;
+    mph->num_buckets = (n + CCOL_MPH_KEYS_PER_BUCKET - 1) / CCOL_MPH_KEYS_PER_BUCKET;
+    if (mph->num_buckets < 2) mph->num_buckets = 2;  // one dense, one sparse
+    mph->num_dense_buckets = (size_t)((double)mph->num_buckets * CCOL__MPH_DENSE_BUCKETS);
+    if (mph->num_dense_buckets == 0) mph->num_dense_buckets = 1;
+    if (mph->num_slots > UINT32_MAX) return CCOL_STATUS_OVERFLOW;
+
+    mph->pilots = calloc(mph->num_buckets, sizeof(uint16_t));
+    mph->remap = malloc((mph->num_slots - n + 1) * sizeof(uint32_t));
+    mph->keys = malloc((n > 0 ? n : 1) * sizeof(void *));
+    if (!mph->pilots || !mph->remap || !mph->keys) {
+        free(mph->pilots);
+        free(mph->remap);
+        free(mph->keys);
+        memset(mph, 0, sizeof(*mph));
+        return CCOL_STATUS_ALLOC;
+    }
+
+    status = n > 0 ? ccol__mph_build(mph, keys, n) : CCOL_STATUS_OK;
+    if (status != CCOL_STATUS_OK) {
+        free(mph->pilots);
+        free(mph->remap);
+        free(mph->keys);
+        memset(mph, 0, sizeof(*mph));
+        return status;
+    }
+
+    mph->is_initialized = true;
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_mph_create(
+    ccol_mph_t **mph_out,
+    size_t key_size,
+    ccol_hash_policy_t policy,
+    ccol_comparator_t comparator,
+    void *const *keys,
+    size_t n
+) {
+    if (!mph_out) return CCOL_STATUS_INVALID_ARG;
+
+    ccol_mph_t *mph = malloc(sizeof(ccol_mph_t));
+    if (!mph) return CCOL_STATUS_ALLOC;
+
+    ccol_status_t status = ccol_mph_init(mph, key_size, policy, comparator, keys, n);
+    if (status != CCOL_STATUS_OK) {
+        free(mph);
+        return status;
+    }
+
+    *mph_out = mph;
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_mph_create_from_hash_table(
+    ccol_mph_t **mph_out,
+    const ccol_hash_table_t *hash_table,
+    ccol_hash_policy_t policy,
+    ccol_comparator_t comparator
+) {
+    if (!mph_out) return CCOL_STATUS_INVALID_ARG;
+    CCOL_CHECK_INIT(hash_table);
+
+    void **keys = NULL;
+    size_t count = 0;
+    ccol_status_t status = ccol_hash_table_get_all_keys(hash_table, &keys, &count);
+    if (status != CCOL_STATUS_OK) return status;
+
+    status = ccol_mph_create(mph_out, hash_table->key_size, policy, comparator, keys, count);
+    free(keys);
+    return status;
+}
+
+// Access
+size_t ccol_mph_index_unchecked(const ccol_mph_t *mph, const void *key) {
+    if (!mph || !mph->is_initialized || mph->size == 0 || !key) return 0;
+    return ccol__mph_index_of(mph, ccol__mph_hash(mph, key));
+}
+
+ccol_status_t ccol_mph_index(const ccol_mph_t *mph, const void *key, size_t *index_out) {
+    CCOL_CHECK_INIT(mph);
+    if (!key) return CCOL_STATUS_INVALID_ARG;
+    if (mph->size == 0) return CCOL_STATUS_NOT_FOUND;
+
+    size_t index = ccol__mph_index_of(mph, ccol__mph_hash(mph, key));
+    if (mph->comparator.func(mph->keys[index], key, mph->comparator.ctx) != 0) return CCOL_STATUS_NOT_FOUND;
+
+    if (index_out) *index_out = index;
+    return CCOL_STATUS_OK;
+}
+
+bool ccol_mph_contains(const ccol_mph_t *mph, const void *key) {
+    return ccol_mph_index(mph, key, NULL) == CCOL_STATUS_OK;
+}
+
+const void *ccol_mph_key_at(const ccol_mph_t *mph, size_t index) {
+    if (!mph || !mph->is_initialized || index >= mph->size) return NULL;
+    return mph->keys[index];
+}
+
+// Attributes
+size_t ccol_mph_size(const ccol_mph_t *mph) {
+    if (!mph || !mph->is_initialized) return 0;
+    return mph->size;
+}
+
+double ccol_mph_bits_per_key(const ccol_mph_t *mph) {
+    if (!mph || !mph->is_initialized || mph->size == 0) return 0.0;
+
+    double bits = 16.0 * (double)mph->num_buckets + 32.0 * (double)(mph->num_slots - mph->size);
+    return bits / (double)mph->size;
+}
+
+// Cleanup
+ccol_status_t ccol_mph_destroy(ccol_mph_t *mph) {
+    CCOL_CHECK_INIT(mph);
+
+    free(mph->pilots);
+    free(mph->remap);
+    free(mph->keys);
+    memset(mph, 0, sizeof(*mph));
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_mph_free(ccol_mph_t **mph_ptr) {
+    if (!mph_ptr || !*mph_ptr) return CCOL_STATUS_INVALID_ARG;
+
+    ccol_status_t status = ccol_mph_destroy(*mph_ptr);
+    free(*mph_ptr);
+    *mph_ptr = NULL;
+    return status;
+}
@@ -0,0 +1,40 @@
+/*
+ * ccol/src/shared/internal_atomic.h
+ *
+ * Internal atomic access and thread-local storage macros.
+ *
+ * Built on the GCC/Clang __atomic builtins (MinGW included) so the library
+ * stays C99; the operands are plain, suitably aligned scalars and pointers.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#ifndef CCOL_INTERNAL_ATOMIC_H
+#define CCOL_INTERNAL_ATOMIC_H
+
+#if !defined(__GNUC__) && !defined(__clang__)
+#error "ccol atomics require the GCC/Clang __atomic builtins"
+#endif
+
+#define CCOL__ATOMIC_LOAD_RELAXED(ptr)       __atomic_load_n((ptr), __ATOMIC_RELAXED)
+#define CCOL__ATOMIC_LOAD_ACQUIRE(ptr)       __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define CCOL__ATOMIC_LOAD_SEQ_CST(ptr)       __atomic_load_n((ptr), __ATOMIC_SEQ_CST)
+
+#define CCOL__ATOMIC_STORE_RELAXED(ptr, val) __atomic_store_n((ptr), (val), __ATOMIC_RELAXED)
+#define CCOL__ATOMIC_STORE_RELEASE(ptr, val) __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#define CCOL__ATOMIC_STORE_SEQ_CST(ptr, val) __atomic_store_n((ptr), (val), __ATOMIC_SEQ_CST)
+
+#define CCOL__ATOMIC_FENCE()                 __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+#define CCOL__ATOMIC_FETCH_ADD(ptr, val)     __atomic_fetch_add((ptr), (val), __ATOMIC_SEQ_CST)
+#define CCOL__ATOMIC_FETCH_ADD_RELAXED(ptr, val) __atomic_fetch_add((ptr), (val), __ATOMIC_RELAXED)
+#define CCOL__ATOMIC_FETCH_SUB(ptr, val)     __atomic_fetch_sub((ptr), (val), __ATOMIC_SEQ_CST)
+
+// expected_ptr is updated with the current value on failure
+#define CCOL__ATOMIC_CAS(ptr, expected_ptr, desired) \
+    __atomic_compare_exchange_n((ptr), (expected_ptr), (desired), 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)
+
+#define CCOL__THREAD_LOCAL __thread
+
+#endif  // CCOL_INTERNAL_ATOMIC_H
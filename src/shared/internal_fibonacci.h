@@ -0,0 +1,30 @@
+/*
+ * ccol/src/shared/internal_fibonacci.h
+ *
+ * Internal Fibonacci hashing helpers shared by the open-addressing tables.
+ *
+ * Multiplying by 2^32 / phi folds every hash bit into the top bits, so
+ * weak hashers (CCOL_HASH_SIMPLE leaves the high bits of small keys zero)
+ * still spread. Callers index with the top bits of the mixed hash, never
+ * the low ones, which only depend on the hash's low bits.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#ifndef CCOL_INTERNAL_FIBONACCI_H
+#define CCOL_INTERNAL_FIBONACCI_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+static inline uint32_t ccol__fibonacci_mix(uint32_t hash) {
+    return hash * UINT32_C(0x9E3779B9);
+}
+
+// Mixed hash scaled onto [0, num_slots); any num_slots up to 2^32, power of two or not
+static inline size_t ccol__fibonacci_home(uint32_t hash, size_t num_slots) {
+    return (size_t)(((uint64_t)ccol__fibonacci_mix(hash) * num_slots) >> 32);
+}
+
+#endif  // CCOL_INTERNAL_FIBONACCI_H
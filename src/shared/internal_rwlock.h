@@ -0,0 +1,54 @@
+/*
+ * ccol/src/shared/internal_rwlock.h
+ *
+ * Internal reader/writer lock wrapper: pthread rwlocks on POSIX,
+ * slim reader/writer locks on Windows. Every function returns 0 on success.
+ * Also hosts ccol__thread_yield for spin-waits.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#ifndef CCOL_INTERNAL_RWLOCK_H
+#define CCOL_INTERNAL_RWLOCK_H
+
+#if defined(_WIN32)
+
+#include <windows.h>
+
+typedef SRWLOCK ccol__rwlock_t;
+
+#define CCOL__RWLOCK_INITIALIZER SRWLOCK_INIT
+
+static inline int ccol__rwlock_init(ccol__rwlock_t *lock) { InitializeSRWLock(lock); return 0; }
+static inline int ccol__rwlock_destroy(ccol__rwlock_t *lock) { (void)lock; return 0; }
+
+static inline int ccol__rwlock_rdlock(ccol__rwlock_t *lock) { AcquireSRWLockShared(lock); return 0; }
+static inline int ccol__rwlock_rdunlock(ccol__rwlock_t *lock) { ReleaseSRWLockShared(lock); return 0; }
+static inline int ccol__rwlock_wrlock(ccol__rwlock_t *lock) { AcquireSRWLockExclusive(lock); return 0; }
+static inline int ccol__rwlock_wrunlock(ccol__rwlock_t *lock) { ReleaseSRWLockExclusive(lock); return 0; }
+
+static inline void ccol__thread_yield(void) { SwitchToThread(); }
+
+#else
+
+#include <pthread.h>
+#include <sched.h>
+
+typedef pthread_rwlock_t ccol__rwlock_t;
+
+#define CCOL__RWLOCK_INITIALIZER PTHREAD_RWLOCK_INITIALIZER
+
+static inline int ccol__rwlock_init(ccol__rwlock_t *lock) { return pthread_rwlock_init(lock, NULL); }
+static inline int ccol__rwlock_destroy(ccol__rwlock_t *lock) { return pthread_rwlock_destroy(lock); }
+
+static inline int ccol__rwlock_rdlock(ccol__rwlock_t *lock) { return pthread_rwlock_rdlock(lock); }
+static inline int ccol__rwlock_rdunlock(ccol__rwlock_t *lock) { return pthread_rwlock_unlock(lock); }
+static inline int ccol__rwlock_wrlock(ccol__rwlock_t *lock) { return pthread_rwlock_wrlock(lock); }
+static inline int ccol__rwlock_wrunlock(ccol__rwlock_t *lock) { return pthread_rwlock_unlock(lock); }
+
+static inline void ccol__thread_yield(void) { sched_yield(); }
+
+#endif
+
+#endif  // CCOL_INTERNAL_RWLOCK_H
@@ -0,0 +1,130 @@
+/*
+ * ccol/src/shared/internal_simd.h
+ *
+ * Internal SIMD helpers.
+ *
+ * Compile-time dispatch only: AVX2 when the build enables it, SSE2 on any
+ * x86-64, NEON on AArch64, and a portable scalar loop everywhere else.
+ * Match kernels return one bit per lane (bit i set when lane i equals the
+ * probe), the same shape as a movemask.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#ifndef CCOL_INTERNAL_SIMD_H
+#define CCOL_INTERNAL_SIMD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__AVX2__)
+#define CCOL__SIMD_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CCOL__SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define CCOL__SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+static inline const char *ccol__simd_name(void) {
+#if defined(CCOL__SIMD_AVX2)
+    return "avx2";
+#elif defined(CCOL__SIMD_SSE2)
+    return "sse2";
+#elif defined(CCOL__SIMD_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+static inline unsigned ccol__simd_first(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctz(mask);
+#else
+    unsigned index = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+// Lanes of 8 consecutive uint32_t equal to key
+static inline uint32_t ccol__simd_match_u32x8(const uint32_t *lanes, uint32_t key) {
+#if defined(CCOL__SIMD_AVX2)
+    __m256i probe = _mm256_set1_epi32((int)key);
+    __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)lanes), probe);
+    return (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(eq));
+#elif defined(CCOL__SIMD_SSE2)
+    __m128i probe = _mm_set1_epi32((int)key);
+    __m128i lo = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)lanes), probe);
+    __m128i hi = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(lanes + 4)), probe);
+    return (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(lo)) |
+           (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(hi)) << 4;
+#elif defined(CCOL__SIMD_NEON)
+    static const uint8_t weights[8] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+    uint32x4_t probe = vdupq_n_u32(key);
+    uint16x4_t lo = vmovn_u32(vceqq_u32(vld1q_u32(lanes), probe));
+    uint16x4_t hi = vmovn_u32(vceqq_u32(vld1q_u32(lanes + 4), probe));
+    uint8x8_t eq = vmovn_u16(vcombine_u16(lo, hi));
+    return vaddv_u8(vand_u8(eq, vld1_u8(weights)));
+#else
+    uint32_t mask = 0;
+    for (unsigned i = 0; i < 8; i++) mask |= (uint32_t)(lanes[i] == key) << i;
+    return mask;
+#endif
+}
+
+// Lanes of 8 consecutive uint64_t equal to key
+static inline uint32_t ccol__simd_match_u64x8(const uint64_t *lanes, uint64_t key) {
+#if defined(CCOL__SIMD_AVX2)
+    __m256i probe = _mm256_set1_epi64x((long long)key);
+    __m256i lo = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)lanes), probe);
+    __m256i hi = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(lanes + 4)), probe);
+    return (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(lo)) |
+           (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(hi)) << 4;
+#elif defined(CCOL__SIMD_SSE2)
+    // SSE2 has no 64-bit compare: both 32-bit halves must match
+    __m128i probe = _mm_set1_epi64x((long long)key);
+    uint32_t mask = 0;
+    for (unsigned i = 0; i < 4; i++) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(lanes + 2 * i)), probe);
+        eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+        mask |= (uint32_t)_mm_movemask_pd(_mm_castsi128_pd(eq)) << (2 * i);
+    }
+    return mask;
+#elif defined(CCOL__SIMD_NEON)
+    static const uint8_t weights[8] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+    uint64x2_t probe = vdupq_n_u64(key);
+    uint32x2_t q0 = vmovn_u64(vceqq_u64(vld1q_u64(lanes), probe));
+    uint32x2_t q1 = vmovn_u64(vceqq_u64(vld1q_u64(lanes + 2), probe));
+    uint32x2_t q2 = vmovn_u64(vceqq_u64(vld1q_u64(lanes + 4), probe));
+    uint32x2_t q3 = vmovn_u64(vceqq_u64(vld1q_u64(lanes + 6), probe));
+    uint16x4_t lo = vmovn_u32(vcombine_u32(q0, q1));
+    uint16x4_t hi = vmovn_u32(vcombine_u32(q2, q3));
+    uint8x8_t eq = vmovn_u16(vcombine_u16(lo, hi));
+    return vaddv_u8(vand_u8(eq, vld1_u8(weights)));
+#else
+    uint32_t mask = 0;
+    for (unsigned i = 0; i < 8; i++) mask |= (uint32_t)(lanes[i] == key) << i;
+    return mask;
+#endif
+}
+
+// Bytes of 8 consecutive control bytes with the high bit clear
+static inline uint32_t ccol__simd_match_high_clear_u8x8(const uint8_t *bytes) {
+#if defined(CCOL__SIMD_AVX2) || defined(CCOL__SIMD_SSE2)
+    return ~(uint32_t)_mm_movemask_epi8(_mm_loadl_epi64((const __m128i *)bytes)) & 0xFFu;
+#else
+    uint32_t mask = 0;
+    for (unsigned i = 0; i < 8; i++) mask |= (uint32_t)!(bytes[i] & 0x80) << i;
+    return mask;
+#endif
+}
+
+#endif  // CCOL_INTERNAL_SIMD_H
@@ -0,0 +1,124 @@
+/*
+ * ccol/src/shared/internal_slab.c
+ *
+ * Internal fixed-size object slabs.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "ccol/ccol_status.h"
+
+#include "internal_slab.h"
+
+#define CCOL__SLAB_MIN_BLOCK_OBJS 32
+#define CCOL__SLAB_MAX_BLOCK_OBJS 65536
+
+// Objects start after the header, aligned for any pointer-based struct
+#define CCOL__SLAB_ALIGN sizeof(void *)
+#define CCOL__SLAB_HEADER_SIZE \
+    ((sizeof(ccol__slab_block_t) + CCOL__SLAB_ALIGN - 1) / CCOL__SLAB_ALIGN * CCOL__SLAB_ALIGN)
+
+// Private
+static ccol__slab_block_t *ccol__slab_new_block(ccol__slab_t *slab, size_t capacity) {
+    if (capacity > (SIZE_MAX - CCOL__SLAB_HEADER_SIZE) / slab->obj_size) return NULL;
+
+    ccol__slab_block_t *block = malloc(CCOL__SLAB_HEADER_SIZE + capacity * slab->obj_size);
+    if (!block) return NULL;
+
+    // Whatever is left of the previous block stays usable through the free list
+    while (slab->bump_left > 0) {
+        *(void **)slab->bump = slab->free_list;
+        slab->free_list = slab->bump;
+        slab->bump += slab->obj_size;
+        slab->bump_left--;
+    }
+
+    block->capacity = capacity;
+    block->next = slab->blocks;
+    slab->blocks = block;
+
+    slab->bump = (char *)block + CCOL__SLAB_HEADER_SIZE;
+    slab->bump_left = capacity;
+
+    return block;
+}
+
+// Public (internal to the library)
+void ccol__slab_init(ccol__slab_t *slab, size_t obj_size) {
+    if (obj_size < sizeof(void *)) obj_size = sizeof(void *);
+
+    slab->obj_size = (obj_size + CCOL__SLAB_ALIGN - 1) / CCOL__SLAB_ALIGN * CCOL__SLAB_ALIGN;
+    slab->next_block_objs = CCOL__SLAB_MIN_BLOCK_OBJS;
+    slab->blocks = NULL;
+    slab->free_list = NULL;
+    slab->bump = NULL;
+    slab->bump_left = 0;
+    slab->live = 0;
+}
+
+void *ccol__slab_alloc(ccol__slab_t *slab) {
+    void *obj = slab->free_list;
+    if (obj) {
+        slab->free_list = *(void **)obj;
+        slab->live++;
+        return obj;
+    }
+
+    if (slab->bump_left == 0) {
+        // Blocks double up to a cap so small tables stay small and big ones make few blocks
+        if (!ccol__slab_new_block(slab, slab->next_block_objs)) return NULL;
+        if (slab->next_block_objs < CCOL__SLAB_MAX_BLOCK_OBJS) slab->next_block_objs *= 2;
+    }
+
+    obj = slab->bump;
+    slab->bump += slab->obj_size;
+    slab->bump_left--;
+    slab->live++;
+
+    return obj;
+}
+
+// count objects laid out back to back, obj_size apart
+void *ccol__slab_alloc_run(ccol__slab_t *slab, size_t count) {
+    if (count == 0) return NULL;
+    if (count > slab->bump_left && !ccol__slab_new_block(slab, count)) return NULL;
+
+    void *run = slab->bump;
+    slab->bump += count * slab->obj_size;
+    slab->bump_left -= count;
+    slab->live += count;
+
+    return run;
+}
+
+void ccol__slab_release(ccol__slab_t *slab, void *obj) {
+    if (!obj) return;
+
+    *(void **)obj = slab->free_list;
+    slab->free_list = obj;
+    slab->live--;
+}
+
+void ccol__slab_destroy(ccol__slab_t *slab) {
+    ccol__slab_block_t *block = slab->blocks;
+    while (block) {
+        ccol__slab_block_t *next = block->next;
+        free(block);
+        block = next;
+    }
+
+    ccol__slab_init(slab, slab->obj_size);
+}
+
+size_t ccol__slab_footprint(const ccol__slab_t *slab) {
+    size_t bytes = 0;
+    for (const ccol__slab_block_t *block = slab->blocks; block; block = block->next) {
+        bytes += CCOL__SLAB_HEADER_SIZE + block->capacity * slab->obj_size;
+    }
+    return bytes;
+}
@@ -0,0 +1,50 @@
+/*
+ * ccol/src/shared/internal_slab.h
+ *
+ * Internal fixed-size object slabs.
+ *
+ * Objects are carved out of large blocks and recycled through an intrusive
+ * free list, so per-object allocation is a pointer pop and releasing the
+ * whole slab frees one block at a time instead of one object at a time.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#ifndef CCOL_INTERNAL_SLAB_H
+#define CCOL_INTERNAL_SLAB_H
+
+#include <stddef.h>
+
+#include "ccol/ccol_status.h"
+
+typedef struct ccol__slab_block {
+    struct ccol__slab_block *next;
+    size_t capacity;  // objects in this block
+} ccol__slab_block_t;
+
+typedef struct ccol__slab {
+    size_t obj_size;  // rounded up to hold a free-list link
+    size_t next_block_objs;
+
+    ccol__slab_block_t *blocks;
+    void *free_list;
+
+    char *bump;  // untouched tail of the newest block
+    size_t bump_left;
+
+    size_t live;
+} ccol__slab_t;
+
+void ccol__slab_init(ccol__slab_t *slab, size_t obj_size);
+
+void *ccol__slab_alloc(ccol__slab_t *slab);
+void *ccol__slab_alloc_run(ccol__slab_t *slab, size_t count);
+void ccol__slab_release(ccol__slab_t *slab, void *obj);
+
+void ccol__slab_destroy(ccol__slab_t *slab);
+
+// Bytes held in blocks, headers included
+size_t ccol__slab_footprint(const ccol__slab_t *slab);
+
+#endif  // CCOL_INTERNAL_SLAB_H
@@ -0,0 +1,96 @@
+/*
+ * ccol/src/shared/internal_thread_pool.c
+ *
+ * Fork-join helper: pthreads on POSIX, Win32 threads on Windows.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "internal_thread_pool.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+typedef HANDLE ccol__thread_t;
+#else
+#include <pthread.h>
+typedef pthread_t ccol__thread_t;
+#endif
+
+typedef struct ccol__parallel_task {
+    ccol__parallel_func_t func;
+    void *arg;
+    size_t task;
+    size_t begin;
+    size_t end;
+} ccol__parallel_task_t;
+
+// Private
+static void ccol__parallel_task_run(ccol__parallel_task_t *task) {
+    task->func(task->arg, task->task, task->begin, task->end);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI ccol__parallel_worker(LPVOID arg) {
+    ccol__parallel_task_run((ccol__parallel_task_t *)arg);
+    return 0;
+}
+
+static bool ccol__thread_start(ccol__thread_t *thread, ccol__parallel_task_t *task) {
+    *thread = CreateThread(NULL, 0, ccol__parallel_worker, task, 0, NULL);
+    return *thread != NULL;
+}
+
+static void ccol__thread_join(ccol__thread_t thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+#else
+static void *ccol__parallel_worker(void *arg) {
+    ccol__parallel_task_run((ccol__parallel_task_t *)arg);
+    return NULL;
+}
+
+static bool ccol__thread_start(ccol__thread_t *thread, ccol__parallel_task_t *task) {
+    return pthread_create(thread, NULL, ccol__parallel_worker, task) == 0;
+}
+
+static void ccol__thread_join(ccol__thread_t thread) {
+    pthread_join(thread, NULL);
+}
+#endif
+
+// Public (internal to the library)
+void ccol__parallel_for(size_t num_tasks, size_t n, ccol__parallel_func_t func, void *arg) {
+    num_tasks = ccol__parallel_num_tasks(num_tasks);
+
+    ccol__parallel_task_t tasks[CCOL__THREAD_POOL_MAX_THREADS];
+    ccol__thread_t threads[CCOL__THREAD_POOL_MAX_THREADS];
+    bool started[CCOL__THREAD_POOL_MAX_THREADS];
+
+    for (size_t i = 0; i < num_tasks; i++) {
+        tasks[i] = (ccol__parallel_task_t){
+            .func = func,
+            .arg = arg,
+            .task = i,
+            .begin = ccol__parallel_range_begin(n, num_tasks, i),
+            .end = ccol__parallel_range_begin(n, num_tasks, i + 1),
+        };
+    }
+
+    for (size_t i = 1; i < num_tasks; i++) started[i] = ccol__thread_start(&threads[i], &tasks[i]);
+
+    ccol__parallel_task_run(&tasks[0]);
+
+    for (size_t i = 1; i < num_tasks; i++) {
+        if (started[i]) ccol__thread_join(threads[i]);
+        else ccol__parallel_task_run(&tasks[i]);
+    }
+}
@@ -0,0 +1,37 @@
+/*
+ * ccol/src/shared/internal_thread_pool.h
+ *
+ * Internal fork-join helper for bulk container operations.
+ *
+ * ccol__parallel_for splits [0, n) into num_tasks contiguous ranges, runs
+ * one on the calling thread and the rest on short-lived workers, and joins
+ * them all before returning. Task i always gets the same range for the same
+ * n and num_tasks, so several passes can agree on a partition.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#ifndef CCOL_INTERNAL_THREAD_POOL_H
+#define CCOL_INTERNAL_THREAD_POOL_H
+
+#include <stddef.h>
+
+#define CCOL__THREAD_POOL_MAX_THREADS 64
+
+typedef void (*ccol__parallel_func_t)(void *arg, size_t task, size_t begin, size_t end);
+
+static inline size_t ccol__parallel_num_tasks(size_t num_tasks) {
+    if (num_tasks < 1) return 1;
+    return num_tasks < CCOL__THREAD_POOL_MAX_THREADS ? num_tasks : CCOL__THREAD_POOL_MAX_THREADS;
+}
+
+static inline size_t ccol__parallel_range_begin(size_t n, size_t num_tasks, size_t task) {
+    return n / num_tasks * task + (task < n % num_tasks ? task : n % num_tasks);
+}
+
+// num_tasks is clamped to [1, CCOL__THREAD_POOL_MAX_THREADS]; a worker that fails to start has
+// its range run on the calling thread, so func always covers all of [0, n)
+void ccol__parallel_for(size_t num_tasks, size_t n, ccol__parallel_func_t func, void *arg);
+
+#endif  // CCOL_INTERNAL_THREAD_POOL_H
@@ -25,7 +25,7 @@
 #include "vector/internal.h"
 
 // Create / Initialize
-ccol_status_t ccol_ccol_vector_init(
+ccol_status_t ccol_vector_init(
     ccol_vector_t *vec,
     size_t capacity,
     size_t element_size,
@@ -36,16 +36,18 @@ ccol_status_t ccol_ccol_vector_init(
 ) {
     if (!vec || element_size == 0) return CCOL_STATUS_INVALID_ARG;
 
-    if (capacity > 0) {
-        vec->data = calloc(capacity,element_size);
-        if (!vec->data) return CCOL_STATUS_ALLOC;
-    } else {
-        vec->data = NULL;
-    }
-   
+    vec->data = NULL;
     vec->size = 0;
-    vec->capacity = capacity;
+    vec->capacity = 0;
     vec->element_size = element_size;
+    vec->growth_factor = CCOL_VECTOR_DEFAULT_GROWTH_FACTOR;
+    vec->is_mapped = false;
+    vec->num_threads = 0;
+    vec->grain_size = CCOL_VECTOR_DEFAULT_GRAIN_SIZE;
+
+    ccol_status_t status = ccol__vector_set_capacity(vec, capacity);
+    if (status != CCOL_STATUS_OK) return status;
+
     vec->copier = copier;
     vec->freer = freer;
     vec->printer = printer;
@@ -87,7 +89,7 @@ ccol_status_t ccol_vector_append(ccol_vector_t *vec, void *data) {
 	CCOL_CHECK_INIT(vec);
 
     if (vec->size == vec->capacity) {
-    	ccol_status_t status = ccol_vector_reserve(vec, vec->capacity == 0 ? 1: vec->capacity * 2);
+    	ccol_status_t status = ccol__vector_grow(vec, vec->size + 1);
         if (status != CCOL_STATUS_OK) return status;
     }
 
@@ -103,7 +105,7 @@ ccol_status_t ccol_vector_insert(ccol_vector_t *vec, size_t index, void *data) {
     if (index > vec->size) return CCOL_STATUS_INVALID_ARG;
 
     if (vec->size == vec->capacity) {
-    	ccol_status_t status = ccol_vector_reserve(vec, vec->capacity == 0 ? 1: vec->capacity * 2);
+    	ccol_status_t status = ccol__vector_grow(vec, vec->size + 1);
         if (status != CCOL_STATUS_OK) return status;
     }
 
@@ -161,6 +163,9 @@ ccol_status_t ccol_vector_assign(ccol_vector_t *vec, size_t count, void *value)
     if (status != CCOL_STATUS_OK) return status;
     if (count == 0) return CCOL_STATUS_OK;
 
+    status = ccol_vector_reserve(vec, count);
+    if (status != CCOL_STATUS_OK) return status;
+
     for (size_t i = 0; i < count; i++) {
     	status = ccol_vector_append(vec, value);
         if (status != CCOL_STATUS_OK) return status;
@@ -246,15 +251,11 @@ ccol_status_t ccol_vector_get_index(const ccol_vector_t *vec, void *value, size_
     if (!vec->comparator.func) return CCOL_STATUS_COMPARATOR_FUNC;
     if (vec->size == 0) return CCOL_STATUS_EMPTY;
 
-    for (size_t i = 0; i < vec->size; i++) {
-    	void *element = (char *)vec->data + (i * vec->element_size);
-        if (vec->comparator.func(element, value, vec->comparator.ctx) == 0) {
-        	*index_out = i;
-            return CCOL_STATUS_OK;
-        }
-    }
+    size_t index = ccol__vector_find(vec, value);
+    if (index == vec->size) return CCOL_STATUS_NOT_FOUND;
 
-    return CCOL_STATUS_NOT_FOUND;
+    *index_out = index;
+    return CCOL_STATUS_OK;
 }
 
 ccol_status_t ccol_vector_peek_at(const ccol_vector_t *vec, size_t index, void **data_out) {
@@ -321,15 +322,9 @@ bool ccol_vector_is_full(const ccol_vector_t *vec) {
 }
 
 bool ccol_vector_contains(const ccol_vector_t *vec, void *value) {
-	CCOL_CHECK_INIT(vec);
-    if (!vec->comparator.func) return false;
-
-	for (size_t i = 0; i < vec->size; i++) {
-    	void *element = (char *)vec->data + (i * vec->element_size);
-        if (vec->comparator.func(element, value, vec->comparator.ctx) == 0) return true;
-    }
+    if (!vec || !vec->is_initialized || !vec->comparator.func) return false;
 
-    return false;
+    return ccol__vector_find(vec, value) < vec->size;
 }
 
 // Utilities
@@ -358,18 +353,7 @@ ccol_status_t ccol_vector_reserve(ccol_vector_t *vec, size_t new_capacity) {
 	CCOL_CHECK_INIT(vec);
     if (new_capacity <= vec->capacity) return CCOL_STATUS_OK;
 
-    void *new_data = calloc(new_capacity, vec->element_size);
-    if (!new_data) return CCOL_STATUS_ALLOC;
-
-    if (vec->data && vec->size > 0) {
-    	memcpy(new_data, vec->data, vec->size * vec->element_size);
-    }
-
-    free(vec->data);
-    vec->data = new_data;
-    vec->capacity = new_capacity;
-
-    return CCOL_STATUS_OK;
+    return ccol__vector_set_capacity(vec, new_capacity);
 }
 
 ccol_status_t ccol_vector_reserve_exact(ccol_vector_t *vec, size_t exact_capacity) {
@@ -377,55 +361,39 @@ ccol_status_t ccol_vector_reserve_exact(ccol_vector_t *vec, size_t exact_capacit
     if (exact_capacity < vec->capacity) return CCOL_STATUS_INVALID_ARG;
     if (exact_capacity == vec->capacity) return CCOL_STATUS_OK;
 
+    return ccol__vector_set_capacity(vec, exact_capacity);
+}
 
-	void *new_data = calloc(exact_capacity, vec->element_size);
-    if (!new_data) return CCOL_STATUS_ALLOC;
-
-    if (vec->data && vec->size > 0) {
-    	memcpy(new_data, vec->data, vec->size * vec->element_size);
-    }
+ccol_status_t ccol_vector_ensure_capacity(ccol_vector_t *vec, size_t min_capacity) {
+    CCOL_CHECK_INIT(vec);
+    return ccol__vector_grow(vec, min_capacity);
+}
 
-    free(vec->data);
-    vec->data = new_data;
-    vec->capacity = exact_capacity;
+ccol_status_t ccol_vector_set_growth_factor(ccol_vector_t *vec, double growth_factor) {
+    CCOL_CHECK_INIT(vec);
+    if (!(growth_factor > 1.0)) return CCOL_STATUS_INVALID_ARG;
 
+    vec->growth_factor = growth_factor;
     return CCOL_STATUS_OK;
 }
 
-ccol_status_t ccol_vector_ensure_capacity(ccol_vector_t *vec, size_t min_capacity) {
+ccol_status_t ccol_vector_set_threads(ccol_vector_t *vec, size_t num_threads) {
     CCOL_CHECK_INIT(vec);
-    if (vec->capacity >= min_capacity) return CCOL_STATUS_OK;
 
-    size_t new_capacity = vec->capacity == 0 ? 1 : vec->capacity;
-    while (new_capacity < min_capacity) new_capacity *= 2; 
-    if (new_capacity > SIZE_MAX / vec->element_size) return CCOL_STATUS_OVERFLOW;
+    vec->num_threads = num_threads;
+    return CCOL_STATUS_OK;
+}
 
-    void *new_data = realloc(vec->data, new_capacity * vec->element_size);
-    if (!new_data) return CCOL_STATUS_ALLOC;
-    
-    vec->data = new_data;
-    vec->capacity = new_capacity;
+ccol_status_t ccol_vector_set_grain_size(ccol_vector_t *vec, size_t grain_size) {
+    CCOL_CHECK_INIT(vec);
 
+    vec->grain_size = grain_size ? grain_size : CCOL_VECTOR_DEFAULT_GRAIN_SIZE;
     return CCOL_STATUS_OK;
 }
 
 ccol_status_t ccol_vector_shrink_to_fit(ccol_vector_t *vec) {
 	CCOL_CHECK_INIT(vec);
-    if (vec->size == vec->capacity) return CCOL_STATUS_OK;
-
-    if (vec->size == 0) {
-    	free(vec->data);
-        vec->data = NULL;
-        vec->capacity = 0;
-        return CCOL_STATUS_OK;
-    }
-
-    void *new_data = realloc(vec->data, vec->size * vec->element_size);
-    if (!new_data) return CCOL_STATUS_ALLOC;
-
-    vec->data = new_data;
-    vec->capacity = vec->size;
-    return CCOL_STATUS_OK;
+    return ccol__vector_set_capacity(vec, vec->size);
 }
 
 ccol_status_t ccol_vector_resize(ccol_vector_t *vec, size_t new_size, void *default_value) {
@@ -475,6 +443,9 @@ ccol_status_t ccol_vector_deep_clone(const ccol_vector_t *src, ccol_vector_t **v
         src->comparator
     );
     if (status != CCOL_STATUS_OK) return status;
+    (*vec_out)->growth_factor = src->growth_factor;
+    (*vec_out)->num_threads = src->num_threads;
+    (*vec_out)->grain_size = src->grain_size;
 
     for (size_t i = 0; i < src->size; i++) {
      	void *element = (char *)src->data + (i * src->element_size);
@@ -511,6 +482,10 @@ ccol_status_t ccol_vector_shallow_clone(const ccol_vector_t *src, ccol_vector_t
     clone->size = src->size;
     clone->capacity = src->capacity;
     clone->element_size = src->element_size;
+    clone->growth_factor = src->growth_factor;
+    clone->is_mapped = src->is_mapped;
+    clone->num_threads = src->num_threads;
+    clone->grain_size = src->grain_size;
     clone->copier = src->copier;
     clone->freer = src->freer;
     clone->printer = src->printer;
@@ -569,15 +544,16 @@ ccol_status_t ccol_vector_shallow_copy(ccol_vector_t *dest, const ccol_vector_t
     CCOL_CHECK_INIT(src);
     if (dest == src) return CCOL_STATUS_OK;
 
-    if (dest->data) {
-        free(dest->data);
-        dest->data = NULL;
-    }
+    ccol__vector_release(dest);
 
     dest->data = src->data;
     dest->size = src->size;
     dest->capacity = src->capacity;
     dest->element_size = src->element_size;
+    dest->growth_factor = src->growth_factor;
+    dest->is_mapped = src->is_mapped;
+    dest->num_threads = src->num_threads;
+    dest->grain_size = src->grain_size;
     dest->copier = src->copier;
     dest->freer = src->freer;
     dest->printer = src->printer;
@@ -598,9 +574,9 @@ ccol_status_t ccol_vector_clear(ccol_vector_t *vec) {
         }
     }
 
-    free(vec->data);
-    vec->data = NULL;
-    vec->size = vec->capacity = vec->element_size =0;
+    // element_size stays: a cleared vector is still usable
+    ccol__vector_release(vec);
+    vec->size = 0;
 
     return CCOL_STATUS_OK;
 }
@@ -0,0 +1,159 @@
+/*
+ * ccol/src/vector/eytzinger.c
+ *
+ * Eytzinger-layout index over a sorted integer vector.
+ *
+ * Keys are stored in breadth-first order of the implicit search tree (node
+ * k's children are 2k and 2k + 1), widened to uint64_t with the sign bit
+ * flipped for signed types so one unsigned compare orders every width. The
+ * first levels of every search share a handful of cache lines, the descent
+ * is a branch-free shift-and-add, and since the eight descendants three
+ * levels below node k are the aligned line at 8k, each step prefetches that
+ * line before it is needed.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "ccol/ccol_vector.h"
+#include "ccol/ccol_status.h"
+#include "ccol/ccol_macros.h"
+
+#include "vector/internal.h"
+
+#define CCOL__VECTOR_EYTZINGER_LINE 64
+#define CCOL__VECTOR_EYTZINGER_LINE_KEYS (CCOL__VECTOR_EYTZINGER_LINE / sizeof(uint64_t))
+
+#define CCOL__VECTOR_EYTZINGER_SIGN ((uint64_t)1 << 63)
+
+// Private
+static uint64_t ccol__vector_eytzinger_key(const void *value, size_t width, bool is_signed) {
+    switch (width) {
+        case sizeof(uint8_t):
+            return is_signed ? (uint64_t)(int64_t)*(const int8_t *)value ^ CCOL__VECTOR_EYTZINGER_SIGN : *(const uint8_t *)value;
+        case sizeof(uint16_t): {
+            uint16_t bits;
+            memcpy(&bits, value, sizeof(bits));
+            return is_signed ? (uint64_t)(int64_t)(int16_t)bits ^ CCOL__VECTOR_EYTZINGER_SIGN : bits;
+        }
+        case sizeof(uint32_t): {
+            uint32_t bits;
+            memcpy(&bits, value, sizeof(bits));
+            return is_signed ? (uint64_t)(int64_t)(int32_t)bits ^ CCOL__VECTOR_EYTZINGER_SIGN : bits;
+        }
+        default: {
+            uint64_t bits;
+            memcpy(&bits, value, sizeof(bits));
+            return is_signed ? bits ^ CCOL__VECTOR_EYTZINGER_SIGN : bits;
+        }
+    }
+}
+
+// In-order walk of the implicit tree hands out the sorted keys; returns the next rank
+static size_t ccol__vector_eytzinger_fill(ccol_vector_eytzinger_t *index, const ccol_vector_t *vec, size_t rank, size_t k) {
+    if (k > index->size) return rank;
+
+    rank = ccol__vector_eytzinger_fill(index, vec, rank, 2 * k);
+    index->keys[k] = ccol__vector_eytzinger_key((const char *)vec->data + rank * vec->element_size, index->element_size, index->is_signed);
+    index->ranks[k] = rank++;
+    return ccol__vector_eytzinger_fill(index, vec, rank, 2 * k + 1);
+}
+
+static size_t ccol__vector_eytzinger_bound(const ccol_vector_eytzinger_t *index, uint64_t key, bool upper) {
+    const uint64_t *keys = index->keys;
+    size_t size = index->size;
+
+    size_t k = 1;
+    while (k <= size) {
+        size_t ahead = k * CCOL__VECTOR_EYTZINGER_LINE_KEYS;
+        if (ahead <= size) CCOL_PREFETCH(keys + ahead);
+        k = 2 * k + (keys[k] < key || (upper && keys[k] == key));
+    }
+
+    // Undo the right turns taken after the last left one; k is then the answer's node, 0 for none
+#if defined(__GNUC__) || defined(__clang__)
+    k >>= __builtin_ctzll(~(unsigned long long)k) + 1;
+#else
+    while (k & 1) k >>= 1;
+    k >>= 1;
+#endif
+    return k ? index->ranks[k] : size;
+}
+
+static ccol_status_t ccol__vector_eytzinger_query(const ccol_vector_eytzinger_t *index, const void *value, size_t *index_out, bool upper) {
+    CCOL_CHECK_INIT(index);
+    if (!value || !index_out) return CCOL_STATUS_INVALID_ARG;
+
+    *index_out = ccol__vector_eytzinger_bound(index, ccol__vector_eytzinger_key(value, index->element_size, index->is_signed), upper);
+    return CCOL_STATUS_OK;
+}
+
+// Create / Initialize
+ccol_status_t ccol_vector_eytzinger_init(ccol_vector_eytzinger_t *index, const ccol_vector_t *vec) {
+    if (!index) return CCOL_STATUS_INVALID_ARG;
+    CCOL_CHECK_INIT(vec);
+
+    bool is_signed = false;
+    size_t width = ccol__vector_integer_width(vec, &is_signed);
+    if (!width) return CCOL_STATUS_COMPARATOR_FUNC;
+
+    for (size_t i = 1; i < vec->size; i++) {
+        const char *element = (const char *)vec->data + i * width;
+        if (vec->comparator.func(element - width, element, vec->comparator.ctx) > 0) return CCOL_STATUS_INVALID_ARG;
+    }
+
+    if (vec->size > (SIZE_MAX - CCOL__VECTOR_EYTZINGER_LINE) / sizeof(uint64_t) - 1) return CCOL_STATUS_OVERFLOW;
+
+    // Slot 0 is unused; the block is over-allocated so keys can start on a cache line
+    void *block = malloc((vec->size + 1) * sizeof(uint64_t) + CCOL__VECTOR_EYTZINGER_LINE);
+    size_t *ranks = malloc((vec->size + 1) * sizeof(size_t));
+    if (!block || !ranks) {
+        free(block);
+        free(ranks);
+        return CCOL_STATUS_ALLOC;
+    }
+
+    uintptr_t aligned = ((uintptr_t)block + CCOL__VECTOR_EYTZINGER_LINE - 1) & ~(uintptr_t)(CCOL__VECTOR_EYTZINGER_LINE - 1);
+
+    index->block = block;
+    index->keys = (uint64_t *)aligned;
+    index->ranks = ranks;
+    index->size = vec->size;
+    index->element_size = width;
+    index->is_signed = is_signed;
+    index->is_initialized = true;
+
+    ccol__vector_eytzinger_fill(index, vec, 0, 1);
+    return CCOL_STATUS_OK;
+}
+
+// Access
+ccol_status_t ccol_vector_eytzinger_lower_bound(const ccol_vector_eytzinger_t *index, const void *value, size_t *index_out) {
+    return ccol__vector_eytzinger_query(index, value, index_out, false);
+}
+
+ccol_status_t ccol_vector_eytzinger_upper_bound(const ccol_vector_eytzinger_t *index, const void *value, size_t *index_out) {
+    return ccol__vector_eytzinger_query(index, value, index_out, true);
+}
+
+// Cleanup
+ccol_status_t ccol_vector_eytzinger_destroy(ccol_vector_eytzinger_t *index) {
+    CCOL_CHECK_INIT(index);
+
+    free(index->block);
+    free(index->ranks);
+
+    index->block = NULL;
+    index->keys = NULL;
+    index->ranks = NULL;
+    index->size = 0;
+    index->is_initialized = false;
+
+    return CCOL_STATUS_OK;
+}
@@ -3,24 +3,169 @@
  *
  * Internal helper function implementations for dynamic array (vector).
  *
+ * Capacity changes realloc the buffer, so the allocator can extend it in
+ * place and nothing past size is zeroed. On Linux, buffers that reach
+ * CCOL_VECTOR_MAP_THRESHOLD move to an anonymous mapping once; from then
+ * on mremap resizes them by remapping pages rather than copying bytes.
+ *
  * Created by Jack Einbinder
  * Copyright (C) 2025 Jack Einbinder
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  // mremap
+#endif
+
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define CCOL__VECTOR_HAVE_MREMAP 1
+#endif
 
 #include "ccol/ccol_vector.h"
 #include "ccol/ccol_macros.h"
+#include "ccol/ccol_comparator.h"
 
 #include "vector/internal.h"
 
-ccol_status_t ccol__vector_uninit(ccol_vector_t *vec) {
-    CCOL_CHECK_INIT(vec);
+// Private
+#if defined(CCOL__VECTOR_HAVE_MREMAP)
+static size_t ccol__vector_map_length(size_t bytes) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    return (bytes + page - 1) / page * page;
+}
+
+static ccol_status_t ccol__vector_remap(ccol_vector_t *vec, size_t bytes) {
+    size_t old_length = ccol__vector_map_length(vec->capacity * vec->element_size);
+    size_t new_length = ccol__vector_map_length(bytes);
+    if (new_length < bytes) return CCOL_STATUS_OVERFLOW;
+
+    if (!vec->is_mapped) {
+        void *data = mmap(NULL, new_length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (data == MAP_FAILED) return CCOL_STATUS_ALLOC;
+
+        // The one copy a buffer ever pays on this path
+        if (vec->size > 0) memcpy(data, vec->data, vec->size * vec->element_size);
+        free(vec->data);
+
+        vec->data = data;
+        vec->is_mapped = true;
+        return CCOL_STATUS_OK;
+    }
 
+    if (new_length == old_length) return CCOL_STATUS_OK;
+
+    void *data = mremap(vec->data, old_length, new_length, MREMAP_MAYMOVE);
+    if (data == MAP_FAILED) return CCOL_STATUS_ALLOC;
+
+    vec->data = data;
+    return CCOL_STATUS_OK;
+}
+#endif
+
+// Public (internal to the library)
+void ccol__vector_release(ccol_vector_t *vec) {
+#if defined(CCOL__VECTOR_HAVE_MREMAP)
+    if (vec->is_mapped) {
+        munmap(vec->data, ccol__vector_map_length(vec->capacity * vec->element_size));
+    } else {
+        free(vec->data);
+    }
+#else
     free(vec->data);
+#endif
+
     vec->data = NULL;
+    vec->capacity = 0;
+    vec->is_mapped = false;
+}
+
+// Exactly capacity elements; the first size of them are kept
+ccol_status_t ccol__vector_set_capacity(ccol_vector_t *vec, size_t capacity) {
+    if (capacity < vec->size) return CCOL_STATUS_INVALID_ARG;
+    if (capacity == vec->capacity) return CCOL_STATUS_OK;
+    if (capacity > SIZE_MAX / vec->element_size) return CCOL_STATUS_OVERFLOW;
+
+    if (capacity == 0) {
+        ccol__vector_release(vec);
+        return CCOL_STATUS_OK;
+    }
+
+    size_t bytes = capacity * vec->element_size;
+
+#if defined(CCOL__VECTOR_HAVE_MREMAP)
+    if (vec->is_mapped || bytes >= CCOL_VECTOR_MAP_THRESHOLD) {
+        ccol_status_t status = ccol__vector_remap(vec, bytes);
+        if (status != CCOL_STATUS_OK) return status;
+
+        vec->capacity = capacity;
+        return CCOL_STATUS_OK;
+    }
+#endif
+
+    void *data = realloc(vec->data, bytes);
+    if (!data) return CCOL_STATUS_ALLOC;
+
+    vec->data = data;
+    vec->capacity = capacity;
+    return CCOL_STATUS_OK;
+}
+
+// Multiplies capacity by growth_factor until min_capacity fits, clamping at the largest
+// capacity whose byte size fits in a size_t
+ccol_status_t ccol__vector_grow(ccol_vector_t *vec, size_t min_capacity) {
+    if (min_capacity <= vec->capacity) return CCOL_STATUS_OK;
+
+    size_t max_capacity = SIZE_MAX / vec->element_size;
+    if (min_capacity > max_capacity) return CCOL_STATUS_OVERFLOW;
+
+    size_t capacity = vec->capacity < CCOL_VECTOR_MIN_CAPACITY ? CCOL_VECTOR_MIN_CAPACITY : vec->capacity;
+    while (capacity < min_capacity) {
+        double next = (double)capacity * vec->growth_factor;
+        if (next >= (double)max_capacity) {
+            capacity = max_capacity;
+            break;
+        }
+        capacity = (size_t)next > capacity ? (size_t)next : capacity + 1;
+    }
+
+    return ccol__vector_set_capacity(vec, capacity);
+}
+
+size_t ccol__vector_integer_width(const ccol_vector_t *vec, bool *is_signed) {
+    static const struct {
+        ccol_comparator_func_t func;
+        size_t width;
+        bool is_signed;
+    } integers[] = {
+        { ccol_cmp_int8, sizeof(int8_t), true },     { ccol_cmp_uint8, sizeof(uint8_t), false },
+        { ccol_cmp_int16, sizeof(int16_t), true },   { ccol_cmp_uint16, sizeof(uint16_t), false },
+        { ccol_cmp_int32, sizeof(int32_t), true },   { ccol_cmp_uint32, sizeof(uint32_t), false },
+        { ccol_cmp_int64, sizeof(int64_t), true },   { ccol_cmp_uint64, sizeof(uint64_t), false },
+    };
+
+    for (size_t i = 0; i < sizeof(integers) / sizeof(integers[0]); i++) {
+        if (vec->comparator.func != integers[i].func) continue;
+        if (vec->element_size != integers[i].width) return 0;
+
+        if (is_signed) *is_signed = integers[i].is_signed;
+        return integers[i].width;
+    }
+    return 0;
+}
+
+ccol_status_t ccol__vector_uninit(ccol_vector_t *vec) {
+    CCOL_CHECK_INIT(vec);
+
+    ccol__vector_release(vec);
     vec->size = vec->capacity = vec->element_size = 0;
+    vec->growth_factor = 0;
+    vec->num_threads = vec->grain_size = 0;
 
     vec->copier = (ccol_copy_t){0};
     vec->freer = (ccol_free_t){0};
@@ -31,4 +176,3 @@ ccol_status_t ccol__vector_uninit(ccol_vector_t *vec) {
 
     return CCOL_STATUS_OK;
 }
-
@@ -10,9 +10,30 @@
 #ifndef CCOL_VECTOR_INTERNAL_H
 #define CCOL_VECTOR_INTERNAL_H
 
+#include <stddef.h>
+#include <stdbool.h>
+
 #include "ccol/ccol_vector.h"
 
 ccol_status_t ccol__vector_uninit(ccol_vector_t *vec);
 
-#endif  //CCOL_VECTOR_INTERNAL_H
+// Growth engine: every path that changes capacity goes through these
+ccol_status_t ccol__vector_set_capacity(ccol_vector_t *vec, size_t capacity);
+ccol_status_t ccol__vector_grow(ccol_vector_t *vec, size_t min_capacity);
+void ccol__vector_release(ccol_vector_t *vec);
+
+// Byte width of the element when the comparator is a built-in integer one, otherwise 0
+size_t ccol__vector_integer_width(const ccol_vector_t *vec, bool *is_signed);
+
+// Sorts n elements at base (inside vec's buffer or a copy of part of it) with vec's comparator
+void ccol__vector_sort_range(const ccol_vector_t *vec, char *base, size_t n);
+// Stable merge of two sorted runs into out, which must not overlap either
+void ccol__vector_merge_runs(const char *a, size_t a_n, const char *b, size_t b_n, char *out, size_t width, const ccol_comparator_t *cmp);
 
+// First index whose element is not before value (lower), or is after it (upper); vec sorted
+size_t ccol__vector_bound(const ccol_vector_t *vec, const void *value, bool upper);
+
+// Index of the first element equal to value under the comparator, or size if none
+size_t ccol__vector_find(const ccol_vector_t *vec, const void *value);
+
+#endif  //CCOL_VECTOR_INTERNAL_H
@@ -0,0 +1,359 @@
+/*
+ * ccol/src/vector/parallel.c
+ *
+ * Multi-threaded algorithms over the vector buffer.
+ *
+ * Workers come from ccol__parallel_for, one per thread. Element-wise passes
+ * hand out grain_size chunks from a shared cursor, so a thread that finishes
+ * early keeps claiming work instead of idling behind a slow range. Reduce
+ * uses fixed contiguous ranges instead, so func only has to be associative.
+ * The sort cuts the buffer into one block per thread, sorts the blocks, then
+ * merges runs pairwise; each merge pass is split by output position, with a
+ * binary search (merge path) finding where every thread's slice starts in
+ * both input runs.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "ccol/ccol_vector.h"
+#include "ccol/ccol_status.h"
+#include "ccol/ccol_macros.h"
+
+#include "vector/internal.h"
+#include "internal_atomic.h"
+#include "internal_thread_pool.h"
+
+typedef struct ccol__vector_chunks {
+    size_t size;
+    size_t grain;
+    size_t next;  // first unclaimed element, advanced atomically
+} ccol__vector_chunks_t;
+
+typedef struct ccol__vector_parallel_apply {
+    ccol__vector_chunks_t chunks;
+    const ccol_vector_t *vec;
+    ccol_vector_apply_func_t func;
+    void *ctx;
+} ccol__vector_parallel_apply_t;
+
+typedef struct ccol__vector_parallel_transform {
+    ccol__vector_chunks_t chunks;
+    const ccol_vector_t *src;
+    ccol_vector_t *dest;
+    ccol_vector_transform_func_t func;
+    void *ctx;
+} ccol__vector_parallel_transform_t;
+
+typedef struct ccol__vector_parallel_reduce {
+    const ccol_vector_t *vec;
+    const void *identity;
+    ccol_vector_reduce_func_t func;
+    void *ctx;
+    char *partials;  // one accumulator per task
+} ccol__vector_parallel_reduce_t;
+
+typedef struct ccol__vector_parallel_predicate {
+    ccol__vector_chunks_t chunks;
+    const ccol_vector_t *vec;
+    ccol_vector_predicate_func_t func;
+    void *ctx;
+    size_t counts[CCOL__THREAD_POOL_MAX_THREADS];
+    size_t found;  // lowest match so far, size when none
+} ccol__vector_parallel_predicate_t;
+
+typedef struct ccol__vector_parallel_sort {
+    const ccol_vector_t *vec;
+    size_t size;
+    size_t num_blocks;
+    size_t run;  // blocks per sorted run going into the current merge pass
+    char *src;
+    char *dst;
+} ccol__vector_parallel_sort_t;
+
+// Private
+static size_t ccol__vector_num_tasks(const ccol_vector_t *vec) {
+    size_t chunks = vec->size / vec->grain_size + (vec->size % vec->grain_size != 0);
+    if (vec->num_threads < 2 || chunks < 2) return 1;
+    return ccol__parallel_num_tasks(vec->num_threads < chunks ? vec->num_threads : chunks);
+}
+
+static inline ccol__vector_chunks_t ccol__vector_chunks(const ccol_vector_t *vec) {
+    return (ccol__vector_chunks_t){ .size = vec->size, .grain = vec->grain_size, .next = 0 };
+}
+
+static inline bool ccol__vector_claim(ccol__vector_chunks_t *chunks, size_t *begin, size_t *end) {
+    size_t claimed = CCOL__ATOMIC_FETCH_ADD_RELAXED(&chunks->next, chunks->grain);
+    if (claimed >= chunks->size) return false;
+
+    *begin = claimed;
+    *end = chunks->size - claimed < chunks->grain ? chunks->size : claimed + chunks->grain;
+    return true;
+}
+
+static inline char *ccol__vector_element(const ccol_vector_t *vec, size_t index) {
+    return (char *)vec->data + index * vec->element_size;
+}
+
+static void ccol__vector_parallel_apply(void *arg, size_t task, size_t first, size_t last) {
+    (void)task; (void)first; (void)last;
+    ccol__vector_parallel_apply_t *apply = arg;
+
+    size_t begin, end;
+    while (ccol__vector_claim(&apply->chunks, &begin, &end)) {
+        for (size_t i = begin; i < end; i++) apply->func(ccol__vector_element(apply->vec, i), apply->ctx);
+    }
+}
+
+static void ccol__vector_parallel_transform(void *arg, size_t task, size_t first, size_t last) {
+    (void)task; (void)first; (void)last;
+    ccol__vector_parallel_transform_t *transform = arg;
+
+    size_t begin, end;
+    while (ccol__vector_claim(&transform->chunks, &begin, &end)) {
+        for (size_t i = begin; i < end; i++) {
+            transform->func(ccol__vector_element(transform->src, i), ccol__vector_element(transform->dest, i), transform->ctx);
+        }
+    }
+}
+
+static void ccol__vector_parallel_reduce(void *arg, size_t task, size_t begin, size_t end) {
+    ccol__vector_parallel_reduce_t *reduce = arg;
+    char *acc = reduce->partials + task * reduce->vec->element_size;
+
+    memcpy(acc, reduce->identity, reduce->vec->element_size);
+    for (size_t i = begin; i < end; i++) reduce->func(acc, ccol__vector_element(reduce->vec, i), reduce->ctx);
+}
+
+static void ccol__vector_parallel_count(void *arg, size_t task, size_t first, size_t last) {
+    (void)first; (void)last;
+    ccol__vector_parallel_predicate_t *predicate = arg;
+
+    size_t count = 0;
+    size_t begin, end;
+    while (ccol__vector_claim(&predicate->chunks, &begin, &end)) {
+        for (size_t i = begin; i < end; i++) count += predicate->func(ccol__vector_element(predicate->vec, i), predicate->ctx);
+    }
+    predicate->counts[task] = count;
+}
+
+// Chunks are claimed in increasing order, so a task stops at its first match or once
+// it reaches a chunk past the best match found so far
+static void ccol__vector_parallel_find(void *arg, size_t task, size_t first, size_t last) {
+    (void)task; (void)first; (void)last;
+    ccol__vector_parallel_predicate_t *predicate = arg;
+
+    size_t begin, end;
+    while (ccol__vector_claim(&predicate->chunks, &begin, &end)) {
+        if (begin >= CCOL__ATOMIC_LOAD_RELAXED(&predicate->found)) return;
+
+        for (size_t i = begin; i < end; i++) {
+            if (!predicate->func(ccol__vector_element(predicate->vec, i), predicate->ctx)) continue;
+
+            size_t found = CCOL__ATOMIC_LOAD_RELAXED(&predicate->found);
+            while (i < found && !CCOL__ATOMIC_CAS(&predicate->found, &found, i)) {}
+            return;
+        }
+    }
+}
+
+static void ccol__vector_parallel_sort_block(void *arg, size_t task, size_t begin, size_t end) {
+    (void)task;
+    ccol__vector_parallel_sort_t *sort = arg;
+    ccol__vector_sort_range(sort->vec, sort->src + begin * sort->vec->element_size, end - begin);
+}
+
+// Elements of a taken from the first k outputs of the stable merge of a and b
+static size_t ccol__vector_co_rank(size_t k, const char *a, size_t a_n, const char *b, size_t b_n, size_t width, const ccol_comparator_t *cmp) {
+    size_t lo = k > b_n ? k - b_n : 0;
+    size_t hi = k < a_n ? k : a_n;
+
+    // Too few from a while a[i] would still be emitted before b[j - 1]
+    while (lo < hi) {
+        size_t i = lo + (hi - lo) / 2;
+        size_t j = k - i;
+        if (j > 0 && cmp->func(a + i * width, b + (j - 1) * width, cmp->ctx) <= 0) {
+            lo = i + 1;
+        } else {
+            hi = i;
+        }
+    }
+    return lo;
+}
+
+static void ccol__vector_parallel_merge(void *arg, size_t task, size_t begin, size_t end) {
+    (void)task;
+    ccol__vector_parallel_sort_t *sort = arg;
+    size_t width = sort->vec->element_size;
+    const ccol_comparator_t *cmp = &sort->vec->comparator;
+
+    for (size_t block = 0; block < sort->num_blocks; block += 2 * sort->run) {
+        size_t mid_block = block + sort->run < sort->num_blocks ? block + sort->run : sort->num_blocks;
+        size_t hi_block = block + 2 * sort->run < sort->num_blocks ? block + 2 * sort->run : sort->num_blocks;
+
+        size_t lo = ccol__parallel_range_begin(sort->size, sort->num_blocks, block);
+        size_t mid = ccol__parallel_range_begin(sort->size, sort->num_blocks, mid_block);
+        size_t hi = ccol__parallel_range_begin(sort->size, sort->num_blocks, hi_block);
+
+        // This task's slice of the output run [lo, hi)
+        size_t out_lo = begin > lo ? begin : lo;
+        size_t out_hi = end < hi ? end : hi;
+        if (out_lo >= out_hi) continue;
+
+        const char *a = sort->src + lo * width;
+        const char *b = sort->src + mid * width;
+        size_t a_n = mid - lo;
+        size_t b_n = hi - mid;
+
+        // A run without a partner, or two runs already in order, is a plain copy
+        if (b_n == 0 || cmp->func(b - width, b, cmp->ctx) <= 0) {
+            memcpy(sort->dst + out_lo * width, sort->src + out_lo * width, (out_hi - out_lo) * width);
+            continue;
+        }
+
+        size_t i0 = ccol__vector_co_rank(out_lo - lo, a, a_n, b, b_n, width, cmp);
+        size_t i1 = ccol__vector_co_rank(out_hi - lo, a, a_n, b, b_n, width, cmp);
+        size_t j0 = out_lo - lo - i0;
+        size_t j1 = out_hi - lo - i1;
+
+        ccol__vector_merge_runs(a + i0 * width, i1 - i0, b + j0 * width, j1 - j0, sort->dst + out_lo * width, width, cmp);
+    }
+}
+
+static void ccol__vector_parallel_copy_back(void *arg, size_t task, size_t begin, size_t end) {
+    (void)task;
+    ccol__vector_parallel_sort_t *sort = arg;
+    size_t width = sort->vec->element_size;
+    memcpy((char *)sort->vec->data + begin * width, sort->src + begin * width, (end - begin) * width);
+}
+
+// Parallel algorithms
+ccol_status_t ccol_vector_parallel_sort(ccol_vector_t *vec) {
+    CCOL_CHECK_INIT(vec);
+    if (!vec->comparator.func) return CCOL_STATUS_COMPARATOR_FUNC;
+
+    size_t num_tasks = ccol__vector_num_tasks(vec);
+    if (num_tasks < 2) return ccol_vector_sort(vec);
+
+    char *scratch = malloc(vec->size * vec->element_size);
+    if (!scratch) return CCOL_STATUS_ALLOC;
+
+    ccol__vector_parallel_sort_t sort = {
+        .vec = vec,
+        .size = vec->size,
+        .num_blocks = num_tasks,
+        .src = vec->data,
+        .dst = scratch,
+    };
+    ccol__parallel_for(num_tasks, vec->size, ccol__vector_parallel_sort_block, &sort);
+
+    for (sort.run = 1; sort.run < sort.num_blocks; sort.run *= 2) {
+        ccol__parallel_for(num_tasks, vec->size, ccol__vector_parallel_merge, &sort);
+
+        char *tmp = sort.src;
+        sort.src = sort.dst;
+        sort.dst = tmp;
+    }
+
+    if (sort.src != vec->data) ccol__parallel_for(num_tasks, vec->size, ccol__vector_parallel_copy_back, &sort);
+
+    free(scratch);
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_vector_for_each(ccol_vector_t *vec, ccol_vector_apply_func_t func, void *ctx) {
+    CCOL_CHECK_INIT(vec);
+    if (!func) return CCOL_STATUS_INVALID_ARG;
+
+    ccol__vector_parallel_apply_t apply = { .chunks = ccol__vector_chunks(vec), .vec = vec, .func = func, .ctx = ctx };
+    size_t num_tasks = ccol__vector_num_tasks(vec);
+    ccol__parallel_for(num_tasks, num_tasks, ccol__vector_parallel_apply, &apply);
+
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_vector_transform(const ccol_vector_t *src, ccol_vector_t *dest, ccol_vector_transform_func_t func, void *ctx) {
+    CCOL_CHECK_INIT(src);
+    CCOL_CHECK_INIT(dest);
+    if (!func) return CCOL_STATUS_INVALID_ARG;
+
+    if (dest != src) {
+        ccol_status_t status = ccol_vector_clear(dest);
+        if (status != CCOL_STATUS_OK) return status;
+
+        status = ccol__vector_set_capacity(dest, src->size);
+        if (status != CCOL_STATUS_OK) return status;
+    }
+
+    ccol__vector_parallel_transform_t transform = {
+        .chunks = ccol__vector_chunks(src),
+        .src = src,
+        .dest = dest,
+        .func = func,
+        .ctx = ctx,
+    };
+    size_t num_tasks = ccol__vector_num_tasks(src);
+    ccol__parallel_for(num_tasks, num_tasks, ccol__vector_parallel_transform, &transform);
+
+    dest->size = src->size;
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_vector_reduce(const ccol_vector_t *vec, const void *identity, ccol_vector_reduce_func_t func, void *ctx, void *result_out) {
+    CCOL_CHECK_INIT(vec);
+    if (!identity || !func || !result_out) return CCOL_STATUS_INVALID_ARG;
+
+    size_t num_tasks = ccol__vector_num_tasks(vec);
+    ccol__vector_parallel_reduce_t reduce = { .vec = vec, .identity = identity, .func = func, .ctx = ctx };
+
+    reduce.partials = malloc(num_tasks * vec->element_size);
+    if (!reduce.partials) return CCOL_STATUS_ALLOC;
+
+    ccol__parallel_for(num_tasks, vec->size, ccol__vector_parallel_reduce, &reduce);
+
+    // Partials are combined in range order, so func need not be commutative
+    memmove(result_out, identity, vec->element_size);
+    for (size_t task = 0; task < num_tasks; task++) func(result_out, reduce.partials + task * vec->element_size, ctx);
+
+    free(reduce.partials);
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_vector_count_if(const ccol_vector_t *vec, ccol_vector_predicate_func_t func, void *ctx, size_t *count_out) {
+    CCOL_CHECK_INIT(vec);
+    if (!func || !count_out) return CCOL_STATUS_INVALID_ARG;
+
+    ccol__vector_parallel_predicate_t predicate = { .chunks = ccol__vector_chunks(vec), .vec = vec, .func = func, .ctx = ctx };
+    size_t num_tasks = ccol__vector_num_tasks(vec);
+    ccol__parallel_for(num_tasks, num_tasks, ccol__vector_parallel_count, &predicate);
+
+    *count_out = 0;
+    for (size_t task = 0; task < num_tasks; task++) *count_out += predicate.counts[task];
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_vector_find_first(const ccol_vector_t *vec, ccol_vector_predicate_func_t func, void *ctx, size_t *index_out) {
+    CCOL_CHECK_INIT(vec);
+    if (!func || !index_out) return CCOL_STATUS_INVALID_ARG;
+
+    ccol__vector_parallel_predicate_t predicate = {
+        .chunks = ccol__vector_chunks(vec),
+        .vec = vec,
+        .func = func,
+        .ctx = ctx,
+        .found = vec->size,
+    };
+    size_t num_tasks = ccol__vector_num_tasks(vec);
+    ccol__parallel_for(num_tasks, num_tasks, ccol__vector_parallel_find, &predicate);
+
+    if (predicate.found == vec->size) return CCOL_STATUS_NOT_FOUND;
+
+    *index_out = predicate.found;
+    return CCOL_STATUS_OK;
+}
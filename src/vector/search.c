@@ -0,0 +1,263 @@
+/*
+ * ccol/src/vector/search.c
+ *
+ * Linear and binary search over the vector buffer.
+ *
+ * When the comparator is one of the built-in fixed-width integer ones,
+ * equality is bitwise equality, so the scan skips the per-element call and
+ * compares whole lanes with the kernels in internal_simd.h. Those are picked
+ * at compile time; on x86 builds without -mavx2 an AVX2 scan is compiled
+ * alongside and chosen at runtime when the CPU supports it.
+ *
+ * Binary searches halve the range without branching on the comparison (the
+ * next base is a select), so the loop runs exactly log2(n) times whatever
+ * the data. Integer comparators compare the typed elements directly.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "ccol/ccol_vector.h"
+#include "ccol/ccol_status.h"
+#include "ccol/ccol_macros.h"
+
+#include "vector/internal.h"
+#include "internal_simd.h"
+
+#if !defined(CCOL__SIMD_AVX2) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define CCOL__VECTOR_RUNTIME_AVX2 1
+#include <immintrin.h>
+#endif
+
+// Elements compared per unrolled step: four 8-lane matches
+#define CCOL__VECTOR_SCAN_STEP 32
+
+// Private
+static size_t ccol__vector_find_u32(const uint32_t *data, size_t size, uint32_t key) {
+    size_t i = 0;
+    for (; i + CCOL__VECTOR_SCAN_STEP <= size; i += CCOL__VECTOR_SCAN_STEP) {
+        uint32_t mask = ccol__simd_match_u32x8(data + i, key) |
+                        ccol__simd_match_u32x8(data + i + 8, key) << 8 |
+                        ccol__simd_match_u32x8(data + i + 16, key) << 16 |
+                        ccol__simd_match_u32x8(data + i + 24, key) << 24;
+        if (mask) return i + ccol__simd_first(mask);
+    }
+
+    for (; i < size; i++) {
+        if (data[i] == key) return i;
+    }
+    return size;
+}
+
+static size_t ccol__vector_find_u64(const uint64_t *data, size_t size, uint64_t key) {
+    size_t i = 0;
+    for (; i + CCOL__VECTOR_SCAN_STEP <= size; i += CCOL__VECTOR_SCAN_STEP) {
+        uint32_t mask = ccol__simd_match_u64x8(data + i, key) |
+                        ccol__simd_match_u64x8(data + i + 8, key) << 8 |
+                        ccol__simd_match_u64x8(data + i + 16, key) << 16 |
+                        ccol__simd_match_u64x8(data + i + 24, key) << 24;
+        if (mask) return i + ccol__simd_first(mask);
+    }
+
+    for (; i < size; i++) {
+        if (data[i] == key) return i;
+    }
+    return size;
+}
+
+#if defined(CCOL__VECTOR_RUNTIME_AVX2)
+__attribute__((target("avx2")))
+static size_t ccol__vector_find_u32_avx2(const uint32_t *data, size_t size, uint32_t key) {
+    __m256i probe = _mm256_set1_epi32((int)key);
+    size_t i = 0;
+    for (; i + CCOL__VECTOR_SCAN_STEP <= size; i += CCOL__VECTOR_SCAN_STEP) {
+        __m256i e0 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(data + i)), probe);
+        __m256i e1 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(data + i + 8)), probe);
+        __m256i e2 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(data + i + 16)), probe);
+        __m256i e3 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(data + i + 24)), probe);
+        __m256i any = _mm256_or_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e2, e3));
+        if (_mm256_testz_si256(any, any)) continue;
+
+        uint32_t mask = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(e0)) |
+                        (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(e1)) << 8 |
+                        (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(e2)) << 16 |
+                        (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(e3)) << 24;
+        return i + ccol__simd_first(mask);
+    }
+
+    return i + ccol__vector_find_u32(data + i, size - i, key);
+}
+
+__attribute__((target("avx2")))
+static size_t ccol__vector_find_u64_avx2(const uint64_t *data, size_t size, uint64_t key) {
+    __m256i probe = _mm256_set1_epi64x((long long)key);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m256i e0 = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(data + i)), probe);
+        __m256i e1 = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(data + i + 4)), probe);
+        __m256i e2 = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(data + i + 8)), probe);
+        __m256i e3 = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(data + i + 12)), probe);
+        __m256i any = _mm256_or_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e2, e3));
+        if (_mm256_testz_si256(any, any)) continue;
+
+        uint32_t mask = (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(e0)) |
+                        (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(e1)) << 4 |
+                        (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(e2)) << 8 |
+                        (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(e3)) << 12;
+        return i + ccol__simd_first(mask);
+    }
+
+    return i + ccol__vector_find_u64(data + i, size - i, key);
+}
+
+static inline bool ccol__vector_has_avx2(void) {
+    return __builtin_cpu_supports("avx2");
+}
+#endif
+
+// Bound on typed elements: first index whose element is >= key, or > key when upper
+#define CCOL__VECTOR_BOUND(suffix, type)                                                             \
+    static size_t ccol__vector_bound_##suffix(const type *data, size_t size, type key, bool upper) { \
+        if (size == 0) return 0;                                                                     \
+                                                                                                     \
+        const type *base = data;                                                                     \
+        while (size > 1) {                                                                           \
+            size_t half = size / 2;                                                                  \
+            base = (base[half] < key || (upper && base[half] == key)) ? base + half : base;          \
+            size -= half;                                                                            \
+        }                                                                                            \
+        return (size_t)(base - data) + (*base < key || (upper && *base == key));                     \
+    }
+
+CCOL__VECTOR_BOUND(i8, int8_t)
+CCOL__VECTOR_BOUND(u8, uint8_t)
+CCOL__VECTOR_BOUND(i16, int16_t)
+CCOL__VECTOR_BOUND(u16, uint16_t)
+CCOL__VECTOR_BOUND(i32, int32_t)
+CCOL__VECTOR_BOUND(u32, uint32_t)
+CCOL__VECTOR_BOUND(i64, int64_t)
+CCOL__VECTOR_BOUND(u64, uint64_t)
+
+static size_t ccol__vector_bound_integer(const ccol_vector_t *vec, size_t width, bool is_signed, const void *value, bool upper) {
+    union {
+        int8_t i8; uint8_t u8; int16_t i16; uint16_t u16;
+        int32_t i32; uint32_t u32; int64_t i64; uint64_t u64;
+    } key;
+    memcpy(&key, value, width);
+
+    switch (width) {
+        case sizeof(uint8_t):
+            return is_signed ? ccol__vector_bound_i8(vec->data, vec->size, key.i8, upper)
+                             : ccol__vector_bound_u8(vec->data, vec->size, key.u8, upper);
+        case sizeof(uint16_t):
+            return is_signed ? ccol__vector_bound_i16(vec->data, vec->size, key.i16, upper)
+                             : ccol__vector_bound_u16(vec->data, vec->size, key.u16, upper);
+        case sizeof(uint32_t):
+            return is_signed ? ccol__vector_bound_i32(vec->data, vec->size, key.i32, upper)
+                             : ccol__vector_bound_u32(vec->data, vec->size, key.u32, upper);
+        default:
+            return is_signed ? ccol__vector_bound_i64(vec->data, vec->size, key.i64, upper)
+                             : ccol__vector_bound_u64(vec->data, vec->size, key.u64, upper);
+    }
+}
+
+// Public (internal to the library)
+size_t ccol__vector_bound(const ccol_vector_t *vec, const void *value, bool upper) {
+    bool is_signed = false;
+    size_t width = ccol__vector_integer_width(vec, &is_signed);
+    if (width) return ccol__vector_bound_integer(vec, width, is_signed, value, upper);
+
+    size_t size = vec->size;
+    if (size == 0) return 0;
+
+    const ccol_comparator_t *cmp = &vec->comparator;
+    const char *data = vec->data;
+    const char *base = data;
+    while (size > 1) {
+        size_t half = size / 2;
+        int order = cmp->func(base + half * vec->element_size, value, cmp->ctx);
+        base = (order < 0 || (upper && order == 0)) ? base + half * vec->element_size : base;
+        size -= half;
+    }
+
+    int order = cmp->func(base, value, cmp->ctx);
+    return (size_t)(base - data) / vec->element_size + (order < 0 || (upper && order == 0));
+}
+
+size_t ccol__vector_find(const ccol_vector_t *vec, const void *value) {
+    size_t width = ccol__vector_integer_width(vec, NULL);
+
+    if (width == sizeof(uint32_t)) {
+        uint32_t key;
+        memcpy(&key, value, sizeof(key));
+#if defined(CCOL__VECTOR_RUNTIME_AVX2)
+        if (ccol__vector_has_avx2()) return ccol__vector_find_u32_avx2(vec->data, vec->size, key);
+#endif
+        return ccol__vector_find_u32(vec->data, vec->size, key);
+    }
+
+    if (width == sizeof(uint64_t)) {
+        uint64_t key;
+        memcpy(&key, value, sizeof(key));
+#if defined(CCOL__VECTOR_RUNTIME_AVX2)
+        if (ccol__vector_has_avx2()) return ccol__vector_find_u64_avx2(vec->data, vec->size, key);
+#endif
+        return ccol__vector_find_u64(vec->data, vec->size, key);
+    }
+
+    for (size_t i = 0; i < vec->size; i++) {
+        void *element = (char *)vec->data + (i * vec->element_size);
+        if (vec->comparator.func(element, value, vec->comparator.ctx) == 0) return i;
+    }
+    return vec->size;
+}
+
+// Sorted search
+ccol_status_t ccol_vector_lower_bound(const ccol_vector_t *vec, const void *value, size_t *index_out) {
+    CCOL_CHECK_INIT(vec);
+    if (!value || !index_out) return CCOL_STATUS_INVALID_ARG;
+    if (!vec->comparator.func) return CCOL_STATUS_COMPARATOR_FUNC;
+
+    *index_out = ccol__vector_bound(vec, value, false);
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_vector_upper_bound(const ccol_vector_t *vec, const void *value, size_t *index_out) {
+    CCOL_CHECK_INIT(vec);
+    if (!value || !index_out) return CCOL_STATUS_INVALID_ARG;
+    if (!vec->comparator.func) return CCOL_STATUS_COMPARATOR_FUNC;
+
+    *index_out = ccol__vector_bound(vec, value, true);
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_vector_equal_range(const ccol_vector_t *vec, const void *value, size_t *begin_out, size_t *end_out) {
+    CCOL_CHECK_INIT(vec);
+    if (!value || !begin_out || !end_out) return CCOL_STATUS_INVALID_ARG;
+    if (!vec->comparator.func) return CCOL_STATUS_COMPARATOR_FUNC;
+
+    *begin_out = ccol__vector_bound(vec, value, false);
+    *end_out = ccol__vector_bound(vec, value, true);
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_vector_binary_search(const ccol_vector_t *vec, const void *value, size_t *index_out) {
+    CCOL_CHECK_INIT(vec);
+    if (!value || !index_out) return CCOL_STATUS_INVALID_ARG;
+    if (!vec->comparator.func) return CCOL_STATUS_COMPARATOR_FUNC;
+
+    size_t index = ccol__vector_bound(vec, value, false);
+    if (index == vec->size) return CCOL_STATUS_NOT_FOUND;
+
+    const void *element = (const char *)vec->data + index * vec->element_size;
+    if (vec->comparator.func(element, value, vec->comparator.ctx) != 0) return CCOL_STATUS_NOT_FOUND;
+
+    *index_out = index;
+    return CCOL_STATUS_OK;
+}
@@ -0,0 +1,329 @@
+/*
+ * ccol/src/vector/sort.c
+ *
+ * In-place sorting for dynamic array (vector).
+ *
+ * General comparators go through an introsort (median-of-three quicksort
+ * that falls back to heapsort past 2 log2(n) levels) or, for the stable
+ * sort, a bottom-up merge sort; both finish small runs with insertion sort.
+ * Built-in integer comparators order exactly like their unsigned bit
+ * pattern once the sign bit is flipped, so those vectors get an LSD radix
+ * sort instead: one byte per pass, and passes where every element shares
+ * the digit are skipped. Radix sort is stable, and equal integers are
+ * identical bytes anyway, so both entry points use it.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "ccol/ccol_vector.h"
+#include "ccol/ccol_comparator.h"
+#include "ccol/ccol_status.h"
+#include "ccol/ccol_macros.h"
+
+#include "vector/internal.h"
+
+// Runs at or below this length are insertion sorted
+#define CCOL__VECTOR_SORT_INSERTION 16
+
+#define CCOL__VECTOR_RADIX_BITS 8
+#define CCOL__VECTOR_RADIX_BUCKETS (1u << CCOL__VECTOR_RADIX_BITS)
+#define CCOL__VECTOR_RADIX_MASK (CCOL__VECTOR_RADIX_BUCKETS - 1)
+
+// Private
+static inline void ccol__vector_swap_bytes(char *a, char *b, size_t width) {
+    // Common element sizes get fixed-size copies the compiler turns into plain moves
+    if (width == sizeof(uint64_t)) {
+        uint64_t tmp;
+        memcpy(&tmp, a, sizeof(tmp));
+        memcpy(a, b, sizeof(tmp));
+        memcpy(b, &tmp, sizeof(tmp));
+        return;
+    }
+    if (width == sizeof(uint32_t)) {
+        uint32_t tmp;
+        memcpy(&tmp, a, sizeof(tmp));
+        memcpy(a, b, sizeof(tmp));
+        memcpy(b, &tmp, sizeof(tmp));
+        return;
+    }
+
+    unsigned char tmp[64];
+    while (width > 0) {
+        size_t n = width < sizeof(tmp) ? width : sizeof(tmp);
+        memcpy(tmp, a, n);
+        memcpy(a, b, n);
+        memcpy(b, tmp, n);
+        a += n;
+        b += n;
+        width -= n;
+    }
+}
+
+static inline int ccol__vector_sort_cmp(const ccol_comparator_t *cmp, const char *a, const char *b) {
+    return cmp->func(a, b, cmp->ctx);
+}
+
+// Stable: an element only moves past strictly greater ones
+static void ccol__vector_insertion_sort(char *base, size_t n, size_t width, const ccol_comparator_t *cmp) {
+    for (size_t i = 1; i < n; i++) {
+        for (size_t j = i; j > 0; j--) {
+            char *cur = base + j * width;
+            if (ccol__vector_sort_cmp(cmp, cur - width, cur) <= 0) break;
+            ccol__vector_swap_bytes(cur - width, cur, width);
+        }
+    }
+}
+
+static void ccol__vector_sift_down(char *base, size_t root, size_t n, size_t width, const ccol_comparator_t *cmp) {
+    for (;;) {
+        size_t child = 2 * root + 1;
+        if (child >= n) return;
+        if (child + 1 < n && ccol__vector_sort_cmp(cmp, base + child * width, base + (child + 1) * width) < 0) child++;
+        if (ccol__vector_sort_cmp(cmp, base + root * width, base + child * width) >= 0) return;
+
+        ccol__vector_swap_bytes(base + root * width, base + child * width, width);
+        root = child;
+    }
+}
+
+static void ccol__vector_heap_sort(char *base, size_t n, size_t width, const ccol_comparator_t *cmp) {
+    for (size_t i = n / 2; i-- > 0;) ccol__vector_sift_down(base, i, n, width, cmp);
+    for (size_t end = n - 1; end > 0; end--) {
+        ccol__vector_swap_bytes(base, base + end * width, width);
+        ccol__vector_sift_down(base, 0, end, width, cmp);
+    }
+}
+
+// Leaves the median of the first, middle and last elements at the front as the pivot
+static void ccol__vector_choose_pivot(char *base, size_t n, size_t width, const ccol_comparator_t *cmp) {
+    char *lo = base;
+    char *mid = base + (n / 2) * width;
+    char *hi = base + (n - 1) * width;
+
+    if (ccol__vector_sort_cmp(cmp, mid, lo) < 0) ccol__vector_swap_bytes(mid, lo, width);
+    if (ccol__vector_sort_cmp(cmp, hi, mid) < 0) {
+        ccol__vector_swap_bytes(hi, mid, width);
+        if (ccol__vector_sort_cmp(cmp, mid, lo) < 0) ccol__vector_swap_bytes(mid, lo, width);
+    }
+    ccol__vector_swap_bytes(lo, mid, width);
+}
+
+// Hoare partition around base[0]; both scans stop on equal keys so runs of duplicates split evenly
+static size_t ccol__vector_partition(char *base, size_t n, size_t width, const ccol_comparator_t *cmp) {
+    size_t i = 0;
+    size_t j = n;
+
+    for (;;) {
+        do i++; while (i < n && ccol__vector_sort_cmp(cmp, base + i * width, base) < 0);
+        do j--; while (ccol__vector_sort_cmp(cmp, base + j * width, base) > 0);
+        if (i >= j) break;
+        ccol__vector_swap_bytes(base + i * width, base + j * width, width);
+    }
+
+    ccol__vector_swap_bytes(base, base + j * width, width);
+    return j;
+}
+
+static void ccol__vector_intro_sort(char *base, size_t n, size_t width, const ccol_comparator_t *cmp, size_t depth) {
+    while (n > CCOL__VECTOR_SORT_INSERTION) {
+        if (depth == 0) {
+            ccol__vector_heap_sort(base, n, width, cmp);
+            return;
+        }
+        depth--;
+
+        ccol__vector_choose_pivot(base, n, width, cmp);
+        size_t pivot = ccol__vector_partition(base, n, width, cmp);
+
+        // Recurse into the smaller side so the stack stays logarithmic
+        size_t left = pivot;
+        size_t right = n - pivot - 1;
+        if (left < right) {
+            ccol__vector_intro_sort(base, left, width, cmp, depth);
+            base += (pivot + 1) * width;
+            n = right;
+        } else {
+            ccol__vector_intro_sort(base + (pivot + 1) * width, right, width, cmp, depth);
+            n = left;
+        }
+    }
+
+    ccol__vector_insertion_sort(base, n, width, cmp);
+}
+
+static void ccol__vector_merge(const char *src, char *dst, size_t lo, size_t mid, size_t hi, size_t width, const ccol_comparator_t *cmp) {
+    // Already in order: one copy instead of a merge
+    if (ccol__vector_sort_cmp(cmp, src + (mid - 1) * width, src + mid * width) <= 0) {
+        memcpy(dst + lo * width, src + lo * width, (hi - lo) * width);
+        return;
+    }
+
+    ccol__vector_merge_runs(src + lo * width, mid - lo, src + mid * width, hi - mid, dst + lo * width, width, cmp);
+}
+
+static void ccol__vector_merge_sort(char *base, char *scratch, size_t n, size_t width, const ccol_comparator_t *cmp) {
+    for (size_t lo = 0; lo < n; lo += CCOL__VECTOR_SORT_INSERTION) {
+        size_t run = n - lo < CCOL__VECTOR_SORT_INSERTION ? n - lo : CCOL__VECTOR_SORT_INSERTION;
+        ccol__vector_insertion_sort(base + lo * width, run, width, cmp);
+    }
+
+    char *src = base;
+    char *dst = scratch;
+    for (size_t run = CCOL__VECTOR_SORT_INSERTION; run < n; run *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * run) {
+            size_t mid = n - lo < run ? n : lo + run;
+            size_t hi = n - lo < 2 * run ? n : lo + 2 * run;
+            if (mid == hi) {
+                memcpy(dst + lo * width, src + lo * width, (hi - lo) * width);
+            } else {
+                ccol__vector_merge(src, dst, lo, mid, hi, width, cmp);
+            }
+        }
+
+        char *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != base) memcpy(base, src, n * width);
+}
+
+// LSD radix sort on keys read as unsigned; flip is the sign bit for signed types, 0 otherwise
+#define CCOL__VECTOR_RADIX_SORT(suffix, type)                                                        \
+    static void ccol__vector_radix_sort_##suffix(type *data, type *scratch, size_t n, type flip) {   \
+        size_t counts[sizeof(type)][CCOL__VECTOR_RADIX_BUCKETS];                                     \
+        memset(counts, 0, sizeof(counts));                                                           \
+                                                                                                     \
+        for (size_t i = 0; i < n; i++) {                                                             \
+            type key = (type)(data[i] ^ flip);                                                       \
+            for (size_t d = 0; d < sizeof(type); d++) {                                              \
+                counts[d][(key >> (d * CCOL__VECTOR_RADIX_BITS)) & CCOL__VECTOR_RADIX_MASK]++;       \
+            }                                                                                        \
+        }                                                                                            \
+                                                                                                     \
+        type *src = data;                                                                            \
+        type *dst = scratch;                                                                         \
+        for (size_t d = 0; d < sizeof(type); d++) {                                                  \
+            size_t shift = d * CCOL__VECTOR_RADIX_BITS;                                              \
+            size_t *count = counts[d];                                                               \
+            if (count[((type)(src[0] ^ flip) >> shift) & CCOL__VECTOR_RADIX_MASK] == n) continue;    \
+                                                                                                     \
+            size_t offset = 0;                                                                       \
+            for (size_t b = 0; b < CCOL__VECTOR_RADIX_BUCKETS; b++) {                                \
+                size_t c = count[b];                                                                 \
+                count[b] = offset;                                                                   \
+                offset += c;                                                                         \
+            }                                                                                        \
+            for (size_t i = 0; i < n; i++) {                                                         \
+                dst[count[((type)(src[i] ^ flip) >> shift) & CCOL__VECTOR_RADIX_MASK]++] = src[i];   \
+            }                                                                                        \
+                                                                                                     \
+            type *tmp = src;                                                                         \
+            src = dst;                                                                               \
+            dst = tmp;                                                                               \
+        }                                                                                            \
+                                                                                                     \
+        if (src != data) memcpy(data, src, n * sizeof(type));                                        \
+    }
+
+CCOL__VECTOR_RADIX_SORT(u8, uint8_t)
+CCOL__VECTOR_RADIX_SORT(u16, uint16_t)
+CCOL__VECTOR_RADIX_SORT(u32, uint32_t)
+CCOL__VECTOR_RADIX_SORT(u64, uint64_t)
+
+// Returns false when the scratch buffer cannot be allocated, leaving the elements untouched
+static bool ccol__vector_radix_sort(void *base, size_t n, size_t width, bool is_signed) {
+    void *scratch = malloc(n * width);
+    if (!scratch) return false;
+
+    switch (width) {
+        case sizeof(uint8_t):
+            ccol__vector_radix_sort_u8(base, scratch, n, is_signed ? (uint8_t)0x80 : 0);
+            break;
+        case sizeof(uint16_t):
+            ccol__vector_radix_sort_u16(base, scratch, n, is_signed ? (uint16_t)0x8000 : 0);
+            break;
+        case sizeof(uint32_t):
+            ccol__vector_radix_sort_u32(base, scratch, n, is_signed ? (uint32_t)1 << 31 : 0);
+            break;
+        default:
+            ccol__vector_radix_sort_u64(base, scratch, n, is_signed ? (uint64_t)1 << 63 : 0);
+            break;
+    }
+
+    free(scratch);
+    return true;
+}
+
+static size_t ccol__vector_sort_depth(size_t n) {
+    size_t depth = 0;
+    while (n > 1) {
+        n >>= 1;
+        depth += 2;
+    }
+    return depth;
+}
+
+// Public (internal to the library)
+void ccol__vector_merge_runs(const char *a, size_t a_n, const char *b, size_t b_n, char *out, size_t width, const ccol_comparator_t *cmp) {
+    size_t i = 0, j = 0;
+    while (i < a_n && j < b_n) {
+        // Ties take the first run, which keeps the sort stable
+        if (ccol__vector_sort_cmp(cmp, b + j * width, a + i * width) < 0) {
+            memcpy(out, b + j++ * width, width);
+        } else {
+            memcpy(out, a + i++ * width, width);
+        }
+        out += width;
+    }
+    if (i < a_n) memcpy(out, a + i * width, (a_n - i) * width);
+    if (j < b_n) memcpy(out, b + j * width, (b_n - j) * width);
+}
+
+void ccol__vector_sort_range(const ccol_vector_t *vec, char *base, size_t n) {
+    if (n < 2) return;
+
+    bool is_signed = false;
+    size_t width = ccol__vector_integer_width(vec, &is_signed);
+    if (width && ccol__vector_radix_sort(base, n, width, is_signed)) return;
+
+    // Out of memory for the radix buffer: the introsort needs none
+    ccol__vector_intro_sort(base, n, vec->element_size, &vec->comparator, ccol__vector_sort_depth(n));
+}
+
+// Sorting
+ccol_status_t ccol_vector_sort(ccol_vector_t *vec) {
+    CCOL_CHECK_INIT(vec);
+    if (!vec->comparator.func) return CCOL_STATUS_COMPARATOR_FUNC;
+
+    ccol__vector_sort_range(vec, vec->data, vec->size);
+    return CCOL_STATUS_OK;
+}
+
+ccol_status_t ccol_vector_stable_sort(ccol_vector_t *vec) {
+    CCOL_CHECK_INIT(vec);
+    if (!vec->comparator.func) return CCOL_STATUS_COMPARATOR_FUNC;
+    if (vec->size < 2) return CCOL_STATUS_OK;
+
+    // Equal integers are indistinguishable, so any correct order is a stable one
+    if (ccol__vector_integer_width(vec, NULL)) return ccol_vector_sort(vec);
+
+    if (vec->size <= CCOL__VECTOR_SORT_INSERTION) {
+        ccol__vector_insertion_sort(vec->data, vec->size, vec->element_size, &vec->comparator);
+        return CCOL_STATUS_OK;
+    }
+
+    char *scratch = malloc(vec->size * vec->element_size);
+    if (!scratch) return CCOL_STATUS_ALLOC;
+
+    ccol__vector_merge_sort(vec->data, scratch, vec->size, vec->element_size, &vec->comparator);
+    free(scratch);
+    return CCOL_STATUS_OK;
+}
@@ -0,0 +1,307 @@
+/*
+ * tests/test_concurrent_hash_table.c
+ *
+ * Concurrent hash table unit tests.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L  // pthread rwlocks under -std=c99
+#endif
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "unity.h"
+#include "ccol/ccol_hash.h"
+#include "ccol/ccol_hash_table.h"
+#include "ccol/ccol_concurrent_hash_table.h"
+#include "ccol/ccol_comparator.h"
+#include "ccol/ccol_epoch.h"
+
+#include "concurrent_hash_table/internal.h"
+
+#define TEST_THREAD_COUNT 8
+#define TEST_KEYS_PER_THREAD 2000
+
+static ccol_comparator_t key_cmp;
+
+void setUp(void) {
+    key_cmp = ccol_comparator_create(ccol_cmp_int32, NULL);
+}
+
+void tearDown(void) {}
+
+static ccol_concurrent_hash_table_t *create_int32_table(
+    ccol_hash_table_engine_t engine,
+    ccol_concurrent_hash_table_mode_t mode,
+    ccol_hash_policy_t policy,
+    size_t num_shards
+) {
+    ccol_hash_t hasher;
+    TEST_ASSERT_EQUAL(
+        CCOL_STATUS_OK,
+        ccol_hash_create_from_policy(sizeof(int32_t), policy, NULL, &hasher)
+    );
+
+    ccol_concurrent_hash_table_t *table = NULL;
+    ccol_status_t status = ccol_concurrent_hash_table_create(
+        &table,
+        num_shards,
+        16,
+        sizeof(int32_t),
+        engine,
+        mode,
+        policy,
+        hasher,
+        (ccol_copy_t){0},
+        (ccol_free_t){0},
+        (ccol_print_t){0},
+        ccol_comparator_create(ccol_cmp_hash_entry_key, &key_cmp)
+    );
+
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, status);
+    TEST_ASSERT_NOT_NULL(table);
+    return table;
+}
+
+void test_ccol_concurrent_hash_table_basic(void) {
+    ccol_concurrent_hash_table_t *table = create_int32_table(CCOL_HASH_TABLE_CHAINED, CCOL_CONCURRENT_HASH_TABLE_LOCKED, CCOL_HASH_SIMPLE, 5);
+    TEST_ASSERT_EQUAL(8, ccol_concurrent_hash_table_num_shards(table));
+
+    static int32_t keys[1000];
+    for (int32_t i = 0; i < 1000; i++) {
+        keys[i] = i;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_concurrent_hash_table_insert(table, &keys[i], &keys[i]));
+    }
+    TEST_ASSERT_EQUAL(CCOL_STATUS_ALREADY_EXISTS, ccol_concurrent_hash_table_insert(table, &keys[0], NULL));
+    TEST_ASSERT_EQUAL(1000, ccol_concurrent_hash_table_size(table));
+
+    // Small keys hashed with SIMPLE still reach every shard
+    for (size_t i = 0; i < table->num_shards; i++) {
+        TEST_ASSERT_TRUE(ccol_hash_table_size(table->shards[i].table) > 0);
+    }
+
+    void *value = NULL;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_concurrent_hash_table_get(table, &keys[500], &value));
+    TEST_ASSERT_EQUAL_PTR(&keys[500], value);
+
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_concurrent_hash_table_remove(table, &keys[500]));
+    TEST_ASSERT_EQUAL(CCOL_STATUS_NOT_FOUND, ccol_concurrent_hash_table_remove(table, &keys[500]));
+    TEST_ASSERT_FALSE(ccol_concurrent_hash_table_contains_key(table, &keys[500]));
+
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_concurrent_hash_table_clear(table));
+    TEST_ASSERT_TRUE(ccol_concurrent_hash_table_is_empty(table));
+
+    ccol_concurrent_hash_table_free(&table);
+}
+
+typedef struct test_worker {
+    ccol_concurrent_hash_table_t *table;
+    int32_t *keys;  // this worker's own range
+    size_t failures;
+} test_worker_t;
+
+// Each worker inserts its own keys, reads them back, and removes every other one
+static void *test_worker_run(void *arg) {
+    test_worker_t *worker = (test_worker_t *)arg;
+
+    for (size_t i = 0; i < TEST_KEYS_PER_THREAD; i++) {
+        if (ccol_concurrent_hash_table_insert(worker->table, &worker->keys[i], &worker->keys[i]) != CCOL_STATUS_OK) {
+            worker->failures++;
+        }
+    }
+
+    for (size_t i = 0; i < TEST_KEYS_PER_THREAD; i++) {
+        void *value = NULL;
+        if (ccol_concurrent_hash_table_get(worker->table, &worker->keys[i], &value) != CCOL_STATUS_OK ||
+            value != &worker->keys[i]) {
+            worker->failures++;
+        }
+    }
+
+    for (size_t i = 0; i < TEST_KEYS_PER_THREAD; i += 2) {
+        if (ccol_concurrent_hash_table_remove(worker->table, &worker->keys[i]) != CCOL_STATUS_OK) {
+            worker->failures++;
+        }
+    }
+
+    return NULL;
+}
+
+static void run_threads(ccol_hash_table_engine_t engine, ccol_concurrent_hash_table_mode_t mode, ccol_hash_policy_t policy) {
+    ccol_concurrent_hash_table_t *table = create_int32_table(engine, mode, policy, 16);
+
+    static int32_t keys[TEST_THREAD_COUNT * TEST_KEYS_PER_THREAD];
+    for (size_t i = 0; i < TEST_THREAD_COUNT * TEST_KEYS_PER_THREAD; i++) keys[i] = (int32_t)i;
+
+    pthread_t threads[TEST_THREAD_COUNT];
+    test_worker_t workers[TEST_THREAD_COUNT];
+    for (size_t t = 0; t < TEST_THREAD_COUNT; t++) {
+        workers[t] = (test_worker_t){ table, &keys[t * TEST_KEYS_PER_THREAD], 0 };
+        TEST_ASSERT_EQUAL(0, pthread_create(&threads[t], NULL, test_worker_run, &workers[t]));
+    }
+
+    for (size_t t = 0; t < TEST_THREAD_COUNT; t++) {
+        pthread_join(threads[t], NULL);
+        TEST_ASSERT_EQUAL(0, workers[t].failures);
+    }
+
+    TEST_ASSERT_EQUAL(TEST_THREAD_COUNT * TEST_KEYS_PER_THREAD / 2, ccol_concurrent_hash_table_size(table));
+    for (size_t i = 0; i < TEST_THREAD_COUNT * TEST_KEYS_PER_THREAD; i++) {
+        TEST_ASSERT_EQUAL(i % 2 == 1, ccol_concurrent_hash_table_contains_key(table, &keys[i]));
+    }
+
+    ccol_concurrent_hash_table_free(&table);
+}
+
+void test_ccol_concurrent_hash_table_threads_chained(void) {
+    run_threads(CCOL_HASH_TABLE_CHAINED, CCOL_CONCURRENT_HASH_TABLE_LOCKED, CCOL_HASH_ROBUST);
+}
+
+void test_ccol_concurrent_hash_table_threads_swiss(void) {
+    // No ctx: one random key shared by every shard
+    run_threads(CCOL_HASH_TABLE_SWISS, CCOL_CONCURRENT_HASH_TABLE_LOCKED, CCOL_HASH_SECURE);
+}
+
+void test_ccol_concurrent_hash_table_threads_read_mostly(void) {
+    run_threads(CCOL_HASH_TABLE_CHAINED, CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY, CCOL_HASH_ROBUST);
+}
+
+static void *claim_record(void *arg) {
+    return ccol_epoch_thread_record((ccol_epoch_t *)arg);
+}
+
+void test_ccol_concurrent_hash_table_epoch_record_reuse(void) {
+    ccol_epoch_t *epoch = NULL;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_epoch_create(&epoch));
+
+    // An exited thread hands its record back, and the next thread claims it
+    pthread_t thread;
+    void *first = NULL;
+    void *second = NULL;
+    TEST_ASSERT_EQUAL(0, pthread_create(&thread, NULL, claim_record, epoch));
+    pthread_join(thread, &first);
+    TEST_ASSERT_EQUAL(0, pthread_create(&thread, NULL, claim_record, epoch));
+    pthread_join(thread, &second);
+
+    TEST_ASSERT_NOT_NULL(first);
+    TEST_ASSERT_EQUAL_PTR(first, second);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)first % 64);
+
+    // A live thread keeps its own
+    ccol_epoch_record_t *record = ccol_epoch_thread_record(epoch);
+    TEST_ASSERT_NOT_NULL(record);
+    TEST_ASSERT_EQUAL_PTR(first, record);
+    TEST_ASSERT_EQUAL(0, pthread_create(&thread, NULL, claim_record, epoch));
+    pthread_join(thread, &second);
+    TEST_ASSERT_NOT_EQUAL(record, second);
+
+    ccol_epoch_free(&epoch);
+}
+
+void test_ccol_concurrent_hash_table_epoch_record_eviction(void) {
+    enum { DOMAINS = 12, ROUNDS = 1000 };
+    ccol_epoch_t *epochs[DOMAINS];
+    ccol_epoch_record_t *records[DOMAINS];
+    for (int i = 0; i < DOMAINS; i++) {
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_epoch_create(&epochs[i]));
+        records[i] = ccol_epoch_thread_record(epochs[i]);
+        TEST_ASSERT_NOT_NULL(records[i]);
+    }
+
+    // Rotating over more domains than the thread cache holds hands each evicted record back,
+    // so every call reclaims the same one instead of registering another
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < DOMAINS; i++) {
+            TEST_ASSERT_EQUAL_PTR(records[i], ccol_epoch_thread_record(epochs[i]));
+        }
+    }
+
+    // A record inside a section is never evicted out from under its reader
+    ccol_epoch_enter(records[0]);
+    for (int i = 1; i < DOMAINS; i++) ccol_epoch_thread_record(epochs[i]);
+    TEST_ASSERT_EQUAL_PTR(records[0], ccol_epoch_thread_record(epochs[0]));
+    ccol_epoch_exit(records[0]);
+
+    for (int i = 0; i < DOMAINS; i++) ccol_epoch_free(&epochs[i]);
+}
+
+static size_t released;
+
+static void count_release(void *ptr, void *ctx) {
+    (void)ptr;
+    (void)ctx;
+    released++;
+}
+
+void test_ccol_concurrent_hash_table_read_mostly_epoch(void) {
+    ccol_concurrent_hash_table_t *table = create_int32_table(
+        CCOL_HASH_TABLE_CHAINED, CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY, CCOL_HASH_ROBUST, 4
+    );
+    ccol_epoch_t *epoch = ccol_concurrent_hash_table_epoch(table);
+    TEST_ASSERT_NOT_NULL(epoch);
+
+    // Growing and shrinking every shard exercises the array swap
+    static int32_t keys[1000];
+    for (int32_t i = 0; i < 1000; i++) {
+        keys[i] = i;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_concurrent_hash_table_insert(table, &keys[i], &keys[i]));
+    }
+    for (int32_t i = 0; i < 1000; i += 2) {
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_concurrent_hash_table_remove(table, &keys[i]));
+    }
+    TEST_ASSERT_EQUAL(500, ccol_concurrent_hash_table_size(table));
+    for (int32_t i = 0; i < 1000; i++) {
+        TEST_ASSERT_EQUAL(i % 2 == 1, ccol_concurrent_hash_table_contains_key(table, &keys[i]));
+    }
+
+    // A retire is held back while a reader is inside, and runs once it leaves
+    ccol_epoch_record_t *record = ccol_epoch_thread_record(epoch);
+    TEST_ASSERT_NOT_NULL(record);
+    ccol_epoch_reclaim(epoch);
+    ccol_epoch_reclaim(epoch);
+
+    released = 0;
+    ccol_epoch_enter(record);
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_epoch_retire(epoch, &keys[1], count_release, NULL));
+    ccol_epoch_reclaim(epoch);
+    ccol_epoch_reclaim(epoch);
+    TEST_ASSERT_EQUAL(0, released);
+    ccol_epoch_exit(record);
+
+    ccol_epoch_synchronize(epoch);
+    ccol_epoch_reclaim(epoch);
+    TEST_ASSERT_EQUAL(1, released);
+
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_concurrent_hash_table_clear(table));
+    TEST_ASSERT_TRUE(ccol_concurrent_hash_table_is_empty(table));
+
+    // Lock-free reads need the chained layout
+    ccol_concurrent_hash_table_t rejected;
+    ccol_hash_t hasher;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_create_from_policy(sizeof(int32_t), CCOL_HASH_ROBUST, NULL, &hasher));
+    TEST_ASSERT_EQUAL(CCOL_STATUS_INVALID_ARG, ccol_concurrent_hash_table_init(
+        &rejected, 4, 16, sizeof(int32_t), CCOL_HASH_TABLE_SWISS, CCOL_CONCURRENT_HASH_TABLE_READ_MOSTLY,
+        CCOL_HASH_ROBUST, hasher, (ccol_copy_t){0}, (ccol_free_t){0}, (ccol_print_t){0},
+        ccol_comparator_create(ccol_cmp_hash_entry_key, &key_cmp)
+    ));
+
+    ccol_concurrent_hash_table_free(&table);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_ccol_concurrent_hash_table_basic);
+    RUN_TEST(test_ccol_concurrent_hash_table_threads_chained);
+    RUN_TEST(test_ccol_concurrent_hash_table_threads_swiss);
+    RUN_TEST(test_ccol_concurrent_hash_table_threads_read_mostly);
+    RUN_TEST(test_ccol_concurrent_hash_table_read_mostly_epoch);
+    RUN_TEST(test_ccol_concurrent_hash_table_epoch_record_reuse);
+    RUN_TEST(test_ccol_concurrent_hash_table_epoch_record_eviction);
+    return UNITY_END();
+}
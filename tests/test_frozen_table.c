@@ -0,0 +1,180 @@
+/*
+ * tests/test_frozen_table.c
+ *
+ * Frozen table unit tests.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "unity.h"
+#include "ccol/ccol_hash.h"
+#include "ccol/ccol_hash_table.h"
+#include "ccol/ccol_frozen_table.h"
+#include "ccol/ccol_comparator.h"
+#include "frozen_table/internal.h"
+
+#define TEST_KEY_COUNT 1000
+#define TEST_FROZEN_PATH "test_frozen_table.bin"
+
+static ccol_comparator_t key_cmp;
+
+void setUp(void) {
+    key_cmp = ccol_comparator_create(ccol_cmp_int32, NULL);
+}
+
+void tearDown(void) {
+    remove(TEST_FROZEN_PATH);
+}
+
+static ccol_hash_table_t *create_int32_table(ccol_hash_table_engine_t engine, ccol_hash_policy_t policy) {
+    ccol_hash_t hasher;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_create_from_policy(sizeof(int32_t), policy, NULL, &hasher));
+
+    ccol_hash_table_t *hash_table = NULL;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_create_with_engine(
+        &hash_table,
+        16,
+        sizeof(int32_t),
+        engine,
+        policy,
+        hasher,
+        (ccol_copy_t){0},
+        (ccol_free_t){0},
+        (ccol_print_t){0},
+        ccol_comparator_create(ccol_cmp_hash_entry_key, &key_cmp)
+    ));
+    return hash_table;
+}
+
+void test_ccol_frozen_table_round_trip(void) {
+    ccol_hash_table_engine_t engines[] = { CCOL_HASH_TABLE_CHAINED, CCOL_HASH_TABLE_SWISS, CCOL_HASH_TABLE_ROBIN_HOOD };
+
+    static int32_t keys[TEST_KEY_COUNT];
+    static int64_t values[TEST_KEY_COUNT];
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+        keys[i] = i * 2;
+        values[i] = (int64_t)i * 1000003;
+    }
+
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        // SECURE keys are per table; the file must not depend on them
+        ccol_hash_table_t *hash_table = create_int32_table(engines[e], CCOL_HASH_SECURE);
+        for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_insert(hash_table, &keys[i], &values[i]));
+        }
+
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_freeze(hash_table, sizeof(int64_t), TEST_FROZEN_PATH));
+        ccol_hash_table_free(&hash_table);
+
+        ccol_frozen_table_t frozen;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_frozen_table_open(&frozen, TEST_FROZEN_PATH));
+        TEST_ASSERT_EQUAL(TEST_KEY_COUNT, ccol_frozen_table_size(&frozen));
+        TEST_ASSERT_EQUAL(sizeof(int32_t), ccol_frozen_table_key_size(&frozen));
+        TEST_ASSERT_EQUAL(sizeof(int64_t), ccol_frozen_table_value_size(&frozen));
+
+        for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+            const void *value = NULL;
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_frozen_table_get(&frozen, &keys[i], &value));
+            TEST_ASSERT_EQUAL_INT64(values[i], *(const int64_t *)value);
+
+            int32_t miss = keys[i] + 1;
+            TEST_ASSERT_FALSE(ccol_frozen_table_contains_key(&frozen, &miss));
+            TEST_ASSERT_EQUAL(CCOL_STATUS_NOT_FOUND, ccol_frozen_table_get(&frozen, &miss, &value));
+        }
+
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_frozen_table_close(&frozen));
+        TEST_ASSERT_FALSE(frozen.is_initialized);
+    }
+}
+
+// Rewrites one uint64_t header field of the file at TEST_FROZEN_PATH
+static void patch_header(const unsigned char *image, size_t size, size_t field_offset, uint64_t value) {
+    unsigned char *copy = malloc(size);
+    TEST_ASSERT_NOT_NULL(copy);
+    memcpy(copy, image, size);
+    memcpy(copy + field_offset, &value, sizeof(value));
+
+    FILE *file = fopen(TEST_FROZEN_PATH, "wb");
+    TEST_ASSERT_NOT_NULL(file);
+    TEST_ASSERT_EQUAL(size, fwrite(copy, 1, size, file));
+    fclose(file);
+    free(copy);
+}
+
+void test_ccol_frozen_table_rejects_bad_files(void) {
+    ccol_hash_table_t *hash_table = create_int32_table(CCOL_HASH_TABLE_CHAINED, CCOL_HASH_SIMPLE);
+    int32_t key = 7;
+    ccol_hash_table_insert(hash_table, &key, NULL);
+
+    // Key set: no values stored
+    ccol_frozen_table_t frozen;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_freeze(hash_table, 0, TEST_FROZEN_PATH));
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_frozen_table_open(&frozen, TEST_FROZEN_PATH));
+    TEST_ASSERT_TRUE(ccol_frozen_table_contains_key(&frozen, &key));
+    ccol_frozen_table_close(&frozen);
+    ccol_hash_table_free(&hash_table);
+
+    // Crafted headers: each field alone must be enough to reject the file
+    FILE *file = fopen(TEST_FROZEN_PATH, "rb");
+    TEST_ASSERT_NOT_NULL(file);
+    static unsigned char image[1 << 16];
+    size_t image_size = fread(image, 1, sizeof(image), file);
+    fclose(file);
+    TEST_ASSERT_TRUE(image_size > sizeof(ccol__frozen_header_t) && image_size < sizeof(image));
+
+    ccol__frozen_header_t header;
+    memcpy(&header, image, sizeof(header));
+    struct {
+        size_t field;
+        uint64_t value;
+    } crafted[] = {
+        { offsetof(ccol__frozen_header_t, record_size), 0 },
+        { offsetof(ccol__frozen_header_t, value_offset), header.record_size + 8 },
+        { offsetof(ccol__frozen_header_t, value_size), header.record_size - header.value_offset + 1 },
+        { offsetof(ccol__frozen_header_t, ctrl_offset), UINT64_MAX - 7 },
+        { offsetof(ccol__frozen_header_t, hashes_offset), header.ctrl_offset - 8 },
+        { offsetof(ccol__frozen_header_t, hashes_offset), UINT64_MAX - 3 },
+        { offsetof(ccol__frozen_header_t, records_offset), UINT64_MAX - 7 },
+    };
+    for (size_t i = 0; i < sizeof(crafted) / sizeof(crafted[0]); i++) {
+        patch_header(image, image_size, crafted[i].field, crafted[i].value);
+        TEST_ASSERT_EQUAL(CCOL_STATUS_INVALID_ARG, ccol_frozen_table_open(&frozen, TEST_FROZEN_PATH));
+        TEST_ASSERT_FALSE(frozen.is_initialized);
+    }
+
+    // Truncated file
+    file = fopen(TEST_FROZEN_PATH, "wb");
+    TEST_ASSERT_NOT_NULL(file);
+    fputs("CCOLFRZ1", file);
+    fclose(file);
+    TEST_ASSERT_EQUAL(CCOL_STATUS_INVALID_ARG, ccol_frozen_table_open(&frozen, TEST_FROZEN_PATH));
+    TEST_ASSERT_FALSE(frozen.is_initialized);
+
+    // Wrong magic
+    file = fopen(TEST_FROZEN_PATH, "wb");
+    TEST_ASSERT_NOT_NULL(file);
+    for (int i = 0; i < 256; i++) fputc('x', file);
+    fclose(file);
+    TEST_ASSERT_EQUAL(CCOL_STATUS_INVALID_ARG, ccol_frozen_table_open(&frozen, TEST_FROZEN_PATH));
+
+    remove(TEST_FROZEN_PATH);
+    TEST_ASSERT_EQUAL(CCOL_STATUS_ERROR, ccol_frozen_table_open(&frozen, TEST_FROZEN_PATH));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Run tests
+    RUN_TEST(test_ccol_frozen_table_round_trip);
+    RUN_TEST(test_ccol_frozen_table_rejects_bad_files);
+
+    return UNITY_END();
+}
@@ -1,8 +1,801 @@
 /*
- * ccol/test_hash_table.c
- *
+ * tests/test_hash_table.c
  *
+ * Hash table unit tests.
  *
  * Created by Jack Einbinder
  * Copyright (C) 2025 Jack Einbinder
  */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "unity.h"
+#include "ccol/ccol_hash.h"
+#include "ccol/ccol_hash_table.h"
+#include "ccol/ccol_hash_table_iterator.h"
+#include "ccol/ccol_comparator.h"
+
+#include "robust.h"
+#include "hash_table/internal.h"
+#include "hash_table/engines/robin_hood.h"
+
+#define TEST_KEY_COUNT 1000
+
+static ccol_comparator_t key_cmp;
+
+void setUp(void) {
+    key_cmp = ccol_comparator_create(ccol_cmp_int32, NULL);
+}
+
+void tearDown(void) {}
+
+static ccol_hash_table_t *create_int32_table_with_policy(
+    ccol_hash_table_engine_t engine,
+    ccol_hash_policy_t policy,
+    size_t num_buckets
+) {
+    ccol_hash_t hasher;
+    TEST_ASSERT_EQUAL(
+        CCOL_STATUS_OK,
+        ccol_hash_create_from_policy(sizeof(int32_t), policy, NULL, &hasher)
+    );
+
+    ccol_hash_table_t *hash_table = NULL;
+    ccol_status_t status = ccol_hash_table_create_with_engine(
+        &hash_table,
+        num_buckets,
+        sizeof(int32_t),
+        engine,
+        policy,
+        hasher,
+        (ccol_copy_t){0},
+        (ccol_free_t){0},
+        (ccol_print_t){0},
+        ccol_comparator_create(ccol_cmp_hash_entry_key, &key_cmp)
+    );
+
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, status);
+    TEST_ASSERT_NOT_NULL(hash_table);
+    return hash_table;
+}
+
+static ccol_hash_table_t *create_int32_table(ccol_hash_table_engine_t engine, size_t num_buckets) {
+    return create_int32_table_with_policy(engine, CCOL_HASH_SIMPLE, num_buckets);
+}
+
+void test_ccol_hash_table_create_chained(void) {
+    ccol_hash_table_t *hash_table = create_int32_table(CCOL_HASH_TABLE_CHAINED, 16);
+
+    TEST_ASSERT_TRUE(hash_table->is_initialized);
+    TEST_ASSERT_EQUAL(CCOL_HASH_TABLE_CHAINED, hash_table->engine);
+    TEST_ASSERT_EQUAL(16, ccol_hash_table_num_buckets(hash_table));
+    TEST_ASSERT_TRUE(ccol_hash_table_is_empty(hash_table));
+
+    ccol_hash_table_free(&hash_table);
+    TEST_ASSERT_NULL(hash_table);
+
+    // The engine-less create defaults to chaining
+    ccol_hash_t hasher;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_create_from_policy(sizeof(int32_t), CCOL_HASH_SIMPLE, NULL, &hasher));
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_create(
+        &hash_table, 16, sizeof(int32_t), CCOL_HASH_SIMPLE, hasher,
+        (ccol_copy_t){0}, (ccol_free_t){0}, (ccol_print_t){0},
+        ccol_comparator_create(ccol_cmp_hash_entry_key, &key_cmp)
+    ));
+    TEST_ASSERT_EQUAL(CCOL_HASH_TABLE_CHAINED, hash_table->engine);
+    ccol_hash_table_free(&hash_table);
+}
+
+void test_ccol_hash_table_init_with_engine(void) {
+    ccol_hash_t hasher;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_create_from_policy(sizeof(int32_t), CCOL_HASH_SECURE, NULL, &hasher));
+
+    ccol_hash_table_t hash_table;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_init_with_engine(
+        &hash_table, 8, sizeof(int32_t), CCOL_HASH_TABLE_ROBIN_HOOD, CCOL_HASH_SECURE, hasher,
+        (ccol_copy_t){0}, (ccol_free_t){0}, (ccol_print_t){0},
+        ccol_comparator_create(ccol_cmp_hash_entry_key, &key_cmp)
+    ));
+    TEST_ASSERT_EQUAL(CCOL_HASH_TABLE_ROBIN_HOOD, hash_table.engine);
+    TEST_ASSERT_EQUAL_PTR(&hash_table.hash_key, hash_table.hasher.ctx);
+
+    static int32_t keys[TEST_KEY_COUNT];
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+        keys[i] = i;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_insert(&hash_table, &keys[i], &keys[i]));
+    }
+    TEST_ASSERT_EQUAL(TEST_KEY_COUNT, ccol_hash_table_size(&hash_table));
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_destroy(&hash_table));
+
+    TEST_ASSERT_EQUAL(CCOL_STATUS_INVALID_ARG, ccol_hash_table_init_with_engine(
+        &hash_table, 8, sizeof(int32_t), (ccol_hash_table_engine_t)7, CCOL_HASH_SECURE, hasher,
+        (ccol_copy_t){0}, (ccol_free_t){0}, (ccol_print_t){0},
+        ccol_comparator_create(ccol_cmp_hash_entry_key, &key_cmp)
+    ));
+}
+
+void test_ccol_hash_table_create_swiss(void) {
+    ccol_hash_table_t *hash_table = create_int32_table(CCOL_HASH_TABLE_SWISS, 10);
+
+    TEST_ASSERT_EQUAL(CCOL_HASH_TABLE_SWISS, hash_table->engine);
+    TEST_ASSERT_EQUAL(16, ccol_hash_table_num_buckets(hash_table));  // rounded to a power of two
+    TEST_ASSERT_NULL(hash_table->buckets);
+
+    ccol_hash_table_free(&hash_table);
+}
+
+// SIMPLE hashes of dense integers differ only in their low bits; the home group must still spread them
+void test_ccol_hash_table_swiss_sequential_keys(void) {
+    enum { SEQUENTIAL_KEY_COUNT = 100000 };
+    ccol_hash_table_t *hash_table = create_int32_table(CCOL_HASH_TABLE_SWISS, 8);
+
+    static int32_t keys[SEQUENTIAL_KEY_COUNT];
+    for (int32_t i = 0; i < SEQUENTIAL_KEY_COUNT; i++) {
+        keys[i] = i;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_insert(hash_table, &keys[i], &keys[i]));
+    }
+
+    ccol_hash_table_stats_t stats;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_stats(hash_table, &stats));
+    TEST_ASSERT_EQUAL(SEQUENTIAL_KEY_COUNT, stats.size);
+    TEST_ASSERT_TRUE(stats.mean_chain < 1.5);
+    TEST_ASSERT_TRUE(stats.max_chain <= 16);
+
+    for (int32_t i = 0; i < SEQUENTIAL_KEY_COUNT; i++) {
+        TEST_ASSERT_TRUE(ccol_hash_table_contains_key(hash_table, &keys[i]));
+    }
+
+    ccol_hash_table_free(&hash_table);
+}
+
+void test_ccol_hash_table_swiss_insert_get_remove(void) {
+    ccol_hash_table_t *hash_table = create_int32_table(CCOL_HASH_TABLE_SWISS, 8);
+
+    static int32_t keys[TEST_KEY_COUNT];
+    static int32_t values[TEST_KEY_COUNT];
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+        keys[i] = i * 7919;
+        values[i] = -i;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_insert(hash_table, &keys[i], &values[i]));
+    }
+
+    TEST_ASSERT_EQUAL(TEST_KEY_COUNT, ccol_hash_table_size(hash_table));
+    TEST_ASSERT_EQUAL(CCOL_STATUS_ALREADY_EXISTS, ccol_hash_table_insert(hash_table, &keys[3], &values[3]));
+
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+        void *value = NULL;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_get(hash_table, &keys[i], &value));
+        TEST_ASSERT_EQUAL_PTR(&values[i], value);
+    }
+
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i += 2) {
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_remove(hash_table, &keys[i]));
+    }
+
+    TEST_ASSERT_EQUAL(TEST_KEY_COUNT / 2, ccol_hash_table_size(hash_table));
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+        TEST_ASSERT_EQUAL(i % 2 == 1, ccol_hash_table_contains_key(hash_table, &keys[i]));
+    }
+
+    ccol_hash_table_free(&hash_table);
+}
+
+// Same ordering as ccol_cmp_uint64, but not recognised as an integer comparator
+static int cmp_uint64_opaque(const void *a, const void *b, void *ctx) {
+    return ccol_cmp_uint64(a, b, ctx);
+}
+
+void test_ccol_hash_table_swiss_inline_keys(void) {
+    static ccol_comparator_t cmps[2];
+    cmps[0] = ccol_comparator_create(ccol_cmp_uint64, NULL);
+    cmps[1] = ccol_comparator_create(cmp_uint64_opaque, NULL);
+
+    static uint64_t keys[TEST_KEY_COUNT];
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) keys[i] = (uint64_t)i << 33 | (uint64_t)i;
+
+    for (size_t c = 0; c < 2; c++) {
+        ccol_hash_t hasher;
+        ccol_hash_create_from_policy(sizeof(uint64_t), CCOL_HASH_ROBUST, NULL, &hasher);
+
+        ccol_hash_table_t *hash_table = NULL;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_create_with_engine(
+            &hash_table,
+            8,
+            sizeof(uint64_t),
+            CCOL_HASH_TABLE_SWISS,
+            CCOL_HASH_ROBUST,
+            hasher,
+            (ccol_copy_t){0},
+            (ccol_free_t){0},
+            (ccol_print_t){0},
+            ccol_comparator_create(ccol_cmp_hash_entry_key, &cmps[c])
+        ));
+        TEST_ASSERT_EQUAL(c == 0 ? sizeof(uint64_t) : 0, hash_table->inline_key_size);
+
+        for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_insert(hash_table, &keys[i], &keys[i]));
+        }
+        for (int32_t i = 0; i < TEST_KEY_COUNT; i += 3) {
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_remove(hash_table, &keys[i]));
+        }
+
+        // Lookups by an equal key at another address; removed slots keep stale inline keys
+        ccol_hash_table_t *clone = NULL;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_shallow_clone(hash_table, &clone));
+        for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+            uint64_t probe = keys[i];
+            void *value = NULL;
+            ccol_status_t expected = i % 3 == 0 ? CCOL_STATUS_NOT_FOUND : CCOL_STATUS_OK;
+            TEST_ASSERT_EQUAL(expected, ccol_hash_table_get(hash_table, &probe, &value));
+            TEST_ASSERT_EQUAL(expected, ccol_hash_table_get(clone, &probe, &value));
+            if (expected == CCOL_STATUS_OK) TEST_ASSERT_EQUAL_PTR(&keys[i], value);
+        }
+
+        uint64_t missing = 1;
+        TEST_ASSERT_FALSE(ccol_hash_table_contains_key(hash_table, &missing));
+
+        ccol_hash_table_free(&clone);
+        ccol_hash_table_free(&hash_table);
+    }
+}
+
+void test_ccol_hash_table_robin_hood_churn(void) {
+    ccol_hash_table_t *hash_table = create_int32_table(CCOL_HASH_TABLE_ROBIN_HOOD, 8);
+    TEST_ASSERT_EQUAL(CCOL_HASH_TABLE_ROBIN_HOOD_MAX_LOAD_FACTOR, hash_table->max_load_factor);
+
+    // 900 keys in 1024 slots: just under the 0.9 limit
+    enum { count = 900 };
+    static int32_t keys[count];
+    for (int32_t i = 0; i < count; i++) {
+        keys[i] = i * 7919;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_insert(hash_table, &keys[i], &keys[i]));
+    }
+    TEST_ASSERT_EQUAL(CCOL_STATUS_ALREADY_EXISTS, ccol_hash_table_insert(hash_table, &keys[3], NULL));
+
+    // Churn at that load: runs must stay short without tombstones piling up
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_set_load_factors(hash_table, 0, 0));
+    for (int round = 0; round < 4; round++) {
+        for (int32_t i = round % 2; i < count; i += 2) {
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_remove(hash_table, &keys[i]));
+        }
+        for (int32_t i = round % 2; i < count; i += 2) {
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_insert(hash_table, &keys[i], &keys[i]));
+        }
+    }
+    TEST_ASSERT_EQUAL(1024, ccol_hash_table_num_buckets(hash_table));
+    TEST_ASSERT_TRUE(ccol__robin_hood_max_probe(hash_table) <= 32);
+
+    for (int32_t i = 0; i < count; i++) {
+        void *value = NULL;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_get(hash_table, &keys[i], &value));
+        TEST_ASSERT_EQUAL_PTR(&keys[i], value);
+    }
+
+    int32_t missing = -1;
+    TEST_ASSERT_FALSE(ccol_hash_table_contains_key(hash_table, &missing));
+
+    // Backward-shift deletion leaves no tombstones: emptying the table empties every slot
+    for (int32_t i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_remove(hash_table, &keys[i]));
+    }
+    TEST_ASSERT_EQUAL(0, ccol__robin_hood_max_probe(hash_table));
+
+    ccol_hash_table_free(&hash_table);
+}
+
+void test_ccol_hash_table_auto_resize(void) {
+    ccol_hash_table_t *hash_table = create_int32_table(CCOL_HASH_TABLE_CHAINED, 16);
+
+    static int32_t keys[TEST_KEY_COUNT];
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+        keys[i] = i;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_insert(hash_table, &keys[i], NULL));
+        TEST_ASSERT_TRUE(ccol_hash_table_load_factor(hash_table) <= CCOL_HASH_TABLE_DEFAULT_MAX_LOAD_FACTOR);
+    }
+    TEST_ASSERT_TRUE(ccol_hash_table_num_buckets(hash_table) > 16);
+
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_remove(hash_table, &keys[i]));
+    }
+    TEST_ASSERT_EQUAL(16, ccol_hash_table_num_buckets(hash_table));
+
+    TEST_ASSERT_EQUAL(CCOL_STATUS_INVALID_ARG, ccol_hash_table_set_load_factors(hash_table, 0.5, 0.75));
+
+    ccol_hash_table_free(&hash_table);
+}
+
+// Copies key and value only, like most user copiers; the table restores the cached hash
+static void *copy_entry_without_hash(const void *data, void *ctx) {
+    (void)ctx;
+    const ccol_hash_entry_t *entry = (const ccol_hash_entry_t *)data;
+    ccol_hash_entry_t *copy = calloc(1, sizeof(ccol_hash_entry_t));
+    if (!copy) return NULL;
+    copy->key = entry->key;
+    copy->value = entry->value;
+    return copy;
+}
+
+void test_ccol_hash_table_deep_clone_keeps_hashes(void) {
+    ccol_hash_table_t *hash_table = create_int32_table(CCOL_HASH_TABLE_CHAINED, 16);
+    hash_table->copier = ccol_copy_create(copy_entry_without_hash, NULL);
+
+    static int32_t keys[TEST_KEY_COUNT];
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+        keys[i] = i * 31;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_insert(hash_table, &keys[i], NULL));
+    }
+
+    ccol_hash_table_t *clone = NULL;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_deep_clone(hash_table, &clone));
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+        TEST_ASSERT_TRUE(ccol_hash_table_contains_key(clone, &keys[i]));
+    }
+
+    ccol_hash_table_free(&clone);
+    ccol_hash_table_free(&hash_table);
+}
+
+static void *copy_entry_heap_key(const void *data, void *ctx) {
+    (void)ctx;
+    const ccol_hash_entry_t *entry = (const ccol_hash_entry_t *)data;
+    ccol_hash_entry_t *copy = calloc(1, sizeof(ccol_hash_entry_t));
+    int32_t *key = malloc(sizeof(int32_t));
+    if (!copy || !key) {
+        free(copy);
+        free(key);
+        return NULL;
+    }
+    *key = *(const int32_t *)entry->key;
+    copy->key = key;
+    return copy;
+}
+
+static void free_entry_heap_key(void *data, void *ctx) {
+    (void)ctx;
+    free(((ccol_hash_entry_t *)data)->key);
+}
+
+void test_ccol_hash_table_parallel_bulk(void) {
+    ccol_hash_table_engine_t engines[] = { CCOL_HASH_TABLE_CHAINED, CCOL_HASH_TABLE_SWISS, CCOL_HASH_TABLE_ROBIN_HOOD };
+    const int32_t count = CCOL_HASH_TABLE_PARALLEL_MIN_SIZE + 1000;
+
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        ccol_hash_table_t *hash_table = create_int32_table_with_policy(engines[e], CCOL_HASH_ROBUST, 16);
+        hash_table->copier = ccol_copy_create(copy_entry_heap_key, NULL);
+        hash_table->freer = ccol_free_create(free_entry_heap_key, NULL);
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_set_threads(hash_table, 4));
+
+        for (int32_t i = 0; i < count; i++) {
+            int32_t *key = malloc(sizeof(int32_t));
+            TEST_ASSERT_NOT_NULL(key);
+            *key = i;
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_insert(hash_table, key, NULL));
+        }
+
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_resize(hash_table, count * 4));
+        TEST_ASSERT_EQUAL(count, ccol_hash_table_size(hash_table));
+
+        ccol_hash_table_t *deep = NULL;
+        ccol_hash_table_t *shallow = NULL;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_deep_clone(hash_table, &deep));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_shallow_clone(hash_table, &shallow));
+        TEST_ASSERT_EQUAL(count, ccol_hash_table_size(deep));
+        TEST_ASSERT_EQUAL(count, ccol_hash_table_size(shallow));
+
+        for (int32_t i = 0; i < count; i += 7) {
+            TEST_ASSERT_TRUE(ccol_hash_table_contains_key(hash_table, &i));
+            TEST_ASSERT_TRUE(ccol_hash_table_contains_key(deep, &i));
+            TEST_ASSERT_TRUE(ccol_hash_table_contains_key(shallow, &i));
+        }
+
+        // The shallow clone shares src's keys, so it must not free them
+        shallow->freer = (ccol_free_t){0};
+        ccol_hash_table_free(&shallow);
+
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_clear(deep));
+        TEST_ASSERT_EQUAL(0, ccol_hash_table_size(deep));
+        ccol_hash_table_free(&deep);
+        ccol_hash_table_free(&hash_table);
+    }
+}
+
+void test_ccol_hash_table_incremental_rehash(void) {
+    ccol_hash_table_t *hash_table = create_int32_table(CCOL_HASH_TABLE_CHAINED, 16);
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_set_incremental_rehash(hash_table, 1));
+
+    static int32_t keys[TEST_KEY_COUNT];
+    bool saw_rehash = false;
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+        keys[i] = i;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_insert(hash_table, &keys[i], &keys[i]));
+        saw_rehash = saw_rehash || ccol_hash_table_is_rehashing(hash_table);
+
+        // Every key inserted so far stays reachable mid-migration
+        void *value = NULL;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_get(hash_table, &keys[i / 2], &value));
+        TEST_ASSERT_EQUAL_PTR(&keys[i / 2], value);
+    }
+    TEST_ASSERT_TRUE(saw_rehash);
+
+    // The read-only lookup used under shared locks finds keys in either array without migrating
+    while (!ccol_hash_table_is_rehashing(hash_table)) {
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_resize(hash_table, (int)hash_table->num_buckets * 2));
+    }
+    size_t rehash_index = hash_table->rehash_index;
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+        uint32_t hash = hash_table->hasher.func(&keys[i], hash_table->hasher.ctx);
+        ccol_hash_entry_t *entry = ccol__hash_table_peek_hashed(hash_table, &keys[i], hash);
+        TEST_ASSERT_NOT_NULL(entry);
+        TEST_ASSERT_EQUAL_PTR(&keys[i], entry->value);
+    }
+    TEST_ASSERT_EQUAL(rehash_index, hash_table->rehash_index);
+
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_set_incremental_rehash(hash_table, 0));
+    TEST_ASSERT_FALSE(ccol_hash_table_is_rehashing(hash_table));
+    TEST_ASSERT_EQUAL(TEST_KEY_COUNT, ccol_hash_table_size(hash_table));
+
+    ccol_hash_table_free(&hash_table);
+}
+
+void test_ccol_hash_table_cursor_and_scan(void) {
+    ccol_hash_table_engine_t engines[] = { CCOL_HASH_TABLE_CHAINED, CCOL_HASH_TABLE_SWISS, CCOL_HASH_TABLE_ROBIN_HOOD };
+
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        ccol_hash_table_t *hash_table = create_int32_table(engines[e], 16);
+        // Chained: leave a migration in flight so old and live buckets are both walked
+        if (engines[e] == CCOL_HASH_TABLE_CHAINED) ccol_hash_table_set_incremental_rehash(hash_table, 1);
+
+        static int32_t keys[TEST_KEY_COUNT];
+        for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+            keys[i] = i;
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_insert(hash_table, &keys[i], &keys[i]));
+        }
+
+        static int seen[TEST_KEY_COUNT];
+        memset(seen, 0, sizeof(seen));
+        CCOL_HASH_TABLE_ITEMS_FOR(item, hash_table) {
+            TEST_ASSERT_EQUAL_PTR(item->key, item->value);
+            seen[*(int32_t *)item->key]++;
+        }
+        for (int32_t i = 0; i < TEST_KEY_COUNT; i++) TEST_ASSERT_EQUAL(1, seen[i]);
+
+        size_t visited = 0;
+        CCOL_HASH_TABLE_VALUES_FOR(int32_t, value, hash_table) {
+            if (++visited == 10) break;
+            TEST_ASSERT_TRUE(*value >= 0 && *value < TEST_KEY_COUNT);
+        }
+        TEST_ASSERT_EQUAL(10, visited);
+
+        // Resumable scan in small batches covers every entry exactly once
+        memset(seen, 0, sizeof(seen));
+        ccol_kv_pair_t batch[7];
+        size_t position = 0, count = 0, total = 0;
+        do {
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_scan(hash_table, &position, batch, 7, &count));
+            for (size_t i = 0; i < count; i++) seen[*(int32_t *)batch[i].key]++;
+            total += count;
+        } while (position != 0);
+        TEST_ASSERT_EQUAL(TEST_KEY_COUNT, total);
+        for (int32_t i = 0; i < TEST_KEY_COUNT; i++) TEST_ASSERT_EQUAL(1, seen[i]);
+
+        // A saved position resumes a cursor
+        ccol_hash_table_cursor_t cursor;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_cursor_init(&cursor, hash_table));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_cursor_seek(&cursor, ccol_hash_table_num_buckets(hash_table)));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OUT_OF_BOUNDS, ccol_hash_table_cursor_seek(&cursor, SIZE_MAX));
+
+        ccol_iterator_t *iter = ccol_hash_table_keys(hash_table);
+        TEST_ASSERT_NOT_NULL(iter);
+        size_t keys_seen = 0;
+        while (iter->has_next(iter)) {
+            TEST_ASSERT_TRUE(iter->has_next(iter));
+            int32_t *key = iter->next(iter);
+            TEST_ASSERT_TRUE(*key >= 0 && *key < TEST_KEY_COUNT);
+            keys_seen++;
+        }
+        TEST_ASSERT_NULL(iter->next(iter));
+        iter->destroy(iter);
+        TEST_ASSERT_EQUAL(TEST_KEY_COUNT, keys_seen);
+
+        ccol_hash_table_free(&hash_table);
+    }
+}
+
+void test_ccol_hash_table_clear_and_reuse(void) {
+    ccol_hash_table_t *hash_table = create_int32_table(CCOL_HASH_TABLE_CHAINED, 16);
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_set_incremental_rehash(hash_table, 1));
+
+    static int32_t keys[TEST_KEY_COUNT];
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+        keys[i] = i;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_insert(hash_table, &keys[i], &keys[i]));
+    }
+
+    // Clearing mid-migration drops both bucket arrays' chains
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_clear(hash_table));
+    TEST_ASSERT_FALSE(ccol_hash_table_is_rehashing(hash_table));
+    TEST_ASSERT_EQUAL(0, ccol_hash_table_size(hash_table));
+    TEST_ASSERT_FALSE(ccol_hash_table_contains_key(hash_table, &keys[0]));
+
+    // Refill, then remove every other key so freed nodes are reused
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_insert(hash_table, &keys[i], &keys[i]));
+    }
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i += 2) {
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_remove(hash_table, &keys[i]));
+    }
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i += 2) {
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_insert(hash_table, &keys[i], &keys[i]));
+    }
+
+    TEST_ASSERT_EQUAL(TEST_KEY_COUNT, ccol_hash_table_size(hash_table));
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+        TEST_ASSERT_TRUE(ccol_hash_table_contains_key(hash_table, &keys[i]));
+    }
+
+    ccol_hash_table_free(&hash_table);
+}
+
+// Pinned outputs: the hash is documented as stable across processes and builds. The
+// CCOL_HASH_ROBUST_NO_INT128 build of this suite checks the portable multiply against them.
+void test_ccol_hash_robust_known_answers(void) {
+    static const struct {
+        size_t length;
+        uint32_t unseeded;
+        uint32_t seeded;
+    } answers[] = {
+        {0, 0x73CC4FEFU, 0x6BFF5A23U},
+        {1, 0xAD814AC4U, 0x9CDC9861U},
+        {2, 0x7085FC67U, 0xB96B5C8FU},
+        {3, 0x4BFDA190U, 0x4F223CDBU},
+        {4, 0xAF870C00U, 0x0B08063EU},
+        {7, 0x86EF7D2CU, 0xFE38ED92U},
+        {8, 0x8DBD1556U, 0x47C0A9CFU},
+        {16, 0x26626146U, 0xF48495EAU},
+        {17, 0x166736E0U, 0xA605C649U},
+        {32, 0xD089401BU, 0x9166DC2FU},
+        {48, 0x53900AB1U, 0xADB27C05U},
+        {49, 0xECC2D8CBU, 0xA126F087U},
+        {96, 0xFFD829FFU, 0x180B10A5U},
+        {128, 0x5220C121U, 0xD6110ED8U},
+    };
+
+    char data[129];
+    for (int i = 0; i < 128; i++) data[i] = (char)('!' + (i * 7) % 90);
+    data[128] = '\0';
+
+    uint64_t seed = 0x0123456789ABCDEFULL;
+    for (size_t i = 0; i < sizeof(answers) / sizeof(answers[0]); i++) {
+        size_t length = answers[i].length;
+        TEST_ASSERT_EQUAL_HEX32(answers[i].unseeded, ccol__hash_robust_block(data, length, 0));
+        TEST_ASSERT_EQUAL_HEX32(answers[i].seeded, ccol__hash_robust_block(data, length, seed));
+        TEST_ASSERT_NOT_EQUAL(answers[i].unseeded, answers[i].seeded);
+
+        // The string hash is the block hash over strlen, seeded through ctx
+        char str[129];
+        memcpy(str, data, length);
+        str[length] = '\0';
+        TEST_ASSERT_EQUAL_HEX32(answers[i].unseeded, ccol__hash_robust_str(str, NULL));
+        TEST_ASSERT_EQUAL_HEX32(answers[i].seeded, ccol__hash_robust_str(str, &seed));
+    }
+
+    uint32_t word = 42;
+    TEST_ASSERT_NOT_EQUAL(ccol__hash_robust_uint32(&word, NULL), ccol__hash_robust_uint32(&word, &seed));
+}
+
+void test_ccol_hash_table_secure_per_table_key(void) {
+    ccol_hash_table_t *hash_table = create_int32_table_with_policy(CCOL_HASH_TABLE_SWISS, CCOL_HASH_SECURE, 16);
+    ccol_hash_table_t *other = create_int32_table_with_policy(CCOL_HASH_TABLE_SWISS, CCOL_HASH_SECURE, 16);
+
+    TEST_ASSERT_EQUAL_PTR(&hash_table->hash_key, hash_table->hasher.ctx);
+    TEST_ASSERT_FALSE(hash_table->hash_key.k0 == other->hash_key.k0 && hash_table->hash_key.k1 == other->hash_key.k1);
+
+    static int32_t keys[TEST_KEY_COUNT];
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+        keys[i] = i;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_insert(hash_table, &keys[i], NULL));
+    }
+
+    // The clone keeps the same key but owns its copy
+    ccol_hash_table_t *clone = NULL;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_shallow_clone(hash_table, &clone));
+    TEST_ASSERT_EQUAL_PTR(&clone->hash_key, clone->hasher.ctx);
+    ccol_hash_table_free(&hash_table);
+
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+        TEST_ASSERT_TRUE(ccol_hash_table_contains_key(clone, &keys[i]));
+    }
+
+    ccol_hash_table_free(&clone);
+    ccol_hash_table_free(&other);
+}
+
+void test_ccol_hash_table_get_many(void) {
+    ccol_hash_table_engine_t engines[] = { CCOL_HASH_TABLE_CHAINED, CCOL_HASH_TABLE_SWISS, CCOL_HASH_TABLE_ROBIN_HOOD };
+
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        ccol_hash_table_t *hash_table = create_int32_table(engines[e], 16);
+
+        // Even keys are present, odd keys are misses
+        static int32_t keys[TEST_KEY_COUNT];
+        static void *lookup[TEST_KEY_COUNT];
+        static void *values[TEST_KEY_COUNT];
+        uint64_t found_mask[(TEST_KEY_COUNT + 63) / 64];
+        for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+            keys[i] = i;
+            lookup[i] = &keys[i];
+            if (i % 2 == 0) ccol_hash_table_insert(hash_table, &keys[i], &keys[i]);
+        }
+
+        TEST_ASSERT_EQUAL(
+            CCOL_STATUS_NOT_FOUND,
+            ccol_hash_table_get_many(hash_table, lookup, TEST_KEY_COUNT, values, found_mask)
+        );
+        for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+            bool hit = (found_mask[i / 64] >> (i % 64)) & 1;
+            TEST_ASSERT_EQUAL(i % 2 == 0, hit);
+            TEST_ASSERT_EQUAL_PTR(hit ? &keys[i] : NULL, values[i]);
+        }
+
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_get_many(hash_table, lookup, 1, values, NULL));
+
+        ccol_hash_table_free(&hash_table);
+    }
+}
+
+void test_ccol_hash_table_build_and_insert_bulk(void) {
+    ccol_hash_table_engine_t engines[] = { CCOL_HASH_TABLE_CHAINED, CCOL_HASH_TABLE_SWISS, CCOL_HASH_TABLE_ROBIN_HOOD };
+
+    static int32_t keys[TEST_KEY_COUNT];
+    static void *key_ptrs[TEST_KEY_COUNT];
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+        keys[i] = i;
+        key_ptrs[i] = &keys[i];
+    }
+
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        ccol_hash_t hasher;
+        ccol_hash_create_from_policy(sizeof(int32_t), CCOL_HASH_ROBUST, NULL, &hasher);
+
+        ccol_hash_table_t *hash_table = NULL;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_build(
+            &hash_table,
+            sizeof(int32_t),
+            engines[e],
+            CCOL_HASH_ROBUST,
+            hasher,
+            (ccol_copy_t){0},
+            (ccol_free_t){0},
+            (ccol_print_t){0},
+            ccol_comparator_create(ccol_cmp_hash_entry_key, &key_cmp),
+            key_ptrs,
+            key_ptrs,
+            TEST_KEY_COUNT / 2,
+            true
+        ));
+        TEST_ASSERT_EQUAL(TEST_KEY_COUNT / 2, ccol_hash_table_size(hash_table));
+        TEST_ASSERT_TRUE(ccol_hash_table_load_factor(hash_table) <= hash_table->max_load_factor);
+
+        // The second half overlaps the first by one key, which is skipped
+        TEST_ASSERT_EQUAL(
+            CCOL_STATUS_ALREADY_EXISTS,
+            ccol_hash_table_insert_bulk(hash_table, key_ptrs + TEST_KEY_COUNT / 2 - 1, NULL, TEST_KEY_COUNT / 2 + 1, false)
+        );
+        TEST_ASSERT_EQUAL(TEST_KEY_COUNT, ccol_hash_table_size(hash_table));
+
+        for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+            void *value = NULL;
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_get(hash_table, &keys[i], &value));
+            TEST_ASSERT_EQUAL_PTR(i < TEST_KEY_COUNT / 2 ? &keys[i] : NULL, value);
+        }
+
+        ccol_hash_table_free(&hash_table);
+    }
+}
+
+// Sends every key to one bucket
+static uint32_t hash_constant(const void *key, void *ctx) {
+    (void)key;
+    (void)ctx;
+    return 42;
+}
+
+void test_ccol_hash_table_stats(void) {
+    ccol_hash_table_engine_t engines[] = { CCOL_HASH_TABLE_CHAINED, CCOL_HASH_TABLE_SWISS, CCOL_HASH_TABLE_ROBIN_HOOD };
+
+    static int32_t keys[TEST_KEY_COUNT];
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) keys[i] = i;
+
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        ccol_hash_table_t *hash_table = create_int32_table_with_policy(engines[e], CCOL_HASH_ROBUST, 16);
+        for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_insert(hash_table, &keys[i], &keys[i]));
+        }
+
+        ccol_hash_table_stats_t stats;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_stats(hash_table, &stats));
+        TEST_ASSERT_EQUAL(TEST_KEY_COUNT, stats.size);
+        TEST_ASSERT_EQUAL(ccol_hash_table_num_buckets(hash_table), stats.num_buckets);
+        TEST_ASSERT_TRUE(stats.mean_chain >= 1.0);
+        TEST_ASSERT_TRUE(stats.p99_chain >= 1 && stats.p99_chain <= stats.max_chain);
+        TEST_ASSERT_TRUE(stats.chi_square < 2.0);
+        TEST_ASSERT_TRUE(stats.memory_bytes > stats.num_buckets);
+
+        size_t positions = 0;
+        for (size_t i = 0; i < CCOL_HASH_TABLE_STATS_HISTOGRAM_SIZE; i++) positions += stats.chain_histogram[i];
+        TEST_ASSERT_EQUAL(stats.num_buckets, positions);
+        TEST_ASSERT_EQUAL(stats.empty_buckets, stats.chain_histogram[0]);
+
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_reset_counters(hash_table));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_stats(hash_table, &stats));
+        TEST_ASSERT_EQUAL_UINT64(0, stats.counters.lookups);
+
+        ccol_hash_table_free(&hash_table);
+    }
+
+    // A degenerate hasher shows up as one long chain and a huge chi-square
+    ccol_hash_table_t *hash_table = NULL;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_create(
+        &hash_table,
+        64,
+        sizeof(int32_t),
+        CCOL_HASH_CUSTOM,
+        ccol_hash_create(hash_constant, NULL, CCOL_HASH_CUSTOM),
+        (ccol_copy_t){0},
+        (ccol_free_t){0},
+        (ccol_print_t){0},
+        ccol_comparator_create(ccol_cmp_hash_entry_key, &key_cmp)
+    ));
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_set_load_factors(hash_table, 0, 0));
+    for (int32_t i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_insert(hash_table, &keys[i], &keys[i]));
+    }
+
+    ccol_hash_table_stats_t stats;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_stats(hash_table, &stats));
+    TEST_ASSERT_EQUAL(100, stats.max_chain);
+    TEST_ASSERT_EQUAL(100, stats.p99_chain);
+    TEST_ASSERT_EQUAL(63, stats.empty_buckets);
+    TEST_ASSERT_EQUAL(1, stats.chain_histogram[CCOL_HASH_TABLE_STATS_HISTOGRAM_SIZE - 1]);
+    TEST_ASSERT_TRUE(stats.chi_square > 50.0);
+
+#if defined(CCOL_HASH_TABLE_STATS)
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_reset_counters(hash_table));
+    TEST_ASSERT_TRUE(ccol_hash_table_contains_key(hash_table, &keys[99]));
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_stats(hash_table, &stats));
+    TEST_ASSERT_EQUAL_UINT64(1, stats.counters.lookups);
+    TEST_ASSERT_EQUAL_UINT64(100, stats.counters.comparisons);
+#endif
+
+    ccol_hash_table_free(&hash_table);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Run tests
+    RUN_TEST(test_ccol_hash_table_create_chained);
+    RUN_TEST(test_ccol_hash_table_init_with_engine);
+    RUN_TEST(test_ccol_hash_table_create_swiss);
+    RUN_TEST(test_ccol_hash_table_swiss_insert_get_remove);
+    RUN_TEST(test_ccol_hash_table_swiss_sequential_keys);
+    RUN_TEST(test_ccol_hash_table_swiss_inline_keys);
+    RUN_TEST(test_ccol_hash_table_robin_hood_churn);
+    RUN_TEST(test_ccol_hash_table_auto_resize);
+    RUN_TEST(test_ccol_hash_table_incremental_rehash);
+    RUN_TEST(test_ccol_hash_table_deep_clone_keeps_hashes);
+    RUN_TEST(test_ccol_hash_table_parallel_bulk);
+    RUN_TEST(test_ccol_hash_table_cursor_and_scan);
+    RUN_TEST(test_ccol_hash_table_clear_and_reuse);
+    RUN_TEST(test_ccol_hash_robust_known_answers);
+    RUN_TEST(test_ccol_hash_table_secure_per_table_key);
+    RUN_TEST(test_ccol_hash_table_get_many);
+    RUN_TEST(test_ccol_hash_table_build_and_insert_bulk);
+    RUN_TEST(test_ccol_hash_table_stats);
+
+    return UNITY_END();
+}
@@ -0,0 +1,118 @@
+/*
+ * tests/test_intern.c
+ *
+ * String interning unit tests.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "unity.h"
+#include "ccol/ccol_hash.h"
+#include "ccol/ccol_intern.h"
+
+#define TEST_STRING_COUNT 5000
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_ccol_intern_dedupes_with_dense_ids(void) {
+    ccol_hash_policy_t policies[] = { CCOL_HASH_ROBUST, CCOL_HASH_SECURE };
+
+    for (size_t p = 0; p < sizeof(policies) / sizeof(policies[0]); p++) {
+        ccol_intern_t *intern = NULL;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_intern_create(&intern, policies[p]));
+
+        // Shared prefixes longer than the inline prefix force the arena compare
+        char buffer[64];
+        const char *first = NULL;
+        for (int i = 0; i < TEST_STRING_COUNT; i++) {
+            snprintf(buffer, sizeof(buffer), "namespace.module.key_%d", i);
+
+            ccol_intern_id_t id = UINT32_MAX;
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_intern(intern, buffer, &id));
+            TEST_ASSERT_EQUAL_UINT32((uint32_t)i, id);
+            if (i == 0) first = ccol_intern_str(intern, id);
+        }
+        TEST_ASSERT_EQUAL(TEST_STRING_COUNT, ccol_intern_size(intern));
+
+        // Same bytes, same id; earlier pointers survive growth
+        for (int i = 0; i < TEST_STRING_COUNT; i++) {
+            snprintf(buffer, sizeof(buffer), "namespace.module.key_%d", i);
+
+            ccol_intern_id_t id = UINT32_MAX;
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_intern(intern, buffer, &id));
+            TEST_ASSERT_EQUAL_UINT32((uint32_t)i, id);
+            TEST_ASSERT_EQUAL_STRING(buffer, ccol_intern_str(intern, id));
+            TEST_ASSERT_EQUAL(strlen(buffer), ccol_intern_length(intern, id));
+        }
+        TEST_ASSERT_EQUAL(TEST_STRING_COUNT, ccol_intern_size(intern));
+        TEST_ASSERT_EQUAL_PTR(first, ccol_intern_str(intern, 0));
+
+        TEST_ASSERT_EQUAL(CCOL_STATUS_NOT_FOUND, ccol_intern_find(intern, "namespace.module.key_", NULL));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_NOT_FOUND, ccol_intern_find(intern, "namespace", NULL));
+        TEST_ASSERT_NULL(ccol_intern_str(intern, TEST_STRING_COUNT));
+
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_intern_free(&intern));
+        TEST_ASSERT_NULL(intern);
+    }
+}
+
+void test_ccol_intern_lengths_and_long_strings(void) {
+    ccol_intern_t intern;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_intern_init(&intern, CCOL_HASH_ROBUST));
+
+    // Embedded NULs make "ab\0c" and "ab" distinct
+    ccol_intern_id_t with_nul, short_id, empty_id, found;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_intern_n(&intern, "ab\0c", 4, &with_nul));
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_intern(&intern, "ab", &short_id));
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_intern(&intern, "", &empty_id));
+    TEST_ASSERT_NOT_EQUAL(with_nul, short_id);
+    TEST_ASSERT_EQUAL(4, ccol_intern_length(&intern, with_nul));
+    TEST_ASSERT_EQUAL(0, memcmp("ab\0c", ccol_intern_str(&intern, with_nul), 5));
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_intern_find_n(&intern, "ab\0c", 4, &found));
+    TEST_ASSERT_EQUAL_UINT32(with_nul, found);
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_intern_find(&intern, "", &found));
+    TEST_ASSERT_EQUAL_UINT32(empty_id, found);
+
+    // Longer than a chunk
+    size_t long_length = CCOL_INTERN_CHUNK_SIZE * 2;
+    char *long_str = malloc(long_length + 1);
+    TEST_ASSERT_NOT_NULL(long_str);
+    memset(long_str, 'x', long_length);
+    long_str[long_length] = '\0';
+
+    ccol_intern_id_t long_id;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_intern(&intern, long_str, &long_id));
+    TEST_ASSERT_EQUAL(long_length, ccol_intern_length(&intern, long_id));
+    TEST_ASSERT_EQUAL_STRING(long_str, ccol_intern_str(&intern, long_id));
+
+    long_str[long_length - 1] = 'y';
+    TEST_ASSERT_EQUAL(CCOL_STATUS_NOT_FOUND, ccol_intern_find(&intern, long_str, NULL));
+    free(long_str);
+
+    TEST_ASSERT_EQUAL(5 + 3 + 1 + long_length + 1, ccol_intern_arena_bytes(&intern));
+
+    // SIMPLE has no seed and is rejected
+    ccol_intern_t rejected;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_HASH_POLICY, ccol_intern_init(&rejected, CCOL_HASH_SIMPLE));
+
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_intern_destroy(&intern));
+    TEST_ASSERT_EQUAL(CCOL_STATUS_UNINITIALIZED, ccol_intern(&intern, "a", NULL));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Run tests
+    RUN_TEST(test_ccol_intern_dedupes_with_dense_ids);
+    RUN_TEST(test_ccol_intern_lengths_and_long_strings);
+
+    return UNITY_END();
+}
@@ -0,0 +1,168 @@
+/*
+ * tests/test_lru.c
+ *
+ * LRU cache unit tests.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "unity.h"
+#include "ccol/ccol_comparator.h"
+#include "ccol/ccol_hash.h"
+#include "ccol/ccol_hash_table.h"
+#include "ccol/ccol_lru.h"
+
+#define TEST_CAPACITY 64
+#define TEST_KEY_COUNT 1000
+
+static int evicted;
+
+void setUp(void) {
+    evicted = 0;
+}
+
+void tearDown(void) {}
+
+static void evict_pair(void *entry_ptr, void *ctx) {
+    (void)ctx;
+    ccol_hash_entry_t *entry = entry_ptr;
+    free(entry->key);
+    free(entry->value);
+    evicted++;
+}
+
+static int32_t *new_int32(int32_t value) {
+    int32_t *ptr = malloc(sizeof(int32_t));
+    TEST_ASSERT_NOT_NULL(ptr);
+    *ptr = value;
+    return ptr;
+}
+
+static ccol_lru_t *create_int32_lru(ccol_hash_table_engine_t engine, size_t max_size, size_t max_cost) {
+    ccol_hash_t hasher;
+    TEST_ASSERT_EQUAL(
+        CCOL_STATUS_OK,
+        ccol_hash_create_from_policy(sizeof(int32_t), CCOL_HASH_ROBUST, NULL, &hasher)
+    );
+
+    ccol_lru_t *lru = NULL;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_lru_create(
+        &lru,
+        max_size,
+        max_cost,
+        sizeof(int32_t),
+        engine,
+        CCOL_HASH_ROBUST,
+        hasher,
+        ccol_comparator_create(ccol_cmp_int32, NULL),
+        ccol_free_create(evict_pair, NULL)
+    ));
+    return lru;
+}
+
+void test_ccol_lru_evicts_least_recently_used(void) {
+    ccol_hash_table_engine_t engines[] = { CCOL_HASH_TABLE_CHAINED, CCOL_HASH_TABLE_SWISS, CCOL_HASH_TABLE_ROBIN_HOOD };
+
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        evicted = 0;
+        ccol_lru_t *lru = create_int32_lru(engines[e], TEST_CAPACITY, 0);
+
+        for (int32_t i = 0; i < TEST_CAPACITY; i++) {
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_lru_put(lru, new_int32(i), new_int32(i * 10), 1));
+        }
+
+        // Touch key 0 so key 1 becomes the oldest
+        void *value = NULL;
+        int32_t key = 0;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_lru_get(lru, &key, &value));
+        TEST_ASSERT_EQUAL_INT32(0, *(int32_t *)value);
+
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_lru_put(lru, new_int32(TEST_CAPACITY), new_int32(-1), 1));
+        TEST_ASSERT_EQUAL(1, evicted);
+        TEST_ASSERT_TRUE(ccol_lru_contains(lru, &key));
+        key = 1;
+        TEST_ASSERT_FALSE(ccol_lru_contains(lru, &key));
+        TEST_ASSERT_EQUAL(TEST_CAPACITY, ccol_lru_size(lru));
+
+        // Refreshing a key hands the old pair to the evictor without shrinking the cache
+        key = 2;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_lru_put(lru, new_int32(2), new_int32(99), 1));
+        TEST_ASSERT_EQUAL(2, evicted);
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_lru_peek(lru, &key, &value));
+        TEST_ASSERT_EQUAL_INT32(99, *(int32_t *)value);
+        TEST_ASSERT_EQUAL(TEST_CAPACITY, ccol_lru_size(lru));
+
+        // A long stream keeps the newest TEST_CAPACITY keys
+        for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_lru_put(lru, new_int32(TEST_KEY_COUNT + i), new_int32(i), 1));
+        }
+        TEST_ASSERT_EQUAL(TEST_CAPACITY, ccol_lru_size(lru));
+        for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+            key = TEST_KEY_COUNT + i;
+            TEST_ASSERT_EQUAL(i >= TEST_KEY_COUNT - TEST_CAPACITY, ccol_lru_contains(lru, &key));
+        }
+
+        key = TEST_KEY_COUNT * 2 - 1;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_lru_remove(lru, &key));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_NOT_FOUND, ccol_lru_remove(lru, &key));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_lru_evict_oldest(lru));
+        TEST_ASSERT_EQUAL(TEST_CAPACITY - 2, ccol_lru_size(lru));
+
+        int before = evicted;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_lru_free(&lru));
+        TEST_ASSERT_EQUAL(before + TEST_CAPACITY - 2, evicted);
+        TEST_ASSERT_NULL(lru);
+    }
+}
+
+void test_ccol_lru_cost_limit(void) {
+    ccol_lru_t *lru = create_int32_lru(CCOL_HASH_TABLE_SWISS, 0, 100);
+
+    for (int32_t i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_lru_put(lru, new_int32(i), new_int32(i), 10));
+    }
+    TEST_ASSERT_EQUAL(100, ccol_lru_cost(lru));
+    TEST_ASSERT_EQUAL(0, evicted);
+
+    // One heavy entry pushes out the three oldest
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_lru_put(lru, new_int32(10), new_int32(10), 25));
+    TEST_ASSERT_EQUAL(3, evicted);
+    TEST_ASSERT_EQUAL(95, ccol_lru_cost(lru));
+    TEST_ASSERT_EQUAL(8, ccol_lru_size(lru));
+
+    // Larger than the whole budget: rejected, nothing evicted
+    int32_t *key = new_int32(11);
+    int32_t *value = new_int32(11);
+    TEST_ASSERT_EQUAL(CCOL_STATUS_FULL, ccol_lru_put(lru, key, value, 101));
+    TEST_ASSERT_EQUAL(3, evicted);
+    free(key);
+    free(value);
+
+    // Shrinking the limits evicts down to them
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_lru_set_capacity(lru, 2, 100));
+    TEST_ASSERT_EQUAL(2, ccol_lru_size(lru));
+    TEST_ASSERT_EQUAL(35, ccol_lru_cost(lru));
+
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_lru_clear(lru));
+    TEST_ASSERT_EQUAL(0, ccol_lru_size(lru));
+    TEST_ASSERT_EQUAL(0, ccol_lru_cost(lru));
+    TEST_ASSERT_EQUAL(CCOL_STATUS_EMPTY, ccol_lru_evict_oldest(lru));
+
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_lru_put(lru, new_int32(1), new_int32(1), 1));
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_lru_free(&lru));
+    TEST_ASSERT_EQUAL(12, evicted);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_ccol_lru_evicts_least_recently_used);
+    RUN_TEST(test_ccol_lru_cost_limit);
+
+    return UNITY_END();
+}
@@ -0,0 +1,137 @@
+/*
+ * tests/test_mph.c
+ *
+ * Minimal perfect hash unit tests.
+ *
+ * Created by Jack Einbinder
+ * Copyright (C) 2025 Jack Einbinder
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "unity.h"
+#include "ccol/ccol_hash.h"
+#include "ccol/ccol_hash_table.h"
+#include "ccol/ccol_mph.h"
+#include "ccol/ccol_comparator.h"
+
+#define TEST_KEY_COUNT 10000
+
+static ccol_comparator_t key_cmp;
+
+void setUp(void) {
+    key_cmp = ccol_comparator_create(ccol_cmp_int32, NULL);
+}
+
+void tearDown(void) {}
+
+void test_ccol_mph_is_minimal_and_perfect(void) {
+    ccol_hash_policy_t policies[] = { CCOL_HASH_ROBUST, CCOL_HASH_SECURE };
+
+    static int32_t keys[TEST_KEY_COUNT];
+    static void *key_ptrs[TEST_KEY_COUNT];
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+        keys[i] = i * 7 + 3;
+        key_ptrs[i] = &keys[i];
+    }
+
+    for (size_t p = 0; p < sizeof(policies) / sizeof(policies[0]); p++) {
+        ccol_mph_t *mph = NULL;
+        TEST_ASSERT_EQUAL(
+            CCOL_STATUS_OK,
+            ccol_mph_create(&mph, sizeof(int32_t), policies[p], key_cmp, key_ptrs, TEST_KEY_COUNT)
+        );
+        TEST_ASSERT_EQUAL(TEST_KEY_COUNT, ccol_mph_size(mph));
+        TEST_ASSERT_TRUE(ccol_mph_bits_per_key(mph) < 3.5);
+
+        // Every key gets its own index in [0, n)
+        static bool seen[TEST_KEY_COUNT];
+        memset(seen, 0, sizeof(seen));
+        for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+            size_t index = TEST_KEY_COUNT;
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_mph_index(mph, &keys[i], &index));
+            TEST_ASSERT_TRUE(index < TEST_KEY_COUNT);
+            TEST_ASSERT_FALSE(seen[index]);
+            seen[index] = true;
+
+            TEST_ASSERT_EQUAL(index, ccol_mph_index_unchecked(mph, &keys[i]));
+            TEST_ASSERT_EQUAL_PTR(&keys[i], ccol_mph_key_at(mph, index));
+        }
+
+        int32_t miss = 4;
+        TEST_ASSERT_FALSE(ccol_mph_contains(mph, &miss));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_NOT_FOUND, ccol_mph_index(mph, &miss, NULL));
+
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_mph_free(&mph));
+        TEST_ASSERT_NULL(mph);
+    }
+}
+
+void test_ccol_mph_from_hash_table(void) {
+    ccol_hash_t hasher;
+    ccol_hash_create_from_policy(sizeof(int32_t), CCOL_HASH_ROBUST, NULL, &hasher);
+
+    ccol_hash_table_t *hash_table = NULL;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_hash_table_create(
+        &hash_table,
+        16,
+        sizeof(int32_t),
+        CCOL_HASH_ROBUST,
+        hasher,
+        (ccol_copy_t){0},
+        (ccol_free_t){0},
+        (ccol_print_t){0},
+        ccol_comparator_create(ccol_cmp_hash_entry_key, &key_cmp)
+    ));
+
+    static int32_t keys[TEST_KEY_COUNT];
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) {
+        keys[i] = -i;
+        ccol_hash_table_insert(hash_table, &keys[i], NULL);
+    }
+
+    ccol_mph_t *mph = NULL;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_mph_create_from_hash_table(&mph, hash_table, CCOL_HASH_ROBUST, key_cmp));
+    TEST_ASSERT_EQUAL(TEST_KEY_COUNT, ccol_mph_size(mph));
+    for (int32_t i = 0; i < TEST_KEY_COUNT; i++) TEST_ASSERT_TRUE(ccol_mph_contains(mph, &keys[i]));
+
+    ccol_mph_free(&mph);
+    ccol_hash_table_free(&hash_table);
+}
+
+void test_ccol_mph_rejects_bad_input(void) {
+    int32_t keys[] = { 1, 2, 1 };
+    void *key_ptrs[] = { &keys[0], &keys[1], &keys[2] };
+    ccol_mph_t mph;
+
+    TEST_ASSERT_EQUAL(
+        CCOL_STATUS_ALREADY_EXISTS,
+        ccol_mph_init(&mph, sizeof(int32_t), CCOL_HASH_ROBUST, key_cmp, key_ptrs, 3)
+    );
+    TEST_ASSERT_FALSE(mph.is_initialized);
+
+    // SIMPLE is unseeded, so a failed build could never retry
+    TEST_ASSERT_EQUAL(
+        CCOL_STATUS_HASH_POLICY,
+        ccol_mph_init(&mph, sizeof(int32_t), CCOL_HASH_SIMPLE, key_cmp, key_ptrs, 2)
+    );
+
+    // The empty set is valid and contains nothing
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_mph_init(&mph, sizeof(int32_t), CCOL_HASH_ROBUST, key_cmp, NULL, 0));
+    TEST_ASSERT_FALSE(ccol_mph_contains(&mph, &keys[0]));
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_mph_destroy(&mph));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Run tests
+    RUN_TEST(test_ccol_mph_is_minimal_and_perfect);
+    RUN_TEST(test_ccol_mph_from_hash_table);
+    RUN_TEST(test_ccol_mph_rejects_bad_input);
+
+    return UNITY_END();
+}
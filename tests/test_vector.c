@@ -1,8 +1,413 @@
 /*
  * ccol/test_vector.c
  *
- *
+ * Dynamic array (vector) unit tests.
  *
  * Created by Jack Einbinder
  * Copyright (C) 2025 Jack Einbinder
  */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "unity.h"
+#include "ccol/ccol_comparator.h"
+#include "ccol/ccol_vector.h"
+
+#define TEST_ELEMENT_COUNT 1000
+#define TEST_PAGE_ELEMENT_SIZE 4096
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+static ccol_vector_t *create_int32_vector(size_t capacity) {
+    ccol_vector_t *vec = NULL;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_create(
+        &vec,
+        capacity,
+        sizeof(int32_t),
+        (ccol_copy_t){0},
+        (ccol_free_t){0},
+        (ccol_print_t){0},
+        ccol_comparator_create(ccol_cmp_int32, NULL)
+    ));
+    return vec;
+}
+
+void test_ccol_vector_growth(void) {
+    double factors[] = { 1.5, CCOL_VECTOR_DEFAULT_GROWTH_FACTOR };
+
+    for (size_t f = 0; f < sizeof(factors) / sizeof(factors[0]); f++) {
+        ccol_vector_t *vec = create_int32_vector(0);
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_set_growth_factor(vec, factors[f]));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_INVALID_ARG, ccol_vector_set_growth_factor(vec, 1.0));
+
+        size_t reallocations = 0;
+        size_t capacity = ccol_vector_capacity(vec);
+        for (int32_t i = 0; i < TEST_ELEMENT_COUNT; i++) {
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_append(vec, &i));
+            if (ccol_vector_capacity(vec) != capacity) {
+                size_t grown = ccol_vector_capacity(vec);
+                if (capacity >= CCOL_VECTOR_MIN_CAPACITY) {
+                    TEST_ASSERT_TRUE((double)grown >= (double)capacity * factors[f] - 1.0);
+                }
+                capacity = grown;
+                reallocations++;
+            }
+        }
+        TEST_ASSERT_TRUE(reallocations < 20);
+
+        int32_t middle = -1;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_insert_middle(vec, &middle));
+        TEST_ASSERT_TRUE(ccol_vector_contains(vec, &middle));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_remove_value(vec, &middle));
+
+        for (int32_t i = 0; i < TEST_ELEMENT_COUNT; i++) {
+            void *element = NULL;
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_get(vec, (size_t)i, &element));
+            TEST_ASSERT_EQUAL_INT32(i, *(int32_t *)element);
+        }
+
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_shrink_to_fit(vec));
+        TEST_ASSERT_EQUAL(TEST_ELEMENT_COUNT, ccol_vector_capacity(vec));
+
+        // Clearing releases the buffer but keeps the vector usable
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_clear(vec));
+        TEST_ASSERT_EQUAL(0, ccol_vector_capacity(vec));
+        int32_t value = 7;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_append(vec, &value));
+        TEST_ASSERT_EQUAL(1, ccol_vector_size(vec));
+
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OVERFLOW, ccol_vector_ensure_capacity(vec, SIZE_MAX));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_free(&vec));
+    }
+}
+
+void test_ccol_vector_large_buffers(void) {
+    ccol_vector_t *vec = NULL;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_create(
+        &vec,
+        4,
+        TEST_PAGE_ELEMENT_SIZE,
+        (ccol_copy_t){0},
+        (ccol_free_t){0},
+        (ccol_print_t){0},
+        (ccol_comparator_t){0}
+    ));
+
+    static unsigned char page[TEST_PAGE_ELEMENT_SIZE];
+    for (int i = 0; i < 3; i++) {
+        memset(page, 'a' + i, sizeof(page));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_append(vec, page));
+    }
+
+    // Crossing the threshold and growing past it must keep the contents either way
+    size_t threshold_elements = CCOL_VECTOR_MAP_THRESHOLD / TEST_PAGE_ELEMENT_SIZE;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_reserve_exact(vec, threshold_elements));
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_ensure_capacity(vec, threshold_elements + 1));
+    TEST_ASSERT_TRUE(ccol_vector_capacity(vec) >= threshold_elements * 2);
+#if defined(__linux__)
+    TEST_ASSERT_TRUE(vec->is_mapped);
+#endif
+
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_shrink_to_fit(vec));
+    TEST_ASSERT_EQUAL(3, ccol_vector_capacity(vec));
+
+    for (int i = 0; i < 3; i++) {
+        void *element = NULL;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_get(vec, (size_t)i, &element));
+        memset(page, 'a' + i, sizeof(page));
+        TEST_ASSERT_EQUAL_MEMORY(page, element, TEST_PAGE_ELEMENT_SIZE);
+    }
+
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_free(&vec));
+}
+
+// Same ordering as ccol_cmp_int64, but not a built-in, so searches take the per-element path
+static int cmp_int64_opaque(const void *a, const void *b, void *ctx) {
+    return ccol_cmp_int64(a, b, ctx);
+}
+
+void test_ccol_vector_search(void) {
+    size_t sizes[] = { 0, 1, 7, 31, 32, 33, 100, TEST_ELEMENT_COUNT };
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        ccol_vector_t *narrow = create_int32_vector(0);
+        ccol_vector_t *wide = NULL;
+        ccol_vector_t *opaque = NULL;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_create(&wide, 0, sizeof(int64_t), (ccol_copy_t){0},
+            (ccol_free_t){0}, (ccol_print_t){0}, ccol_comparator_create(ccol_cmp_int64, NULL)));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_create(&opaque, 0, sizeof(int64_t), (ccol_copy_t){0},
+            (ccol_free_t){0}, (ccol_print_t){0}, ccol_comparator_create(cmp_int64_opaque, NULL)));
+
+        // Every value appears twice so the first match must win
+        for (size_t i = 0; i < sizes[s]; i++) {
+            int32_t narrow_value = -(int32_t)(i % (sizes[s] / 2 + 1));
+            int64_t wide_value = (int64_t)narrow_value * ((int64_t)1 << 33);
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_append(narrow, &narrow_value));
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_append(wide, &wide_value));
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_append(opaque, &wide_value));
+        }
+
+        for (int32_t probe = 1; probe > -(int32_t)sizes[s] - 2; probe--) {
+            int64_t wide_probe = (int64_t)probe * ((int64_t)1 << 33);
+            size_t expected = 0, narrow_index = 0, wide_index = 0;
+            ccol_status_t expected_status = ccol_vector_get_index(opaque, &wide_probe, &expected);
+
+            TEST_ASSERT_EQUAL(expected_status, ccol_vector_get_index(narrow, &probe, &narrow_index));
+            TEST_ASSERT_EQUAL(expected_status, ccol_vector_get_index(wide, &wide_probe, &wide_index));
+            TEST_ASSERT_EQUAL(expected_status == CCOL_STATUS_OK, ccol_vector_contains(narrow, &probe));
+            TEST_ASSERT_EQUAL(expected_status == CCOL_STATUS_OK, ccol_vector_contains(wide, &wide_probe));
+            if (expected_status != CCOL_STATUS_OK) continue;
+
+            TEST_ASSERT_EQUAL(expected, narrow_index);
+            TEST_ASSERT_EQUAL(expected, wide_index);
+        }
+
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_free(&narrow));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_free(&wide));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_free(&opaque));
+    }
+}
+
+typedef struct {
+    int32_t key;
+    uint32_t order;
+} record_t;
+
+static int cmp_record_key(const void *a, const void *b, void *ctx) {
+    (void)ctx;
+    return ccol_cmp_int32(&((const record_t *)a)->key, &((const record_t *)b)->key, NULL);
+}
+
+void test_ccol_vector_sort(void) {
+    size_t sizes[] = { 0, 1, 2, 16, 17, 100, TEST_ELEMENT_COUNT * 10 };
+    uint64_t seed = 42;
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        ccol_vector_t *narrow = create_int32_vector(0);
+        ccol_vector_t *wide = NULL;
+        ccol_vector_t *opaque = NULL;
+        ccol_vector_t *records = NULL;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_create(&wide, 0, sizeof(uint64_t), (ccol_copy_t){0},
+            (ccol_free_t){0}, (ccol_print_t){0}, ccol_comparator_create(ccol_cmp_uint64, NULL)));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_create(&opaque, 0, sizeof(int64_t), (ccol_copy_t){0},
+            (ccol_free_t){0}, (ccol_print_t){0}, ccol_comparator_create(cmp_int64_opaque, NULL)));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_create(&records, 0, sizeof(record_t), (ccol_copy_t){0},
+            (ccol_free_t){0}, (ccol_print_t){0}, ccol_comparator_create(cmp_record_key, NULL)));
+
+        // Few distinct record keys so the stable sort has ties to keep in order
+        for (size_t i = 0; i < sizes[s]; i++) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            int32_t narrow_value = (int32_t)(seed >> 32);
+            uint64_t wide_value = seed ^ (seed >> 17);
+            int64_t opaque_value = (int64_t)(seed >> 40) - ((int64_t)1 << 23);
+            record_t record = { (int32_t)(seed >> 60) - 8, (uint32_t)i };
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_append(narrow, &narrow_value));
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_append(wide, &wide_value));
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_append(opaque, &opaque_value));
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_append(records, &record));
+        }
+
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_sort(narrow));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_stable_sort(wide));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_sort(opaque));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_stable_sort(records));
+
+        const int32_t *n = narrow->data;
+        const uint64_t *w = wide->data;
+        const int64_t *o = opaque->data;
+        const record_t *r = records->data;
+        for (size_t i = 1; i < sizes[s]; i++) {
+            TEST_ASSERT_TRUE(n[i - 1] <= n[i]);
+            TEST_ASSERT_TRUE(w[i - 1] <= w[i]);
+            TEST_ASSERT_TRUE(o[i - 1] <= o[i]);
+            TEST_ASSERT_TRUE(r[i - 1].key < r[i].key || (r[i - 1].key == r[i].key && r[i - 1].order < r[i].order));
+        }
+
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_free(&narrow));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_free(&wide));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_free(&opaque));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_free(&records));
+    }
+
+    ccol_vector_t *vec = NULL;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_create(&vec, 0, sizeof(int32_t), (ccol_copy_t){0},
+        (ccol_free_t){0}, (ccol_print_t){0}, (ccol_comparator_t){0}));
+    TEST_ASSERT_EQUAL(CCOL_STATUS_COMPARATOR_FUNC, ccol_vector_sort(vec));
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_free(&vec));
+}
+
+static void increment_int64(void *element, void *ctx) {
+    (void)ctx;
+    (*(int64_t *)element)++;
+}
+
+static void widen_and_negate(const void *element, void *out, void *ctx) {
+    (void)ctx;
+    *(int64_t *)out = -(int64_t)*(const int32_t *)element;
+}
+
+static void sum_int64(void *acc, const void *element, void *ctx) {
+    (void)ctx;
+    *(int64_t *)acc += *(const int64_t *)element;
+}
+
+static bool is_multiple(const void *element, void *ctx) {
+    return *(const int64_t *)element % *(const int64_t *)ctx == 0;
+}
+
+void test_ccol_vector_parallel(void) {
+    size_t sizes[] = { 0, 1, 100, TEST_ELEMENT_COUNT * 50 + 3 };
+    uint64_t seed = 7;
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        ccol_vector_t *narrow = create_int32_vector(0);
+        ccol_vector_t *opaque = NULL;
+        ccol_vector_t *serial = NULL;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_create(&opaque, 0, sizeof(int64_t), (ccol_copy_t){0},
+            (ccol_free_t){0}, (ccol_print_t){0}, ccol_comparator_create(cmp_int64_opaque, NULL)));
+
+        for (size_t i = 0; i < sizes[s]; i++) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            int32_t narrow_value = (int32_t)(seed >> 32);
+            int64_t opaque_value = (int64_t)(seed >> 48);
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_append(narrow, &narrow_value));
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_append(opaque, &opaque_value));
+        }
+
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_create(&serial, sizes[s], sizeof(int64_t), (ccol_copy_t){0},
+            (ccol_free_t){0}, (ccol_print_t){0}, ccol_comparator_create(ccol_cmp_int64, NULL)));
+        for (size_t i = 0; i < sizes[s]; i++) {
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_append(serial, (int64_t *)opaque->data + i));
+        }
+
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_set_threads(narrow, 4));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_set_threads(opaque, 4));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_set_grain_size(narrow, 1000));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_set_grain_size(opaque, 999));
+
+        int64_t expected_sum = 0;
+        size_t expected_count = 0;
+        int64_t divisor = 3;
+        for (size_t i = 0; i < sizes[s]; i++) {
+            int64_t value = ((int64_t *)serial->data)[i] + 1;
+            expected_sum += value;
+            expected_count += value % divisor == 0;
+        }
+
+        // Element-wise passes against a serial loop
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_for_each(opaque, increment_int64, NULL));
+        int64_t sum = -1;
+        int64_t zero = 0;
+        size_t count = 0;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_reduce(opaque, &zero, sum_int64, NULL, &sum));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_count_if(opaque, is_multiple, &divisor, &count));
+        TEST_ASSERT_EQUAL_INT64(expected_sum, sum);
+        TEST_ASSERT_EQUAL(expected_count, count);
+
+        size_t index = 0;
+        ccol_status_t status = ccol_vector_find_first(opaque, is_multiple, &divisor, &index);
+        if (expected_count == 0) {
+            TEST_ASSERT_EQUAL(CCOL_STATUS_NOT_FOUND, status);
+        } else {
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, status);
+            for (size_t i = 0; i < index; i++) TEST_ASSERT_FALSE(is_multiple((int64_t *)opaque->data + i, &divisor));
+            TEST_ASSERT_TRUE(is_multiple((int64_t *)opaque->data + index, &divisor));
+        }
+
+        ccol_vector_t *wide = NULL;
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_create(&wide, 0, sizeof(int64_t), (ccol_copy_t){0},
+            (ccol_free_t){0}, (ccol_print_t){0}, (ccol_comparator_t){0}));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_transform(narrow, wide, widen_and_negate, NULL));
+        TEST_ASSERT_EQUAL(sizes[s], ccol_vector_size(wide));
+        for (size_t i = 0; i < sizes[s]; i++) {
+            TEST_ASSERT_EQUAL_INT64(-(int64_t)((int32_t *)narrow->data)[i], ((int64_t *)wide->data)[i]);
+        }
+
+        // Parallel sorts must agree with the serial sort, radix and comparison paths alike
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_for_each(serial, increment_int64, NULL));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_sort(serial));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_parallel_sort(opaque));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_parallel_sort(narrow));
+        if (sizes[s] > 0) TEST_ASSERT_EQUAL_MEMORY(serial->data, opaque->data, sizes[s] * sizeof(int64_t));
+        for (size_t i = 1; i < sizes[s]; i++) {
+            TEST_ASSERT_TRUE(((int32_t *)narrow->data)[i - 1] <= ((int32_t *)narrow->data)[i]);
+        }
+
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_free(&narrow));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_free(&opaque));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_free(&serial));
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_free(&wide));
+    }
+}
+
+void test_ccol_vector_sorted_search(void) {
+    ccol_vector_t *narrow = create_int32_vector(0);
+    ccol_vector_t *opaque = NULL;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_create(&opaque, 0, sizeof(int64_t), (ccol_copy_t){0},
+        (ccol_free_t){0}, (ccol_print_t){0}, ccol_comparator_create(cmp_int64_opaque, NULL)));
+
+    ccol_vector_eytzinger_t index = {0};
+    TEST_ASSERT_EQUAL(CCOL_STATUS_COMPARATOR_FUNC, ccol_vector_eytzinger_init(&index, opaque));
+
+    // Grow one element at a time so every tree shape, full or not, gets checked
+    for (int32_t size = 0; size <= 300; size++) {
+        if (size > 0) {
+            int32_t value = (size / 3) * 2 - 100;
+            int64_t wide = value;
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_append(narrow, &value));
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_append(opaque, &wide));
+        }
+
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_eytzinger_init(&index, narrow));
+
+        for (int32_t probe = -103; probe <= 102; probe++) {
+            int64_t wide_probe = probe;
+            size_t lower = 0, upper = 0;
+            for (int32_t i = 0; i < size; i++) lower += ((int32_t *)narrow->data)[i] < probe;
+            for (int32_t i = 0; i < size; i++) upper += ((int32_t *)narrow->data)[i] <= probe;
+
+            size_t begin = SIZE_MAX, end = SIZE_MAX, found = SIZE_MAX;
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_equal_range(narrow, &probe, &begin, &end));
+            TEST_ASSERT_EQUAL(lower, begin);
+            TEST_ASSERT_EQUAL(upper, end);
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_equal_range(opaque, &wide_probe, &begin, &end));
+            TEST_ASSERT_EQUAL(lower, begin);
+            TEST_ASSERT_EQUAL(upper, end);
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_eytzinger_lower_bound(&index, &probe, &begin));
+            TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_eytzinger_upper_bound(&index, &probe, &end));
+            TEST_ASSERT_EQUAL(lower, begin);
+            TEST_ASSERT_EQUAL(upper, end);
+
+            ccol_status_t status = ccol_vector_binary_search(opaque, &wide_probe, &found);
+            TEST_ASSERT_EQUAL(lower < upper ? CCOL_STATUS_OK : CCOL_STATUS_NOT_FOUND, status);
+            if (status == CCOL_STATUS_OK) TEST_ASSERT_EQUAL(lower, found);
+        }
+
+        TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_eytzinger_destroy(&index));
+    }
+
+    int32_t smaller = -1000;
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_append(narrow, &smaller));
+    TEST_ASSERT_EQUAL(CCOL_STATUS_INVALID_ARG, ccol_vector_eytzinger_init(&index, narrow));
+
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_free(&narrow));
+    TEST_ASSERT_EQUAL(CCOL_STATUS_OK, ccol_vector_free(&opaque));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_ccol_vector_growth);
+    RUN_TEST(test_ccol_vector_large_buffers);
+    RUN_TEST(test_ccol_vector_search);
+    RUN_TEST(test_ccol_vector_sort);
+    RUN_TEST(test_ccol_vector_parallel);
+    RUN_TEST(test_ccol_vector_sorted_search);
+
+    return UNITY_END();
+}